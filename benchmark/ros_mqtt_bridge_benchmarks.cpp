@@ -0,0 +1,986 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * include cpp header files
+ * @see atomic
+ * @see new
+*/
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * include google benchmark header file
+ * @see benchmark::State
+*/
+#include <benchmark/benchmark.h>
+
+/**
+ * include ros_mqtt_message_converter's header file
+ * @see ros_message_converter
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_message_converter.hpp"
+
+/**
+ * include ros_mqtt_transport's header file
+ * @see ros_mqtt_transport::LoopbackTransport
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_transport.hpp"
+
+/**
+ * @brief global allocation counters, every operator new of this executable goes through them
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details replacements are kept out of line, so the compiler does not pair inlined malloc & free with new-expressions
+*/
+static std::atomic<uint64_t> allocation_count(0);
+
+__attribute__((noinline)) void * operator new(std::size_t allocation_size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void * allocation = std::malloc(allocation_size == 0 ? 1 : allocation_size);
+    if(allocation == nullptr) {
+        throw std::bad_alloc();
+    }
+    return allocation;
+}
+
+__attribute__((noinline)) void * operator new[](std::size_t allocation_size) {
+    return ::operator new(allocation_size);
+}
+
+__attribute__((noinline)) void operator delete(void * allocation) noexcept {
+    std::free(allocation);
+}
+
+__attribute__((noinline)) void operator delete[](void * allocation) noexcept {
+    std::free(allocation);
+}
+
+__attribute__((noinline)) void operator delete(void * allocation, std::size_t) noexcept {
+    std::free(allocation);
+}
+
+__attribute__((noinline)) void operator delete[](void * allocation, std::size_t) noexcept {
+    std::free(allocation);
+}
+
+/**
+ * @brief namespace for declare converter benchmark inputs & reporting helpers
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details every iteration converts one message, so time per iteration is ns/message.
+ * bytes_per_msg & allocs_per_msg counters are averaged over iterations.
+*/
+namespace ros_mqtt_benchmarks {
+    const int64_t scan_beams[] = {360, 1440, 10000};
+    const int64_t tf_transforms[] = {1, 50, 500};
+    const int64_t path_poses[] = {10, 1000, 10000};
+    const int64_t map_sides[] = {100, 500, 1000, 2000, 4000};
+
+    /**
+     * @brief Class for count allocations & payload bytes of benchmark loop & report them per message
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class MessageCounter {
+        private :
+            benchmark::State& benchmark_state_;
+            uint64_t allocation_start_;
+            uint64_t payload_bytes_;
+        public :
+            MessageCounter(benchmark::State& benchmark_state);
+            virtual ~MessageCounter();
+            void add_bytes(std::size_t payload_size);
+    };
+
+    /**
+     * @brief Class for receive loopback deliveries, optionally decodes & converts them like ingress of /cmd_vel
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class LoopbackReceiver : public ros_mqtt_transport::TransportCallback {
+        private :
+            const bool is_converting_;
+            ros_message_encoder::JsonDecoder json_decoder_;
+            ros_message_converter::ros_geometry_msgs::GeometryMessageConverter geometry_converter_;
+        public :
+            std::atomic<uint64_t> received_count;
+            explicit LoopbackReceiver(bool is_converting);
+            virtual ~LoopbackReceiver();
+            void connection_lost(const std::string& connection_lost_cause) override;
+            void message_arrived(const std::string& mqtt_topic, const std::string& mqtt_payload) override;
+            void delivery_complete(int message_id) override;
+    };
+
+    ros_message_encoder::Encoding encoding_of(int64_t encoding_argument);
+    std_msgs::msg::Header make_header(const char * frame_id);
+    std_msgs::msg::String make_chatter();
+    geometry_msgs::msg::Pose make_pose(std::size_t index);
+    geometry_msgs::msg::Twist make_twist();
+    sensor_msgs::msg::LaserScan make_scan(std::size_t beam_count);
+    tf2_msgs::msg::TFMessage make_tf(std::size_t transform_count);
+    nav_msgs::msg::Odometry make_odom();
+    nav_msgs::msg::Path make_path(std::size_t pose_count);
+    nav_msgs::msg::Path make_plan(std::size_t pose_count);
+    nav_msgs::srv::GetMap_Response make_map_response(std::size_t map_side);
+    std::string make_pose_with_covariance_stamped_json();
+    void apply_sizes(benchmark::internal::Benchmark * converter_benchmark, const int64_t * sizes, std::size_t size_count, bool is_encoded);
+    void apply_scan_sizes(benchmark::internal::Benchmark * converter_benchmark);
+    void apply_tf_sizes(benchmark::internal::Benchmark * converter_benchmark);
+    void apply_path_sizes(benchmark::internal::Benchmark * converter_benchmark);
+    void apply_map_sizes(benchmark::internal::Benchmark * converter_benchmark);
+    void apply_encodings(benchmark::internal::Benchmark * converter_benchmark);
+}
+
+/**
+ * @brief Constructor for start counting allocations of benchmark loop
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param benchmark_state benchmark::State&
+*/
+ros_mqtt_benchmarks::MessageCounter::MessageCounter(benchmark::State& benchmark_state)
+: benchmark_state_(benchmark_state),
+allocation_start_(allocation_count.load(std::memory_order_relaxed)),
+payload_bytes_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for report messages, bytes & allocations of benchmark loop
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_benchmarks::MessageCounter::~MessageCounter() {
+    const uint64_t allocations = allocation_count.load(std::memory_order_relaxed) - allocation_start_;
+    benchmark_state_.SetItemsProcessed(benchmark_state_.iterations());
+    benchmark_state_.SetBytesProcessed(static_cast<int64_t>(payload_bytes_));
+    benchmark_state_.counters["bytes_per_msg"] = benchmark::Counter(static_cast<double>(payload_bytes_), benchmark::Counter::kAvgIterations);
+    benchmark_state_.counters["allocs_per_msg"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * @brief Function for add bytes of payload which was produced or consumed by one message
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param payload_size std::size_t
+ * @return void
+*/
+void ros_mqtt_benchmarks::MessageCounter::add_bytes(std::size_t payload_size) {
+    payload_bytes_ += payload_size;
+}
+
+/**
+ * @brief Function for map benchmark argument into encoding, 0 JSON, 1 MessagePack, 2 CBOR
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param encoding_argument int64_t
+ * @return ros_message_encoder::Encoding
+*/
+ros_message_encoder::Encoding ros_mqtt_benchmarks::encoding_of(int64_t encoding_argument) {
+    return static_cast<ros_message_encoder::Encoding>(encoding_argument);
+}
+
+/**
+ * @brief Function for make header stamped with fixed time
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param frame_id const char *
+ * @return std_msgs::msg::Header
+*/
+std_msgs::msg::Header ros_mqtt_benchmarks::make_header(const char * frame_id) {
+    std_msgs::msg::Header header_message;
+    header_message.frame_id = frame_id;
+    header_message.stamp.sec = 1697700000;
+    header_message.stamp.nanosec = 123456789;
+    return header_message;
+}
+
+/**
+ * @brief Function for make chatter with text which needs escaping
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std_msgs::msg::String
+*/
+std_msgs::msg::String ros_mqtt_benchmarks::make_chatter() {
+    std_msgs::msg::String chatter_message;
+    chatter_message.data = "hello \"rcs\" from ros_mqtt_bridge\n";
+    return chatter_message;
+}
+
+/**
+ * @brief Function for make pose with non trivial doubles, so formatting cost is realistic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param index std::size_t
+ * @return geometry_msgs::msg::Pose
+*/
+geometry_msgs::msg::Pose ros_mqtt_benchmarks::make_pose(std::size_t index) {
+    geometry_msgs::msg::Pose pose_message;
+    pose_message.position.x = 1.0 + index * 0.0137;
+    pose_message.position.y = -2.5 + index * 0.0071;
+    pose_message.position.z = 0.0;
+    pose_message.orientation.x = 0.0;
+    pose_message.orientation.y = 0.0;
+    pose_message.orientation.z = std::sin(index * 0.001);
+    pose_message.orientation.w = std::cos(index * 0.001);
+    return pose_message;
+}
+
+/**
+ * @brief Function for make twist
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return geometry_msgs::msg::Twist
+*/
+geometry_msgs::msg::Twist ros_mqtt_benchmarks::make_twist() {
+    geometry_msgs::msg::Twist twist_message;
+    twist_message.linear.x = 0.35;
+    twist_message.linear.y = 0.0;
+    twist_message.linear.z = 0.0;
+    twist_message.angular.x = 0.0;
+    twist_message.angular.y = 0.0;
+    twist_message.angular.z = -0.785398;
+    return twist_message;
+}
+
+/**
+ * @brief Function for make laser scan with ranges & intensities of beam_count
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param beam_count std::size_t
+ * @return sensor_msgs::msg::LaserScan
+*/
+sensor_msgs::msg::LaserScan ros_mqtt_benchmarks::make_scan(std::size_t beam_count) {
+    sensor_msgs::msg::LaserScan scan_message;
+    scan_message.header = make_header("base_scan");
+    scan_message.angle_min = -3.14159f;
+    scan_message.angle_max = 3.14159f;
+    scan_message.angle_increment = 6.28318f / beam_count;
+    scan_message.time_increment = 0.0001f;
+    scan_message.scan_time = 0.1f;
+    scan_message.range_min = 0.12f;
+    scan_message.range_max = 30.0f;
+    scan_message.ranges.resize(beam_count);
+    scan_message.intensities.resize(beam_count);
+    for(std::size_t i = 0; i < beam_count; i++) {
+        scan_message.ranges[i] = 0.5f + (i % 997) * 0.0293f;
+        scan_message.intensities[i] = static_cast<float>(i % 255);
+    }
+    return scan_message;
+}
+
+/**
+ * @brief Function for make tf message with transform_count transforms
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param transform_count std::size_t
+ * @return tf2_msgs::msg::TFMessage
+*/
+tf2_msgs::msg::TFMessage ros_mqtt_benchmarks::make_tf(std::size_t transform_count) {
+    tf2_msgs::msg::TFMessage tf_message;
+    tf_message.transforms.resize(transform_count);
+    for(std::size_t i = 0; i < transform_count; i++) {
+        geometry_msgs::msg::TransformStamped& transform_stamped = tf_message.transforms[i];
+        const geometry_msgs::msg::Pose transform_pose = make_pose(i);
+        transform_stamped.header = make_header("odom");
+        transform_stamped.child_frame_id = "link_" + std::to_string(i);
+        transform_stamped.transform.translation.x = transform_pose.position.x;
+        transform_stamped.transform.translation.y = transform_pose.position.y;
+        transform_stamped.transform.translation.z = transform_pose.position.z;
+        transform_stamped.transform.rotation = transform_pose.orientation;
+    }
+    return tf_message;
+}
+
+/**
+ * @brief Function for make odometry with filled covariances
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return nav_msgs::msg::Odometry
+*/
+nav_msgs::msg::Odometry ros_mqtt_benchmarks::make_odom() {
+    nav_msgs::msg::Odometry odom_message;
+    odom_message.header = make_header("odom");
+    odom_message.child_frame_id = "base_footprint";
+    odom_message.pose.pose = make_pose(42);
+    odom_message.twist.twist = make_twist();
+    for(std::size_t i = 0; i < odom_message.pose.covariance.size(); i++) {
+        odom_message.pose.covariance[i] = (i % 7 == 0) ? 0.001 * (i + 1) : 0.0;
+        odom_message.twist.covariance[i] = (i % 7 == 0) ? 0.002 * (i + 1) : 0.0;
+    }
+    return odom_message;
+}
+
+/**
+ * @brief Function for make path with pose_count stamped poses
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param pose_count std::size_t
+ * @return nav_msgs::msg::Path
+*/
+nav_msgs::msg::Path ros_mqtt_benchmarks::make_path(std::size_t pose_count) {
+    nav_msgs::msg::Path path_message;
+    path_message.header = make_header("map");
+    path_message.poses.resize(pose_count);
+    for(std::size_t i = 0; i < pose_count; i++) {
+        path_message.poses[i].header = path_message.header;
+        path_message.poses[i].pose = make_pose(i);
+    }
+    return path_message;
+}
+
+/**
+ * @brief Function for make curved plan with pose_count poses 5cm apart, like a planner output
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param pose_count std::size_t
+ * @return nav_msgs::msg::Path
+*/
+nav_msgs::msg::Path ros_mqtt_benchmarks::make_plan(std::size_t pose_count) {
+    nav_msgs::msg::Path plan_message;
+    plan_message.header = make_header("map");
+    plan_message.poses.resize(pose_count);
+    for(std::size_t i = 0; i < pose_count; i++) {
+        const double travelled = i * 0.05;
+        const double yaw = std::atan2(0.5 * std::cos(travelled * 0.25), 1.0);
+        plan_message.poses[i].header = plan_message.header;
+        plan_message.poses[i].pose.position.x = travelled;
+        plan_message.poses[i].pose.position.y = 2.0 * std::sin(travelled * 0.25);
+        plan_message.poses[i].pose.orientation.z = std::sin(yaw * 0.5);
+        plan_message.poses[i].pose.orientation.w = std::cos(yaw * 0.5);
+    }
+    return plan_message;
+}
+
+/**
+ * @brief Function for make map response of map_side x map_side cells with free, occupied & unknown runs
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param map_side std::size_t
+ * @return nav_msgs::srv::GetMap_Response
+*/
+nav_msgs::srv::GetMap_Response ros_mqtt_benchmarks::make_map_response(std::size_t map_side) {
+    nav_msgs::srv::GetMap_Response map_response;
+    map_response.map.header = make_header("map");
+    map_response.map.info.map_load_time = map_response.map.header.stamp;
+    map_response.map.info.resolution = 0.05f;
+    map_response.map.info.width = static_cast<uint32_t>(map_side);
+    map_response.map.info.height = static_cast<uint32_t>(map_side);
+    map_response.map.info.origin = make_pose(0);
+    map_response.map.data.resize(map_side * map_side);
+    for(std::size_t i = 0; i < map_response.map.data.size(); i++) {
+        const std::size_t cell_run = (i / 37) % 5;
+        map_response.map.data[i] = cell_run == 0 ? -1 : (cell_run == 1 ? 100 : 0);
+    }
+    return map_response;
+}
+
+/**
+ * @brief Function for make /initialpose JSON payload as RCS sends it
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::string
+*/
+std::string ros_mqtt_benchmarks::make_pose_with_covariance_stamped_json() {
+    std::string covariance_json;
+    for(std::size_t i = 0; i < 36; i++) {
+        covariance_json += (i == 0 ? "" : ",") + std::string(i % 7 == 0 ? "0.25" : "0.0");
+    }
+    return "{\"header\":{\"frame_id\":\"map\",\"sec\":1697700000,\"nanosec\":123456789},"
+        "\"pose\":{\"pose\":{\"position\":{\"x\":1.25,\"y\":-3.5,\"z\":0.0},"
+        "\"orientation\":{\"x\":0.0,\"y\":0.0,\"z\":0.38268343236,\"w\":0.92387953251}},"
+        "\"covariance\":[" + covariance_json + "]}}";
+}
+
+/**
+ * @brief Function for register message sizes, with every encoding when converter writes into encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param converter_benchmark benchmark::internal::Benchmark *
+ * @param sizes const int64_t *
+ * @param size_count std::size_t
+ * @param is_encoded bool
+ * @return void
+*/
+void ros_mqtt_benchmarks::apply_sizes(benchmark::internal::Benchmark * converter_benchmark, const int64_t * sizes, std::size_t size_count, bool is_encoded) {
+    for(std::size_t i = 0; i < size_count; i++) {
+        if(!is_encoded) {
+            converter_benchmark->Args({sizes[i]});
+            continue;
+        }
+        for(int64_t encoding_argument = 0; encoding_argument <= 2; encoding_argument++) {
+            converter_benchmark->Args({sizes[i], encoding_argument});
+        }
+    }
+}
+
+/**
+ * @brief Function for register beams sizes of scan with every encoding
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param converter_benchmark benchmark::internal::Benchmark *
+ * @return void
+*/
+void ros_mqtt_benchmarks::apply_scan_sizes(benchmark::internal::Benchmark * converter_benchmark) {
+    converter_benchmark->ArgNames({"beams", "encoding"});
+    apply_sizes(converter_benchmark, scan_beams, sizeof(scan_beams) / sizeof(scan_beams[0]), true);
+}
+
+/**
+ * @brief Function for register transforms sizes of tf with every encoding
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param converter_benchmark benchmark::internal::Benchmark *
+ * @return void
+*/
+void ros_mqtt_benchmarks::apply_tf_sizes(benchmark::internal::Benchmark * converter_benchmark) {
+    converter_benchmark->ArgNames({"transforms", "encoding"});
+    apply_sizes(converter_benchmark, tf_transforms, sizeof(tf_transforms) / sizeof(tf_transforms[0]), true);
+}
+
+/**
+ * @brief Function for register poses sizes of path with every encoding
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param converter_benchmark benchmark::internal::Benchmark *
+ * @return void
+*/
+void ros_mqtt_benchmarks::apply_path_sizes(benchmark::internal::Benchmark * converter_benchmark) {
+    converter_benchmark->ArgNames({"poses", "encoding"});
+    apply_sizes(converter_benchmark, path_poses, sizeof(path_poses) / sizeof(path_poses[0]), true);
+}
+
+/**
+ * @brief Function for register side lengths of map with every encoding
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param converter_benchmark benchmark::internal::Benchmark *
+ * @return void
+*/
+void ros_mqtt_benchmarks::apply_map_sizes(benchmark::internal::Benchmark * converter_benchmark) {
+    converter_benchmark->ArgNames({"side", "encoding"});
+    converter_benchmark->Unit(benchmark::kMillisecond);
+    apply_sizes(converter_benchmark, map_sides, sizeof(map_sides) / sizeof(map_sides[0]), true);
+}
+
+/**
+ * @brief Function for register every encoding for fixed size message
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param converter_benchmark benchmark::internal::Benchmark *
+ * @return void
+*/
+void ros_mqtt_benchmarks::apply_encodings(benchmark::internal::Benchmark * converter_benchmark) {
+    converter_benchmark->ArgNames({"encoding"});
+    for(int64_t encoding_argument = 0; encoding_argument <= 2; encoding_argument++) {
+        converter_benchmark->Args({encoding_argument});
+    }
+}
+
+/**
+ * @brief macro for benchmark of egress converter which writes message into encoder of benchmark's encoding argument
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details encoder is reused across iterations like the bridge does, release() hands payload out as the bridge does before publish
+ * & payload is given back into payload pool as the bridge does after publish, so allocs_per_msg is the steady state of egress
+*/
+#define BENCHMARK_ENCODED_CONVERTER(benchmark_name, converter_type, encoding_index, make_message, convert_call) \
+    void benchmark_name(benchmark::State& benchmark_state) { \
+        converter_type message_converter; \
+        const auto converter_message = make_message; \
+        ros_message_encoder::MessageEncoder * message_encoder = ros_message_encoder::create_encoder(ros_mqtt_benchmarks::encoding_of(benchmark_state.range(encoding_index))); \
+        { \
+            ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state); \
+            for(auto _ : benchmark_state) { \
+                message_converter.convert_call(converter_message, *message_encoder); \
+                std::string converted_payload = message_encoder->release(); \
+                message_counter.add_bytes(converted_payload.size()); \
+                benchmark::DoNotOptimize(converted_payload.data()); \
+                ros_mqtt_buffer_pool::BufferPool::instance().recycle(converted_payload); \
+            } \
+        } \
+        delete message_encoder; \
+    }
+
+/**
+ * @brief macro for benchmark of legacy *_to_json converter which returns JSON string from shared pointer
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+#define BENCHMARK_JSON_CONVERTER(benchmark_name, converter_type, message_type, make_message, convert_call) \
+    void benchmark_name(benchmark::State& benchmark_state) { \
+        converter_type message_converter; \
+        const message_type::SharedPtr converter_message_ptr = std::make_shared<message_type>(make_message); \
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state); \
+        for(auto _ : benchmark_state) { \
+            std::string converted_payload = message_converter.convert_call(converter_message_ptr); \
+            message_counter.add_bytes(converted_payload.size()); \
+            benchmark::DoNotOptimize(converted_payload.data()); \
+        } \
+    }
+
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_header, ros_message_converter::ros_std_msgs::StdMessageConverter, 0, ros_mqtt_benchmarks::make_header("map"), convert_header)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_chatter, ros_message_converter::ros_std_msgs::StdMessageConverter, 0, ros_mqtt_benchmarks::make_chatter(), convert_chatter)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_point, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, 0, ros_mqtt_benchmarks::make_pose(7).position, convert_point)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_quaternion, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, 0, ros_mqtt_benchmarks::make_pose(7).orientation, convert_quaternion)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_pose, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, 0, ros_mqtt_benchmarks::make_pose(7), convert_pose)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_vector, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, 0, ros_mqtt_benchmarks::make_twist().linear, convert_vector)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_twist, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, 0, ros_mqtt_benchmarks::make_twist(), convert_twist)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_scan, ros_message_converter::ros_sensor_msgs::SensorMessageConverter, 1, ros_mqtt_benchmarks::make_scan(benchmark_state.range(0)), convert_scan)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_odom, ros_message_converter::ros_nav_msgs::NavMessageConverter, 0, ros_mqtt_benchmarks::make_odom(), convert_odom)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_path, ros_message_converter::ros_nav_msgs::NavMessageConverter, 1, ros_mqtt_benchmarks::make_path(benchmark_state.range(0)), convert_path)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_meta_data, ros_message_converter::ros_nav_msgs::NavMessageConverter, 0, ros_mqtt_benchmarks::make_map_response(1).map.info, convert_meta_data)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_map_response, ros_message_converter::ros_nav_msgs::NavMessageConverter, 1, ros_mqtt_benchmarks::make_map_response(benchmark_state.range(0)), convert_map_response)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_tf, ros_message_converter::ros_tf2_msgs::Tf2MessageConverter, 1, ros_mqtt_benchmarks::make_tf(benchmark_state.range(0)), convert_tf)
+BENCHMARK_ENCODED_CONVERTER(benchmark_convert_transforms, ros_message_converter::ros_tf2_msgs::Tf2MessageConverter, 0, ros_mqtt_benchmarks::make_tf(2), convert_transforms)
+
+BENCHMARK_JSON_CONVERTER(benchmark_convert_chatter_to_json, ros_message_converter::ros_std_msgs::StdMessageConverter, std_msgs::msg::String, ros_mqtt_benchmarks::make_chatter(), convert_chatter_to_json)
+BENCHMARK_JSON_CONVERTER(benchmark_convert_pose_to_json, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, geometry_msgs::msg::Pose, ros_mqtt_benchmarks::make_pose(7), convert_pose_to_json)
+BENCHMARK_JSON_CONVERTER(benchmark_convert_twist_to_json, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, geometry_msgs::msg::Twist, ros_mqtt_benchmarks::make_twist(), convert_twist_to_json)
+BENCHMARK_JSON_CONVERTER(benchmark_convert_scan_to_json, ros_message_converter::ros_sensor_msgs::SensorMessageConverter, sensor_msgs::msg::LaserScan, ros_mqtt_benchmarks::make_scan(benchmark_state.range(0)), convert_scan_to_json)
+BENCHMARK_JSON_CONVERTER(benchmark_convert_odom_to_json, ros_message_converter::ros_nav_msgs::NavMessageConverter, nav_msgs::msg::Odometry, ros_mqtt_benchmarks::make_odom(), convert_odom_to_json)
+BENCHMARK_JSON_CONVERTER(benchmark_convert_path_to_json, ros_message_converter::ros_nav_msgs::NavMessageConverter, nav_msgs::msg::Path, ros_mqtt_benchmarks::make_path(benchmark_state.range(0)), convert_path_to_json)
+BENCHMARK_JSON_CONVERTER(benchmark_convert_map_response_to_json, ros_message_converter::ros_nav_msgs::NavMessageConverter, nav_msgs::srv::GetMap_Response, ros_mqtt_benchmarks::make_map_response(benchmark_state.range(0)), convert_map_response_to_json)
+BENCHMARK_JSON_CONVERTER(benchmark_convert_tf_to_json, ros_message_converter::ros_tf2_msgs::Tf2MessageConverter, tf2_msgs::msg::TFMessage, ros_mqtt_benchmarks::make_tf(benchmark_state.range(0)), convert_tf_to_json)
+
+/**
+ * @brief macro for benchmark of ingress converter which parses payload string with the event-driven reader
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details payload is copied per iteration since string overloads take it by non-const reference, the copy is outside the counters
+*/
+#define BENCHMARK_STRING_INGRESS_CONVERTER(benchmark_name, converter_type, raw_payload, convert_call) \
+    void benchmark_name(benchmark::State& benchmark_state) { \
+        converter_type message_converter; \
+        const std::string ingress_payload = raw_payload; \
+        std::string converter_payload = ingress_payload; \
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state); \
+        for(auto _ : benchmark_state) { \
+            auto converted_message = message_converter.convert_call(converter_payload); \
+            message_counter.add_bytes(ingress_payload.size()); \
+            benchmark::DoNotOptimize(&converted_message); \
+        } \
+        if(message_converter.is_parse_failed()) { \
+            benchmark_state.SkipWithError("ingress payload failed to parse"); \
+        } \
+    }
+
+/**
+ * @brief macro for benchmark of ingress converter which reads decoded Json::Value, decoding is measured by benchmark_decode
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+#define BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_name, converter_type, raw_payload, json_member, convert_call) \
+    void benchmark_name(benchmark::State& benchmark_state) { \
+        converter_type message_converter; \
+        const std::string ingress_payload = raw_payload; \
+        Json::Value ingress_json; \
+        ros_message_encoder::JsonDecoder ingress_decoder; \
+        ingress_decoder.decode(ingress_payload, ingress_json); \
+        const Json::Value converter_json = ingress_json json_member; \
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state); \
+        for(auto _ : benchmark_state) { \
+            auto converted_message = message_converter.convert_call(converter_json); \
+            message_counter.add_bytes(ingress_payload.size()); \
+            benchmark::DoNotOptimize(&converted_message); \
+        } \
+    }
+
+BENCHMARK_STRING_INGRESS_CONVERTER(benchmark_convert_json_to_chatter, ros_message_converter::ros_std_msgs::StdMessageConverter, "{\"data\":\"hello from rcs\"}", convert_json_to_chatter)
+BENCHMARK_STRING_INGRESS_CONVERTER(benchmark_convert_json_to_twist, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, "{\"linear\":{\"x\":0.35,\"y\":0.0,\"z\":0.0},\"angular\":{\"x\":0.0,\"y\":0.0,\"z\":-0.785398}}", convert_json_to_twist)
+BENCHMARK_STRING_INGRESS_CONVERTER(benchmark_convert_json_to_pose_with_covariance_stamped, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, ros_mqtt_benchmarks::make_pose_with_covariance_stamped_json(), convert_json_to_pose_with_covariance_stamped)
+
+BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_convert_json_value_to_chatter, ros_message_converter::ros_std_msgs::StdMessageConverter, "{\"data\":\"hello from rcs\"}", , convert_json_to_chatter)
+BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_convert_json_value_to_twist, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, "{\"linear\":{\"x\":0.35,\"y\":0.0,\"z\":0.0},\"angular\":{\"x\":0.0,\"y\":0.0,\"z\":-0.785398}}", , convert_json_to_twist)
+BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_convert_json_value_to_pose_with_covariance_stamped, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, ros_mqtt_benchmarks::make_pose_with_covariance_stamped_json(), , convert_json_to_pose_with_covariance_stamped)
+BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_convert_json_to_header, ros_message_converter::ros_std_msgs::StdMessageConverter, ros_mqtt_benchmarks::make_pose_with_covariance_stamped_json(), ["header"], convert_json_to_header)
+BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_convert_json_to_vector, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, "{\"linear\":{\"x\":0.35,\"y\":0.0,\"z\":0.0}}", ["linear"], convert_json_to_vector)
+BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_convert_json_to_point, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, ros_mqtt_benchmarks::make_pose_with_covariance_stamped_json(), ["pose"]["pose"]["position"], convert_json_to_point)
+BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_convert_json_to_quaternion, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, ros_mqtt_benchmarks::make_pose_with_covariance_stamped_json(), ["pose"]["pose"]["orientation"], convert_json_to_quaternion)
+BENCHMARK_VALUE_INGRESS_CONVERTER(benchmark_convert_json_to_pose_covariance, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter, ros_mqtt_benchmarks::make_pose_with_covariance_stamped_json(), ["pose"], convert_json_to_pose_covariance)
+
+/**
+ * @brief Function for benchmark decoding of /initialpose payload in benchmark's encoding, the step before Json::Value converters
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param benchmark_state benchmark::State&
+ * @return void
+*/
+void benchmark_decode_pose_with_covariance_stamped(benchmark::State& benchmark_state) {
+    const ros_message_encoder::Encoding ingress_encoding = ros_mqtt_benchmarks::encoding_of(benchmark_state.range(0));
+    Json::Value pose_json;
+    ros_message_encoder::JsonDecoder json_decoder;
+    json_decoder.decode(ros_mqtt_benchmarks::make_pose_with_covariance_stamped_json(), pose_json);
+
+    ros_message_converter::ros_geometry_msgs::GeometryMessageConverter geometry_converter;
+    ros_message_encoder::MessageEncoder * pose_encoder = ros_message_encoder::create_encoder(ingress_encoding);
+    geometry_msgs::msg::PoseWithCovarianceStamped pose_message = geometry_converter.convert_json_to_pose_with_covariance_stamped(pose_json);
+    pose_encoder->begin_object(2);
+    pose_encoder->write_key("header");
+    ros_message_converter::ros_std_msgs::StdMessageConverter std_converter;
+    std_converter.convert_header(pose_message.header, *pose_encoder);
+    pose_encoder->write_key("pose");
+    pose_encoder->begin_object(2);
+    pose_encoder->write_key("pose");
+    geometry_converter.convert_pose(pose_message.pose.pose, *pose_encoder);
+    pose_encoder->write_key("covariance");
+    pose_encoder->write_double_array(pose_message.pose.covariance.data(), pose_message.pose.covariance.size());
+    pose_encoder->end_object();
+    pose_encoder->end_object();
+    const std::string ingress_payload = pose_encoder->release();
+    delete pose_encoder;
+
+    ros_message_encoder::MessageDecoder * pose_decoder = ros_message_encoder::create_decoder(ingress_encoding);
+    {
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state);
+        for(auto _ : benchmark_state) {
+            Json::Value decoded_json;
+            pose_decoder->decode(ingress_payload, decoded_json);
+            message_counter.add_bytes(ingress_payload.size());
+            benchmark::DoNotOptimize(&decoded_json);
+        }
+    }
+    delete pose_decoder;
+}
+
+/**
+ * @brief Function for benchmark number formatting of one scan's ranges or one odom's covariances against the "%.17g" formatting used before
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param benchmark_state benchmark::State& range(0) 0 "%.17g", 1 shortest round trip, 2 fixed 3 decimals, range(1) 0 1440 float ranges, 1 2 x 36 double covariances
+ * @return void
+ * @see ros_number_format
+*/
+void benchmark_format_numbers(benchmark::State& benchmark_state) {
+    const int64_t number_formatter = benchmark_state.range(0);
+    const bool is_double = benchmark_state.range(1) != 0;
+    const sensor_msgs::msg::LaserScan scan_message = ros_mqtt_benchmarks::make_scan(1440);
+    nav_msgs::msg::Odometry odom_message = ros_mqtt_benchmarks::make_odom();
+    std::vector<double> covariances(odom_message.pose.covariance.begin(), odom_message.pose.covariance.end());
+    covariances.insert(covariances.end(), odom_message.twist.covariance.begin(), odom_message.twist.covariance.end());
+    const std::size_t number_count = is_double ? covariances.size() : scan_message.ranges.size();
+
+    char number_buffer[NUMBER_FORMAT_BUFFER_SIZE];
+    {
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state);
+        for(auto _ : benchmark_state) {
+            std::size_t formatted_size = 0;
+            for(std::size_t i = 0; i < number_count; i++) {
+                const double number_value = is_double ? covariances[i] : static_cast<double>(scan_message.ranges[i]);
+                if(number_formatter == 0) {
+                    formatted_size += static_cast<std::size_t>(std::snprintf(number_buffer, sizeof(number_buffer), "%.17g", number_value));
+                } else if(number_formatter == 2) {
+                    formatted_size += ros_number_format::format_fixed(number_value, 3, number_buffer);
+                } else if(is_double) {
+                    formatted_size += ros_number_format::format_double(number_value, number_buffer);
+                } else {
+                    formatted_size += ros_number_format::format_float(scan_message.ranges[i], number_buffer);
+                }
+                benchmark::DoNotOptimize(number_buffer);
+            }
+            message_counter.add_bytes(formatted_size);
+        }
+    }
+}
+
+/**
+ * @brief Function for benchmark JSON odom egress with per-topic output options
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param benchmark_state benchmark::State& range(0) 0 default output options, 1 3 decimals, 2 3 decimals & zero covariances omitted of odom without covariances
+ * @return void
+ * @see ros_message_encoder::OutputOptions
+*/
+void benchmark_convert_odom_output_options(benchmark::State& benchmark_state) {
+    const int64_t output_option_index = benchmark_state.range(0);
+    nav_msgs::msg::Odometry odom_message = ros_mqtt_benchmarks::make_odom();
+    ros_message_encoder::OutputOptions output_options = ros_message_encoder::default_output_options();
+    if(output_option_index >= 1) {
+        output_options.decimals = 3;
+    }
+    if(output_option_index >= 2) {
+        output_options.is_zero_covariance_omitted = true;
+        odom_message.pose.covariance.fill(0.0);
+        odom_message.twist.covariance.fill(0.0);
+    }
+
+    ros_message_converter::ros_nav_msgs::NavMessageConverter nav_converter;
+    ros_message_encoder::JsonEncoder json_encoder;
+    json_encoder.set_output_options(output_options);
+    {
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state);
+        for(auto _ : benchmark_state) {
+            nav_converter.convert_odom(odom_message, json_encoder);
+            std::string converted_payload = json_encoder.release();
+            message_counter.add_bytes(converted_payload.size());
+            benchmark::DoNotOptimize(converted_payload.data());
+            ros_mqtt_buffer_pool::BufferPool::instance().recycle(converted_payload);
+        }
+    }
+}
+
+/**
+ * @brief Function for benchmark JSON plan egress with path simplification
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param benchmark_state benchmark::State& range(0) poses of plan, range(1) ros_mqtt_path::PathSimplification, paths are simplified within 1cm & cut to 500 poses
+ * @return void
+ * @see ros_mqtt_path::PathSimplifier
+*/
+void benchmark_convert_plan_simplification(benchmark::State& benchmark_state) {
+    const nav_msgs::msg::Path plan_message = ros_mqtt_benchmarks::make_plan(benchmark_state.range(0));
+    ros_message_encoder::OutputOptions output_options = ros_message_encoder::default_output_options();
+    output_options.path_simplification = static_cast<ros_mqtt_path::PathSimplification>(benchmark_state.range(1));
+    output_options.path_tolerance = 0.01;
+    output_options.path_max_poses = 500;
+
+    ros_message_converter::ros_nav_msgs::NavMessageConverter nav_converter;
+    ros_message_encoder::JsonEncoder json_encoder;
+    json_encoder.set_output_options(output_options);
+    {
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state);
+        for(auto _ : benchmark_state) {
+            nav_converter.convert_path(plan_message, json_encoder);
+            std::string converted_payload = json_encoder.release();
+            message_counter.add_bytes(converted_payload.size());
+            benchmark::DoNotOptimize(converted_payload.data());
+            ros_mqtt_buffer_pool::BufferPool::instance().recycle(converted_payload);
+        }
+    }
+}
+
+/**
+ * @brief Function for benchmark JSON plan egress of a robot following its plan, full paths against keyframes & deltas
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param benchmark_state benchmark::State& range(0) 0 full paths, 1 deltas with a keyframe every 20 messages
+ * @return void
+ * @details every plan drops 5 passed poses from the front of a 2000-pose plan, like the global plan while the robot drives
+ * @see ros_mqtt_path::PathDelta
+*/
+void benchmark_convert_plan_delta(benchmark::State& benchmark_state) {
+    const bool is_delta = benchmark_state.range(0) != 0;
+    const nav_msgs::msg::Path full_plan = ros_mqtt_benchmarks::make_plan(2000);
+    std::vector<nav_msgs::msg::Path> plan_messages(64);
+    for(std::size_t i = 0; i < plan_messages.size(); i++) {
+        plan_messages[i].header = full_plan.header;
+        plan_messages[i].poses.assign(full_plan.poses.begin() + i * 5, full_plan.poses.end());
+    }
+
+    ros_message_converter::ros_nav_msgs::NavMessageConverter nav_converter;
+    ros_mqtt_path::PathDelta path_delta(20, PATH_POSE_STRIDE);
+    ros_message_encoder::JsonEncoder json_encoder;
+    std::size_t plan_index = 0;
+    {
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state);
+        for(auto _ : benchmark_state) {
+            if(is_delta) {
+                nav_converter.convert_path_delta(plan_messages[plan_index], path_delta, json_encoder);
+            } else {
+                nav_converter.convert_path(plan_messages[plan_index], json_encoder);
+            }
+            plan_index = (plan_index + 1) % plan_messages.size();
+            std::string converted_payload = json_encoder.release();
+            message_counter.add_bytes(converted_payload.size());
+            benchmark::DoNotOptimize(converted_payload.data());
+            ros_mqtt_buffer_pool::BufferPool::instance().recycle(converted_payload);
+        }
+    }
+}
+
+/**
+ * @brief Function for benchmark JSON scan egress with scan reduction
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param benchmark_state benchmark::State& range(0) beams of scan, range(1) 0 full scan, 1 forward 180 degrees, 2 forward 180 degrees pooled to 180 beams & clamped to 10m
+ * @return void
+ * @see ros_mqtt_scan::ScanReducer
+*/
+void benchmark_convert_scan_reduction(benchmark::State& benchmark_state) {
+    const sensor_msgs::msg::LaserScan scan_message = ros_mqtt_benchmarks::make_scan(benchmark_state.range(0));
+    const int64_t reduction_index = benchmark_state.range(1);
+    ros_message_encoder::OutputOptions output_options = ros_message_encoder::default_output_options();
+    if(reduction_index >= 1) {
+        output_options.scan_reduction.is_cropped = true;
+        output_options.scan_reduction.crop_angle_min = -1.5707964f;
+        output_options.scan_reduction.crop_angle_max = 1.5707964f;
+    }
+    if(reduction_index >= 2) {
+        output_options.scan_reduction.beam_count = 180;
+        output_options.scan_reduction.range_clamp = 10.0f;
+    }
+
+    ros_message_converter::ros_sensor_msgs::SensorMessageConverter sensor_converter;
+    ros_message_encoder::JsonEncoder json_encoder;
+    json_encoder.set_output_options(output_options);
+    {
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state);
+        for(auto _ : benchmark_state) {
+            sensor_converter.convert_scan(scan_message, json_encoder);
+            std::string converted_payload = json_encoder.release();
+            message_counter.add_bytes(converted_payload.size());
+            benchmark::DoNotOptimize(converted_payload.data());
+            ros_mqtt_buffer_pool::BufferPool::instance().recycle(converted_payload);
+        }
+    }
+}
+
+/**
+ * @brief Constructor for initialize receiver with zero count
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param is_converting bool
+*/
+ros_mqtt_benchmarks::LoopbackReceiver::LoopbackReceiver(bool is_converting)
+: is_converting_(is_converting),
+received_count(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_benchmarks::LoopbackReceiver::~LoopbackReceiver() {
+
+}
+
+/**
+ * @brief Overrided function for ignore lost connection, loopback never loses it
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param connection_lost_cause const std::string&
+ * @return void
+*/
+void ros_mqtt_benchmarks::LoopbackReceiver::connection_lost(const std::string& connection_lost_cause) {
+    static_cast<void>(connection_lost_cause);
+}
+
+/**
+ * @brief Overrided function for count delivered message after decoding & converting it when converting
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @param mqtt_payload const std::string&
+ * @return void
+*/
+void ros_mqtt_benchmarks::LoopbackReceiver::message_arrived(const std::string& mqtt_topic, const std::string& mqtt_payload) {
+    static_cast<void>(mqtt_topic);
+    if(is_converting_) {
+        Json::Value twist_json;
+        json_decoder_.decode(mqtt_payload, twist_json);
+        geometry_msgs::msg::Twist twist_message = geometry_converter_.convert_json_to_twist(twist_json);
+        benchmark::DoNotOptimize(&twist_message);
+    }
+    received_count.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Overrided function for ignore delivered message id
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param message_id int
+ * @return void
+*/
+void ros_mqtt_benchmarks::LoopbackReceiver::delivery_complete(int message_id) {
+    static_cast<void>(message_id);
+}
+
+/**
+ * @brief Function for benchmark publish through loopback transport until delivery to its subscription, without broker & network
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param benchmark_state benchmark::State& range(0) payload bytes, range(1) 1 decodes & converts delivered /cmd_vel
+ * @return void
+ * @details the ring bounds the delivery thread's lag to its capacity, publish waits while it is full,
+ * so over many iterations time per message is the delivery throughput
+*/
+void benchmark_loopback_transport(benchmark::State& benchmark_state) {
+    const bool is_converting = benchmark_state.range(1) != 0;
+    std::string mqtt_payload = "{\"linear\":{\"x\":0.35,\"y\":0.0,\"z\":0.0},\"angular\":{\"x\":0.0,\"y\":0.0,\"z\":-0.785398}}";
+    if(!is_converting) {
+        mqtt_payload.assign(static_cast<std::size_t>(benchmark_state.range(0)), 'x');
+    }
+    const std::string mqtt_topic = "/cmd_vel";
+
+    ros_mqtt_benchmarks::LoopbackReceiver loopback_receiver(is_converting);
+    ros_mqtt_transport::LoopbackTransport loopback_transport;
+    loopback_transport.set_callback(loopback_receiver);
+    loopback_transport.subscribe(mqtt_topic, 0);
+    loopback_transport.connect(std::chrono::seconds(0), nullptr);
+    {
+        ros_mqtt_benchmarks::MessageCounter message_counter(benchmark_state);
+        for(auto _ : benchmark_state) {
+            loopback_transport.publish(mqtt_topic, mqtt_payload, 0, false);
+            message_counter.add_bytes(mqtt_payload.size());
+        }
+    }
+    while(loopback_receiver.received_count.load(std::memory_order_acquire) < loopback_transport.published_count()) {
+        std::this_thread::yield();
+    }
+    loopback_transport.disconnect();
+}
+
+BENCHMARK(benchmark_convert_header)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_chatter)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_point)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_quaternion)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_pose)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_vector)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_twist)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_scan)->Apply(ros_mqtt_benchmarks::apply_scan_sizes);
+BENCHMARK(benchmark_convert_odom)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_path)->Apply(ros_mqtt_benchmarks::apply_path_sizes);
+BENCHMARK(benchmark_convert_meta_data)->Apply(ros_mqtt_benchmarks::apply_encodings);
+BENCHMARK(benchmark_convert_map_response)->Apply(ros_mqtt_benchmarks::apply_map_sizes);
+BENCHMARK(benchmark_convert_tf)->Apply(ros_mqtt_benchmarks::apply_tf_sizes);
+BENCHMARK(benchmark_convert_transforms)->Apply(ros_mqtt_benchmarks::apply_encodings);
+
+BENCHMARK(benchmark_convert_chatter_to_json);
+BENCHMARK(benchmark_convert_pose_to_json);
+BENCHMARK(benchmark_convert_twist_to_json);
+BENCHMARK(benchmark_convert_scan_to_json)->ArgNames({"beams"})->Arg(360)->Arg(1440)->Arg(10000);
+BENCHMARK(benchmark_convert_odom_to_json);
+BENCHMARK(benchmark_convert_path_to_json)->ArgNames({"poses"})->Arg(10)->Arg(1000)->Arg(10000);
+BENCHMARK(benchmark_convert_map_response_to_json)->ArgNames({"side"})->Unit(benchmark::kMillisecond)->Arg(100)->Arg(500)->Arg(1000)->Arg(2000)->Arg(4000);
+BENCHMARK(benchmark_convert_tf_to_json)->ArgNames({"transforms"})->Arg(1)->Arg(50)->Arg(500);
+
+BENCHMARK(benchmark_convert_json_to_chatter);
+BENCHMARK(benchmark_convert_json_to_twist);
+BENCHMARK(benchmark_convert_json_to_pose_with_covariance_stamped);
+BENCHMARK(benchmark_convert_json_value_to_chatter);
+BENCHMARK(benchmark_convert_json_value_to_twist);
+BENCHMARK(benchmark_convert_json_value_to_pose_with_covariance_stamped);
+BENCHMARK(benchmark_convert_json_to_header);
+BENCHMARK(benchmark_convert_json_to_vector);
+BENCHMARK(benchmark_convert_json_to_point);
+BENCHMARK(benchmark_convert_json_to_quaternion);
+BENCHMARK(benchmark_convert_json_to_pose_covariance);
+BENCHMARK(benchmark_decode_pose_with_covariance_stamped)->Apply(ros_mqtt_benchmarks::apply_encodings);
+
+BENCHMARK(benchmark_format_numbers)->ArgNames({"formatter", "double"})->Args({0, 0})->Args({1, 0})->Args({2, 0})->Args({0, 1})->Args({1, 1})->Args({2, 1});
+BENCHMARK(benchmark_convert_odom_output_options)->ArgNames({"options"})->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(benchmark_convert_scan_reduction)->ArgNames({"beams", "reduction"})->Args({1440, 0})->Args({1440, 1})->Args({1440, 2})->Args({10000, 2});
+BENCHMARK(benchmark_convert_plan_simplification)->ArgNames({"poses", "simplification"})->Args({1000, 0})->Args({1000, 1})->Args({1000, 2})->Args({10000, 0})->Args({10000, 1})->Args({10000, 2});
+BENCHMARK(benchmark_convert_plan_delta)->ArgNames({"delta"})->Arg(0)->Arg(1);
+
+BENCHMARK(benchmark_loopback_transport)->ArgNames({"bytes", "convert"})->UseRealTime()->Args({64, 0})->Args({1024, 0})->Args({16384, 0})->Args({0, 1});
+
+BENCHMARK_MAIN();
@@ -77,6 +77,12 @@
 
 #include "example_interfaces/srv/add_two_ints.hpp"
 
+/**
+ * include ros_mqtt_metrics' header file
+ * @see ros_mqtt_metrics::MetricsRegistry
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_metrics.hpp"
+
 // define ros default qos
 #define ROS_DEFAULT_QOS 10
 
@@ -114,12 +120,17 @@ namespace ros_connections {
                 rclcpp::Subscription<nav_msgs::msg::Path>::SharedPtr ros_local_plan_subscription_ptr_;
                 rclcpp::Subscription<std_msgs::msg::String>::SharedPtr ros_map_server_map_service_subscription_ptr_;
                 rclcpp::Service<example_interfaces::srv::AddTwoInts>::SharedPtr ros_add_two_ints_service_server_ptr_;
+                ros_mqtt_metrics::MetricsRegistry * ros_metrics_registry_ptr_;
                 void initialize_publishers();
                 void initialize_subscriptions();
+                void initialize_metrics();
                 void initialize_bridge();
+                ros_mqtt_metrics::LatencyTrace record_received(const char * ros_topic);
+                void record_relayed(const char * ros_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void record_dropped(const char * ros_topic);
                 static void handle_add_two_ints_service(const std::shared_ptr<rmw_request_id_t> request_header, const std::shared_ptr<example_interfaces::srv::AddTwoInts::Request> request, const std::shared_ptr<example_interfaces::srv::AddTwoInts::Response> response);
             public :
-                Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr);
+                Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr, ros_mqtt_metrics::MetricsRegistry * ros_metrics_registry_ptr);
                 virtual ~Bridge();
         };
     }
@@ -134,11 +145,15 @@ namespace ros_connections {
                 rclcpp::Subscription<std_msgs::msg::String>::SharedPtr ros_chatter_subscription_ptr_;
                 rclcpp::Subscription<geometry_msgs::msg::Twist>::SharedPtr ros_cmd_vel_subscription_ptr_;
                 rclcpp::Subscription<geometry_msgs::msg::PoseWithCovarianceStamped>::SharedPtr ros_initial_pose_subscription_ptr_;
+                ros_mqtt_metrics::MetricsRegistry * ros_metrics_registry_ptr_;
                 void initialize_publishers();
                 void initialize_subscriptions();
+                void initialize_metrics();
                 void initialize_bridge();
+                ros_mqtt_metrics::LatencyTrace record_received(const char * ros_topic);
+                void record_relayed(const char * ros_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace);
             public :
-                Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr);
+                Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr, ros_mqtt_metrics::MetricsRegistry * ros_metrics_registry_ptr);
                 virtual ~Bridge();
         };
     }
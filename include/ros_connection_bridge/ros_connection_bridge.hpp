@@ -39,6 +39,10 @@
 #include "ros_connection_bridge/connections/ros_connections.hpp"
 
 #define LOG_ROS_CONNECTION_BRIDGE "[ROS-CONNECTION-BRIDGE]"
+#define METRICS_PREFIX "ros_connection_bridge"
+#define METRICS_PUBLISH_PERIOD_MS 1000
+#define METRICS_DIAGNOSTICS_TOPIC "/diagnostics"
+#define METRICS_PROMETHEUS_FILE "/tmp/ros_connection_bridge.prom"
 
 using std::placeholders::_1;
 using namespace std::chrono_literals;
@@ -54,6 +58,8 @@ class RosConnectionBridge : public rclcpp::Node {
         std::shared_ptr<rclcpp::Node> ros_node_ptr_;
         ros_connections::ros_connections_to_mqtt::Bridge * ros_connections_to_mqtt_bridge_ptr_;
         ros_connections::ros_connections_from_mqtt::Bridge * ros_connections_from_mqtt_bridge_ptr_;
+        ros_mqtt_metrics::MetricsRegistry * ros_metrics_registry_ptr_;
+        ros_mqtt_metrics::MetricsExporter * ros_metrics_exporter_ptr_;
         void check_current_topics_and_types();
     public :
         RosConnectionBridge();
@@ -0,0 +1,92 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_BACKPRESSURE
+#define ROS_MQTT_BACKPRESSURE
+
+/**
+ * include cpp header files
+ * @see string
+ * @see map
+ * @see atomic
+ * @see chrono
+*/
+#include <string>
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief namespace for declare backpressure of egress, which throttles & then degrades bulk topics while the uplink can not keep up
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @see ros_mqtt_connections::manager::Bridge
+*/
+namespace ros_mqtt_backpressure {
+    enum class PressureLevel : uint8_t {
+        NORMAL = 0,
+        THROTTLED = 1,
+        DEGRADED = 2
+    };
+
+    const char * level_name(PressureLevel pressure_level);
+
+    /**
+     * @brief Struct for thresholds of backpressure & rates of bulk topics per level
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details egress is congested when queue depth reaches queue_high or worst end-to-end latency exceeds latency_target,
+     * & calm when queue depth is at most queue_low & worst latency at most half of latency_target.
+     * level goes up at most once per settle, so the step before has time to drain queues, & goes down after recover_hold of calm
+    */
+    struct BackpressureOptions {
+        std::size_t queue_high;
+        std::size_t queue_low;
+        std::chrono::milliseconds latency_target;
+        std::chrono::milliseconds settle;
+        std::chrono::milliseconds recover_hold;
+        std::chrono::milliseconds throttled_interval;
+        std::chrono::milliseconds degraded_interval;
+    };
+
+    /**
+     * @brief Class for pressure level of egress & admission of bulk topics at the rate of that level
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details latencies are recorded from every publishing thread, update() & is_admitted() are called from the executor thread only
+    */
+    class EgressGovernor {
+        private :
+            const BackpressureOptions backpressure_options_;
+            std::atomic<uint8_t> pressure_level_;
+            std::atomic<int64_t> worst_latency_ns_;
+            std::chrono::steady_clock::time_point level_changed_;
+            std::chrono::steady_clock::time_point calm_since_;
+            std::map<std::string, std::chrono::steady_clock::time_point, std::less<>> admitted_times_;
+            std::atomic<uint64_t> throttled_count_;
+            std::atomic<uint64_t> escalation_count_;
+        public :
+            explicit EgressGovernor(const BackpressureOptions& backpressure_options);
+            virtual ~EgressGovernor();
+            void record_latency(std::chrono::nanoseconds end_to_end_latency);
+            PressureLevel update(std::size_t queue_depth, std::chrono::steady_clock::time_point now);
+            PressureLevel level() const;
+            bool is_admitted(const char * mqtt_topic, std::chrono::steady_clock::time_point now);
+            uint64_t throttled_count() const;
+            uint64_t escalation_count() const;
+    };
+}
+
+#endif
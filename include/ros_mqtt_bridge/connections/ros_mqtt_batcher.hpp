@@ -0,0 +1,73 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_BATCHER
+#define ROS_MQTT_BATCHER
+
+/**
+ * include cpp header files
+ * @see string
+ * @see vector
+ * @see mutex
+ * @see chrono
+*/
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief namespace for declare batching stage of small high-frequency mqtt payloads
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @see ros_mqtt_connections::manager::Bridge
+*/
+namespace ros_mqtt_batch {
+    /**
+     * @brief Struct for one typed, timestamped entry inside of batch envelope
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct BatchEntry {
+        std::string topic;
+        std::string type;
+        int64_t stamp;
+        std::string payload;
+    };
+
+    /**
+     * @brief Class for collect mqtt payloads for up to max delay or max messages & serialize them into one envelope
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class MessageBatcher {
+        private :
+            const std::size_t max_messages_;
+            const std::chrono::milliseconds max_delay_;
+            std::vector<BatchEntry> batch_entries_;
+            std::chrono::steady_clock::time_point oldest_entry_time_;
+            std::mutex batch_mutex_;
+            std::string serialize_envelope(const std::vector<BatchEntry>& batch_entries);
+        public :
+            MessageBatcher(std::size_t max_messages, std::chrono::milliseconds max_delay);
+            virtual ~MessageBatcher();
+            bool add(const char * mqtt_topic, const char * ros_message_type, int64_t receive_stamp, std::string mqtt_payload);
+            bool is_expired();
+            std::size_t size();
+            std::string flush();
+    };
+}
+
+#endif
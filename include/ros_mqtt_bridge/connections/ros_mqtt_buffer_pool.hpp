@@ -0,0 +1,73 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_BUFFER_POOL
+#define ROS_MQTT_BUFFER_POOL
+
+/**
+ * include cpp header files
+ * @see string
+ * @see vector
+ * @see atomic
+ * @see mutex
+*/
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+#ifndef BUFFER_POOL_MAX_BUFFERS
+#define BUFFER_POOL_MAX_BUFFERS 64
+#endif
+#ifndef BUFFER_POOL_MAX_CAPACITY
+#define BUFFER_POOL_MAX_CAPACITY 262144
+#endif
+
+/**
+ * @brief namespace for declare recycling pool of payload strings
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details encoders take their next buffer from the pool when they release a payload & the bridge gives the payload back after publishing,
+ * so a payload string keeps its capacity from message to message & steady state egress does not allocate
+*/
+namespace ros_mqtt_buffer_pool {
+    /**
+     * @brief Class for keep released payload strings with their capacity & hand them out again
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details buffers are given back on other threads than they were taken(compression worker), so one pool is shared under a mutex.
+     * the free list is reserved up front & buffers larger than max buffer capacity are freed, so maps do not stay resident
+    */
+    class BufferPool {
+        private :
+            const std::size_t max_buffers_;
+            const std::size_t max_buffer_capacity_;
+            std::vector<std::string> free_buffers_;
+            std::mutex buffer_mutex_;
+            std::atomic<uint64_t> reused_count_;
+            std::atomic<uint64_t> missed_count_;
+        public :
+            BufferPool(std::size_t max_buffers, std::size_t max_buffer_capacity);
+            virtual ~BufferPool();
+            static BufferPool& instance();
+            std::string acquire();
+            void recycle(std::string& buffer);
+            std::size_t size();
+            uint64_t reused_count() const;
+            uint64_t missed_count() const;
+    };
+}
+
+#endif
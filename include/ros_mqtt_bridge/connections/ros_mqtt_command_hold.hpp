@@ -0,0 +1,84 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_COMMAND_HOLD
+#define ROS_MQTT_COMMAND_HOLD
+
+/**
+ * include cpp header files
+ * @see mutex
+ * @see chrono
+*/
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * include ros2 header files
+ * @see geometry_msgs::msg::Twist
+*/
+#include "geometry_msgs/msg/twist.hpp"
+
+/**
+ * include ros_mqtt_metrics' header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_metrics.hpp"
+
+/**
+ * @brief namespace for declare latest-wins hold of ingress velocity commands which are published into ros at a fixed rate
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @see ros_mqtt_connections::manager::Bridge
+*/
+namespace ros_mqtt_command {
+    /**
+     * @brief Struct for command which is published on one tick
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details is_fresh is set on the first tick of a command, so its latency is recorded once.
+     * is_timed_out is set on the tick which replaced an expired command with zero velocity
+    */
+    struct HeldCommand {
+        geometry_msgs::msg::Twist twist;
+        ros_mqtt_metrics::LatencyTrace latency_trace;
+        bool is_fresh;
+        bool is_timed_out;
+    };
+
+    /**
+     * @brief Class for keep only latest velocity command & hand it out on every tick until watchdog expires
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details commands are held from the transport thread & ticked from the executor thread, so they are shared under a mutex.
+     * once watchdog expires, zero velocity is handed out once & ticks hand out nothing until next command
+    */
+    class CommandHold {
+        private :
+            const std::chrono::milliseconds watchdog_;
+            std::mutex command_mutex_;
+            HeldCommand held_command_;
+            bool is_held_;
+            uint64_t coalesced_count_;
+            uint64_t timeout_count_;
+        public :
+            explicit CommandHold(std::chrono::milliseconds watchdog);
+            virtual ~CommandHold();
+            void hold(const geometry_msgs::msg::Twist& twist_msgs, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+            bool tick(std::chrono::steady_clock::time_point now, HeldCommand& held_command);
+            uint64_t coalesced_count();
+            uint64_t timeout_count();
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_COMPRESSOR
+#define ROS_MQTT_COMPRESSOR
+
+/**
+ * include cpp header files
+ * @see string
+ * @see deque
+ * @see thread
+ * @see mutex
+ * @see condition_variable
+ * @see functional
+*/
+#include <iostream>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * include ros_mqtt_metrics' header file
+ * @see ros_mqtt_metrics::LatencyTrace
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_metrics.hpp"
+
+/**
+ * include compression library header files
+ * @see zlib.h
+ * @see zstd.h
+*/
+#include <zlib.h>
+#ifdef ROS_MQTT_BRIDGE_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#define LOG_ROS_MQTT_COMPRESSOR "[RosMqttCompressor]"
+#define MQTT_COMPRESSION_HEADER_SIZE 7
+#define MQTT_COMPRESSION_DRAIN_POLL_MS 5
+#ifndef MQTT_DECOMPRESSION_MAX_SIZE
+#define MQTT_DECOMPRESSION_MAX_SIZE (64u * 1024u * 1024u)
+#endif
+#define MQTT_DEFLATE_MAX_RATIO 1032u
+
+/**
+ * @brief namespace for declare per-topic mqtt payload compression
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details compressed payloads start with header [0x00, 'Z', codec, uncompressed size (uint32 big endian)].
+ * 0x00 is never the first byte of a JSON text, so ingress can tell compressed payloads from raw ones.
+*/
+namespace ros_mqtt_compression {
+    enum class Codec : uint8_t {
+        NONE = 0,
+        DEFLATE = 1,
+        ZSTD = 2
+    };
+
+    /**
+     * @brief Struct for per-topic compression settings
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct CompressionOptions {
+        Codec codec;
+        int level;
+        std::size_t threshold;
+    };
+
+    bool is_compressed(const std::string& mqtt_payload);
+    bool compress(const std::string& raw_payload, const CompressionOptions& compression_options, std::string& compressed_payload);
+    bool decompress(const std::string& compressed_payload, std::string& raw_payload);
+
+    /**
+     * @brief Class for compress & mqtt publish payloads on its own worker thread, off the rclcpp executor thread
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class CompressionWorker {
+        private :
+            struct CompressionJob {
+                std::string mqtt_topic;
+                std::string mqtt_payload;
+                CompressionOptions compression_options;
+                ros_mqtt_metrics::LatencyTrace latency_trace;
+            };
+            const std::size_t max_queue_size_;
+            std::function<void(const char *, std::string, const ros_mqtt_metrics::LatencyTrace&)> publish_function_;
+            std::function<void(const char *)> drop_function_;
+            std::deque<CompressionJob> compression_jobs_;
+            std::mutex compression_mutex_;
+            std::condition_variable compression_condition_;
+            bool is_running_;
+            std::thread compression_thread_;
+            void run();
+        public :
+            CompressionWorker(std::size_t max_queue_size, std::function<void(const char *, std::string, const ros_mqtt_metrics::LatencyTrace&)> publish_function, std::function<void(const char *)> drop_function = nullptr);
+            virtual ~CompressionWorker();
+            void submit(const char * mqtt_topic, std::string mqtt_payload, const CompressionOptions& compression_options, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+            std::size_t queue_size();
+            void stop();
+            std::size_t drain(std::chrono::steady_clock::time_point drain_deadline);
+    };
+}
+
+#endif
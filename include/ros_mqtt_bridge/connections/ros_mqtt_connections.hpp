@@ -31,6 +31,8 @@
 #include <unistd.h>
 #include <signal.h>
 #include <functional>
+#include <map>
+#include <set>
 
 #include "mqtt/async_client.h"
 
@@ -87,14 +89,183 @@
 */
 #include "ros_mqtt_bridge/connections/ros_mqtt_message_converter.hpp"
 
+/**
+ * include ros_mqtt_batcher's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_batcher.hpp"
+
+/**
+ * include ros_mqtt_compressor's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_compressor.hpp"
+
+/**
+ * include ros_mqtt_metrics' header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_metrics.hpp"
+
+/**
+ * include ros_mqtt_transport's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_transport.hpp"
+
+/**
+ * include ros_mqtt_shared_memory's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_shared_memory.hpp"
+
+/**
+ * include ros_mqtt_last_value_cache's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_last_value_cache.hpp"
+
+/**
+ * include ros_mqtt_tf_aggregator's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_tf_aggregator.hpp"
+
+/**
+ * include ros_mqtt_deadband's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_deadband.hpp"
+
+/**
+ * include ros_mqtt_command_hold's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_command_hold.hpp"
+
+/**
+ * include ros_mqtt_backpressure's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_backpressure.hpp"
+
+/**
+ * include ros_mqtt_connector's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_connector.hpp"
+
 #define LOG_ROS_MQTT_BRIDGE "[ROS-MQTT-BRIDGE]"
 #define LOG_ROS_MQTT_CONNECTION_TO_ROS "[MQTT to ROS]"
 #define LOG_ROS_MQTT_CONNECTION_TO_MQTT "[ROS to MQTT]"
 #define ROS_DEFAULT_QOS 10
+#define ROS_TF_STATIC_QOS_DEPTH 100
 #define MQTT_ADDRESS    "tcp://localhost:1883"
 #define MQTT_CLIENT_ID    "ros_mqtt_bridge"
 #define MQTT_QOS         0
+#ifndef MQTT_TRANSPORT
+#define MQTT_TRANSPORT ros_mqtt_transport::TransportKind::PAHO
+#endif
+#define MQTT_CONNECT_TIMEOUT_S 30
+#define MQTT_CONNECT_RETRY_MIN_MS 500
+#define MQTT_CONNECT_RETRY_MAX_MS 30000
+#define MQTT_OFFLINE_BUFFER_SIZE 256
+#define MQTT_SHUTDOWN_DRAIN_MS 3000
+#define MQTT_SHUTDOWN_POLL_MS 10
 #define MQTT_N_RETRY_ATTEMPTS 5
+#define MQTT_BATCH_ENABLED false
+#define MQTT_BATCH_MAX_MESSAGES 20
+#define MQTT_BATCH_MAX_DELAY_MS 100
+#define MQTT_BATCH_FLUSH_TICKS 4
+#define MQTT_COMPRESSION_CODEC ros_mqtt_compression::Codec::NONE
+#define MQTT_COMPRESSION_LEVEL 6
+#define MQTT_COMPRESSION_THRESHOLD 1024
+#define MQTT_MAP_COMPRESSION_LEVEL 9
+#define MQTT_STREAM_COMPRESSION_CODEC MQTT_COMPRESSION_CODEC
+#define MQTT_STREAM_COMPRESSION_LEVEL 1
+#define MQTT_STREAM_COMPRESSION_THRESHOLD 1024
+#define MQTT_COMPRESSION_QUEUE_SIZE 64
+#define MQTT_EGRESS_ENCODING ros_message_encoder::Encoding::JSON
+#define MQTT_INGRESS_ENCODING ros_message_encoder::Encoding::JSON
+#define MQTT_POSE_DECIMALS JSON_SHORTEST_DECIMALS
+#define MQTT_SCAN_DECIMALS JSON_SHORTEST_DECIMALS
+#define MQTT_ZERO_COVARIANCE_OMITTED false
+#define MQTT_SCAN_TIMING_OMITTED false
+#define MQTT_SCAN_INTENSITIES_OMITTED false
+#ifndef MQTT_REDUCED_SCAN_ENABLED
+#define MQTT_REDUCED_SCAN_ENABLED false
+#endif
+#define MQTT_REDUCED_SCAN_BEAMS 180
+#define MQTT_REDUCED_SCAN_ANGLE_MIN -1.5707964f
+#define MQTT_REDUCED_SCAN_ANGLE_MAX 1.5707964f
+#define MQTT_REDUCED_SCAN_RANGE_CLAMP 10.0f
+#define MQTT_PATH_SIMPLIFICATION ros_mqtt_path::PathSimplification::DOUGLAS_PEUCKER
+#define MQTT_PATH_TOLERANCE 0.01
+#define MQTT_GLOBAL_PLAN_MAX_POSES 500
+#define MQTT_LOCAL_PLAN_MAX_POSES 100
+#ifndef MQTT_PATH_DELTA_ENABLED
+#define MQTT_PATH_DELTA_ENABLED false
+#endif
+#define MQTT_PATH_KEYFRAME_INTERVAL 20
+#ifndef MQTT_DEADBAND_ENABLED
+#define MQTT_DEADBAND_ENABLED false
+#endif
+#define MQTT_DEADBAND_TRANSLATION 0.01
+#define MQTT_DEADBAND_ROTATION 0.01
+#define MQTT_DEADBAND_VELOCITY 0.01
+#define MQTT_DEADBAND_HEARTBEAT_MS 1000
+#ifndef MQTT_DEADLINE_ENABLED
+#define MQTT_DEADLINE_ENABLED false
+#endif
+// SOURCE_STAMP needs ros, bridge & rcs clocks synced within max ages & no use_sim_time
+#define MQTT_DEADLINE_SOURCE ros_mqtt_metrics::DeadlineSource::RECEIVED
+#define MQTT_SCAN_MAX_AGE_MS 200
+#define MQTT_ODOM_MAX_AGE_MS 200
+#define MQTT_CMD_VEL_MAX_AGE_MS 200
+#ifndef MQTT_CMD_VEL_LATEST_WINS
+#define MQTT_CMD_VEL_LATEST_WINS false
+#endif
+#define MQTT_CMD_VEL_PERIOD_MS 50
+// capped by MQTT_CMD_VEL_MAX_AGE_MS while deadlines are enabled, so a held command is not republished once it is stale
+#define MQTT_CMD_VEL_WATCHDOG_MS 500
+#ifndef MQTT_BACKPRESSURE_ENABLED
+#define MQTT_BACKPRESSURE_ENABLED false
+#endif
+#define MQTT_BACKPRESSURE_PERIOD_MS 250
+// queue depth is pending delivery tokens plus compression queue, publish is synchronous so tokens stay at one per publishing thread (at most 3), LOW leaves room for them
+#define MQTT_BACKPRESSURE_QUEUE_HIGH 8
+#define MQTT_BACKPRESSURE_QUEUE_LOW 3
+#define MQTT_BACKPRESSURE_LATENCY_TARGET_MS 500
+#define MQTT_BACKPRESSURE_SETTLE_MS 1000
+#define MQTT_BACKPRESSURE_RECOVER_HOLD_MS 3000
+#define MQTT_BACKPRESSURE_THROTTLED_INTERVAL_MS 200
+#define MQTT_BACKPRESSURE_DEGRADED_INTERVAL_MS 1000
+#define MQTT_BACKPRESSURE_SCAN_BEAMS 90
+#define MQTT_BACKPRESSURE_PLAN_MAX_POSES 50
+#define LOG_LEVEL ros_mqtt_logger::LogLevel::INFO
+#define LOG_PAYLOAD_ENABLED false
+#define LOG_HIGH_RATE_SAMPLE_RATE 50
+#define METRICS_PREFIX "ros_mqtt_bridge"
+#define METRICS_PUBLISH_PERIOD_MS 1000
+#define METRICS_DIAGNOSTICS_TOPIC "/diagnostics"
+#define METRICS_PROMETHEUS_FILE "/tmp/ros_mqtt_bridge.prom"
+#ifndef MQTT_TRACE_ENABLED
+#define MQTT_TRACE_ENABLED false
+#endif
+#ifndef MQTT_ECHO_ENABLED
+#define MQTT_ECHO_ENABLED false
+#endif
+#ifndef SHM_SINK_ENABLED
+#define SHM_SINK_ENABLED false
+#endif
+#define SHM_SINK_PREFIX "/ros_mqtt_bridge"
+#define SHM_SLOT_COUNT 16
+#define SHM_SLOT_SIZE 262144
+#define SHM_MAP_SLOT_COUNT 2
+#define SHM_MAP_SLOT_SIZE 16777216
+#ifndef MQTT_LAST_VALUE_CACHE_ENABLED
+#define MQTT_LAST_VALUE_CACHE_ENABLED false
+#endif
+#ifndef MQTT_RETAINED_ENABLED
+#define MQTT_RETAINED_ENABLED false
+#endif
+#ifndef TF_AGGREGATION_ENABLED
+#define TF_AGGREGATION_ENABLED false
+#endif
+#define TF_AGGREGATION_PERIOD_MS 100
+#define TF_AGGREGATION_CACHE_SECONDS 10
+#define TF_MAP_FRAME "map"
+#define TF_ODOM_FRAME "odom"
+#define TF_BASE_FRAME "base_link"
 
 using std::placeholders::_1;
 using namespace std::chrono_literals;
@@ -108,14 +279,16 @@ using namespace std::chrono_literals;
 */
 namespace ros_mqtt_connections {
     namespace manager {
-        class Bridge : public virtual mqtt::callback {
+        class Bridge : public virtual ros_mqtt_transport::TransportCallback {
             private :
                 const std::string& log_ros_mqtt_bridge_;
                 const std::string& log_ros_mqtt_connections_to_mqtt_;
                 const std::string& log_ros_mqtt_connections_to_ros_;
                 std::shared_ptr<rclcpp::Node> ros_node_ptr_;
                 const int ros_default_qos_;
-                mqtt::async_client mqtt_async_client_;
+                ros_mqtt_transport::Transport * mqtt_transport_ptr_;
+                ros_mqtt_connector::Connector * mqtt_connector_ptr_;
+                ros_mqtt_connector::OfflineBuffer * mqtt_offline_buffer_ptr_;
                 ros_message_converter::ros_std_msgs::StdMessageConverter * std_msgs_converter_ptr_;
                 ros_message_converter::ros_geometry_msgs::GeometryMessageConverter * geometry_msgs_converter_ptr_;
                 ros_message_converter::ros_sensor_msgs::SensorMessageConverter * sensor_msgs_converter_ptr_;
@@ -126,6 +299,8 @@ namespace ros_mqtt_connections {
                 rclcpp::Publisher<geometry_msgs::msg::PoseWithCovarianceStamped>::SharedPtr ros_initial_pose_publisher_ptr_;
                 rclcpp::Publisher<example_interfaces::srv::AddTwoInts_Response>::SharedPtr ros_add_two_ints_publisher_ptr_;
                 rclcpp::Publisher<std_msgs::msg::String>::SharedPtr ros_map_server_map_publisher_ptr_;
+                rclcpp::Publisher<std_msgs::msg::String>::SharedPtr ros_echo_publisher_ptr_;
+                rclcpp::Publisher<std_msgs::msg::String>::SharedPtr ros_status_publisher_ptr_;
                 rclcpp::Client<example_interfaces::srv::AddTwoInts>::SharedPtr ros_add_two_ints_service_client_ptr_;
                 rclcpp::Subscription<std_msgs::msg::String>::SharedPtr ros_chatter_subscription_ptr_;
                 rclcpp::Subscription<geometry_msgs::msg::Pose>::SharedPtr ros_robot_pose_subscription_ptr_;
@@ -138,21 +313,97 @@ namespace ros_mqtt_connections {
                 rclcpp::Subscription<geometry_msgs::msg::Twist>::SharedPtr ros_cmd_vel_subscription_ptr_;
                 rclcpp::Subscription<example_interfaces::srv::AddTwoInts_Response>::SharedPtr ros_add_two_ints_subscription_ptr_;
                 rclcpp::Subscription<nav_msgs::srv::GetMap_Response>::SharedPtr ros_map_server_map_subscription_ptr_;
+                rclcpp::Subscription<std_msgs::msg::String>::SharedPtr ros_echo_subscription_ptr_;
+                rclcpp::TimerBase::SharedPtr mqtt_batch_timer_ptr_;
+                ros_mqtt_batch::MessageBatcher * mqtt_batcher_ptr_;
+                ros_mqtt_compression::CompressionWorker * mqtt_compression_worker_ptr_;
+                std::map<std::string, ros_mqtt_compression::CompressionOptions, std::less<>> mqtt_compression_options_;
+                std::map<ros_message_encoder::Encoding, ros_message_encoder::MessageEncoder *> mqtt_encoder_ptrs_;
+                std::map<ros_message_encoder::Encoding, ros_message_encoder::MessageDecoder *> mqtt_decoder_ptrs_;
+                std::map<std::string, ros_message_encoder::Encoding, std::less<>> mqtt_egress_encodings_;
+                std::map<std::string, ros_message_encoder::Encoding> mqtt_ingress_encodings_;
+                std::map<std::string, ros_message_encoder::OutputOptions, std::less<>> mqtt_output_options_;
+                std::map<std::string, ros_message_encoder::OutputOptions, std::less<>> mqtt_degraded_output_options_;
+                ros_mqtt_metrics::MetricsRegistry * mqtt_metrics_registry_ptr_;
+                ros_mqtt_metrics::MetricsExporter * mqtt_metrics_exporter_ptr_;
+                std::set<std::string, std::less<>> mqtt_traced_topics_;
+                std::map<std::string, ros_mqtt_shm::SharedMemoryRing *, std::less<>> shm_sink_ptrs_;
+                ros_mqtt_cache::LastValueCache * mqtt_last_value_cache_ptr_;
+                std::set<std::string, std::less<>> mqtt_cached_topics_;
+                std::set<std::string, std::less<>> mqtt_retained_topics_;
+                ros_mqtt_tf::FramePairAggregator * tf_aggregator_ptr_;
+                rclcpp::TimerBase::SharedPtr tf_aggregation_timer_ptr_;
+                tf2_msgs::msg::TFMessage tf_composed_message_;
+                std::map<std::string, ros_mqtt_path::PathDelta *, std::less<>> mqtt_path_delta_ptrs_;
+                std::map<std::string, ros_mqtt_deadband::DeadbandFilter *, std::less<>> mqtt_deadband_ptrs_;
+                std::map<std::string, ros_mqtt_metrics::Deadline, std::less<>> mqtt_deadlines_;
+                ros_mqtt_command::CommandHold * mqtt_cmd_vel_hold_ptr_;
+                rclcpp::TimerBase::SharedPtr cmd_vel_hold_timer_ptr_;
+                ros_mqtt_backpressure::EgressGovernor * mqtt_egress_governor_ptr_;
+                rclcpp::TimerBase::SharedPtr backpressure_timer_ptr_;
                 const int mqtt_qos_;
                 const int mqtt_is_success_;
+                const bool mqtt_batch_enabled_;
+                bool is_shut_down_;
+                std::atomic<int64_t> drain_deadline_ns_;
                 void mqtt_connect();
+                void mqtt_connected();
+                void report_connection_state(ros_mqtt_connector::ConnectionState connection_state);
                 void grant_mqtt_subscriptions();
                 void connection_lost(const std::string& mqtt_connection_lost_cause) override;
-                void message_arrived(mqtt::const_message_ptr mqtt_message) override;
-                void delivery_complete(mqtt::delivery_token_ptr mqtt_delivered_token) override;
-                void mqtt_publish(const char * mqtt_topic, std::string mqtt_payload);
+                void message_arrived(const std::string& arrived_topic, const std::string& arrived_payload) override;
+                void delivery_complete(int delivered_message_id) override;
+                void mqtt_publish(const char * mqtt_topic, std::string mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace = ros_mqtt_metrics::LatencyTrace());
+                void mqtt_transmit(const char * mqtt_topic, std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace);
                 void mqtt_subscribe(const char * mqtt_topic);
+                void initialize_logger();
+                void initialize_mqtt_batch();
+                void mqtt_publish_batched(const char * mqtt_topic, const char * ros_message_type, std::string mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void flush_mqtt_batch();
+                void initialize_mqtt_compression();
+                void mqtt_publish_compressed(const char * mqtt_topic, std::string mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace = ros_mqtt_metrics::LatencyTrace());
+                void initialize_mqtt_encodings();
+                ros_message_encoder::Encoding egress_encoding(const char * mqtt_topic);
+                ros_message_encoder::Encoding ingress_encoding(const std::string& mqtt_topic);
+                ros_message_encoder::MessageEncoder& egress_encoder(const char * mqtt_topic);
+                Json::Value decode_mqtt_payload(const std::string& mqtt_topic, const std::string& mqtt_payload);
+                void initialize_metrics();
+                ros_mqtt_metrics::TopicMetrics * topic_metrics(const std::string& topic);
+                ros_mqtt_metrics::TopicMetrics * topic_metrics(const char * topic);
+                void record_dropped(const char * mqtt_topic);
+                void record_converted(const char * mqtt_topic, ros_mqtt_metrics::LatencyTrace& latency_trace, std::size_t mqtt_payload_size);
+                void record_conversion_error(const std::string& mqtt_topic, bool is_conversion_failed);
+                void record_published(const std::string& mqtt_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void initialize_tracing();
+                bool embed_trace(const char * mqtt_topic, std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void initialize_shm_sinks();
+                bool share_local(const char * mqtt_topic, const std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void initialize_last_value_cache();
+                void cache_last_value(const char * mqtt_topic, const std::string& mqtt_payload);
+                void bridge_snapshot(const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void initialize_tf_aggregation();
+                void publish_composed_tf();
+                void initialize_path_deltas();
+                void request_path_keyframes();
+                void convert_plan(const char * mqtt_topic, const nav_msgs::msg::Path& path_msgs, ros_message_encoder::MessageEncoder& message_encoder);
+                void initialize_deadbands();
+                bool is_deadband_passed(const char * mqtt_topic, const ros_mqtt_deadband::MotionSample& motion_sample, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void initialize_deadlines();
+                bool is_stale(const char * mqtt_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void initialize_cmd_vel_hold();
+                void publish_held_cmd_vel();
+                void initialize_backpressure();
+                void regulate_egress();
+                bool is_egress_admitted(const char * mqtt_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+                void bridge_echo(std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace);
                 void bridge_ros_to_mqtt();
                 void bridge_mqtt_to_ros();
-                void bridge_mqtt_to_ros(std::string& mqtt_topic, std::string& mqtt_payload);
+                void bridge_mqtt_to_ros(std::string& mqtt_topic, std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace);
             public :
                 Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr);
+                Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr, ros_mqtt_transport::Transport * mqtt_transport_ptr);
                 virtual ~Bridge();
+                void shutdown(std::chrono::milliseconds drain_timeout);
         };
     }
 }
@@ -170,6 +421,8 @@ namespace ros_topics {
         const char * navigate_to_pose = "mqtt_bridge/navigate_to_pose";
         const char * add_two_ints = "mqtt_bridge/add_two_ints";
         const char * map_server_map = "mqtt_bridge/map_server/map";
+        const char * echo = "mqtt_bridge/echo";
+        const char * status = "mqtt_bridge/status";
     }
     namespace from_ros {
         const char * chatter = "/chatter";
@@ -183,6 +436,7 @@ namespace ros_topics {
         const char * local_plan = "conenction_bridge/local_plan";
         const char * add_two_ints = "mqtt_bridge/add_two_ints";
         const char * map_server_map = "conenction_bridge/map_server/map";
+        const char * echo = "mqtt_bridge/echo";
     }
 }
 
@@ -210,6 +464,7 @@ namespace mqtt_topics {
         const char * chatter = "/callback/chatter";
         const char * robot_pose = "/robot_pose";
         const char * scan = "/scan";
+        const char * reduced_scan = "/scan/reduced";
         const char * tf = "/tf";
         const char * tf_static = "/tf_static";
         const char * odom = "/odom";
@@ -219,6 +474,9 @@ namespace mqtt_topics {
         const char * navigate_to_pose = "/navigate_to_pose/response";
         const char * add_two_ints = "/add_two_ints/response";
         const char * map_server_map = "/map_server/map/response";
+        const char * batch = "/batch";
+        const char * echo = "/echo/response";
+        const char * snapshot = "/snapshot/response";
     }
     namespace from_rcs {
         const char * chatter = "/chatter";
@@ -227,7 +485,20 @@ namespace mqtt_topics {
         const char * navigate_to_pose = "/navigate_to_pose/request";
         const char * add_two_ints = "/add_two_ints/request";
         const char * map_server_map = "r/map_server/map/request";
+        const char * echo = "/echo/request";
+        const char * snapshot = "/snapshot/request";
     }
 }
 
+/**
+ * @brief namespace for declare ros message type names which are written into batch envelope entries
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+namespace ros_message_types {
+    const char * pose = "geometry_msgs/msg/Pose";
+    const char * tf = "tf2_msgs/msg/TFMessage";
+    const char * odom = "nav_msgs/msg/Odometry";
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_CONNECTOR
+#define ROS_MQTT_CONNECTOR
+
+/**
+ * include cpp header files
+ * @see deque
+ * @see thread
+ * @see mutex
+ * @see condition_variable
+ * @see functional
+*/
+#include <string>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * include ros_mqtt_transport's header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_transport.hpp"
+
+/**
+ * include ros_mqtt_metrics' header file
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_metrics.hpp"
+
+/**
+ * @brief namespace for declare background connection of transport & buffering of egress while it is not connected
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @see ros_mqtt_connections::manager::Bridge
+*/
+namespace ros_mqtt_connector {
+    enum class ConnectionState : uint8_t {
+        DISCONNECTED = 0,
+        CONNECTING = 1,
+        CONNECTED = 2
+    };
+
+    const char * state_name(ConnectionState connection_state);
+
+    /**
+     * @brief Struct for timeout of one connect attempt & backoff between failed attempts, which doubles from retry_min up to retry_max
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct ConnectorOptions {
+        std::chrono::seconds connect_timeout;
+        std::chrono::milliseconds retry_min;
+        std::chrono::milliseconds retry_max;
+    };
+
+    /**
+     * @brief Class for connect transport on a background thread & connect again after connection was lost
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details connected_function runs on the connector thread after each successful connect & before state becomes CONNECTED,
+     * e.g. to subscribe again since sessions are clean. state_function runs on the connector thread on every state change.
+     * stop() cancels a connect attempt in progress within MQTT_TRANSPORT_CONNECT_POLL_MS, connected_function should check is_running() between long steps
+    */
+    class Connector {
+        private :
+            ros_mqtt_transport::Transport& transport_;
+            const ConnectorOptions connector_options_;
+            std::function<void()> connected_function_;
+            std::function<void(ConnectionState)> state_function_;
+            std::atomic<uint8_t> connection_state_;
+            std::atomic<uint64_t> attempt_count_;
+            std::mutex connector_mutex_;
+            std::condition_variable connector_condition_;
+            bool is_running_;
+            bool is_lost_;
+            std::thread connector_thread_;
+            void run();
+            void change_state(ConnectionState connection_state);
+        public :
+            Connector(ros_mqtt_transport::Transport& transport, const ConnectorOptions& connector_options, std::function<void()> connected_function, std::function<void(ConnectionState)> state_function);
+            virtual ~Connector();
+            void start();
+            void stop();
+            void notify_lost();
+            bool is_running();
+            ConnectionState state() const;
+            uint64_t attempt_count() const;
+    };
+
+    /**
+     * @brief Struct for egress message which waits for connection
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details topic is copied, since publishers like compression worker hand out topics which do not outlive the call
+    */
+    struct OfflineMessage {
+        std::string mqtt_topic;
+        std::string mqtt_payload;
+        ros_mqtt_metrics::LatencyTrace latency_trace;
+    };
+
+    /**
+     * @brief Class for bounded buffer of egress messages which are published while not connected, oldest message is dropped when full
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details buffer is open while not connected. closing hands out buffered messages & opening/closing is atomic with hold(),
+     * so no message is buffered after its buffer was handed out. capacity 0 drops every message while not connected.
+     * drop_function is called with topic of every dropped message, under the buffer's mutex
+    */
+    class OfflineBuffer {
+        private :
+            const std::size_t capacity_;
+            std::function<void(const char *)> drop_function_;
+            std::deque<OfflineMessage> offline_messages_;
+            std::mutex buffer_mutex_;
+            bool is_open_;
+            std::atomic<uint64_t> dropped_count_;
+        public :
+            OfflineBuffer(std::size_t capacity, std::function<void(const char *)> drop_function = nullptr);
+            virtual ~OfflineBuffer();
+            bool hold(const char * mqtt_topic, std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace);
+            void open();
+            std::deque<OfflineMessage> close();
+            std::size_t size();
+            uint64_t dropped_count() const;
+    };
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_DEADBAND
+#define ROS_MQTT_DEADBAND
+
+/**
+ * include cpp header files
+ * @see atomic
+ * @see chrono
+*/
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * include ros2 header files
+ * @see geometry_msgs::msg::Pose
+ * @see geometry_msgs::msg::Twist
+ * @see nav_msgs::msg::Odometry
+*/
+#include "geometry_msgs/msg/pose.hpp"
+#include "geometry_msgs/msg/twist.hpp"
+#include "nav_msgs/msg/odometry.hpp"
+
+/**
+ * @brief namespace for declare deadband filtering of pose-like topics, which suppresses messages until robot moved or its velocity changed
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+namespace ros_mqtt_deadband {
+    /**
+     * @brief Struct for deadband thresholds of a topic
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details translation in meters, rotation in radians, velocity in m/s for linear & rad/s for angular velocity.
+     * a message passes when a change is larger than its threshold, so thresholds of 0 suppress identical messages only.
+     * heartbeat lets a message pass when none passed for that long, 0 disables it
+    */
+    struct DeadbandThresholds {
+        double translation;
+        double rotation;
+        double velocity;
+        std::chrono::milliseconds heartbeat;
+    };
+
+    /**
+     * @brief Struct for pose & velocity of a message which deadband compares, fields a message does not have stay at identity
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct MotionSample {
+        double position[3];
+        double orientation[4];
+        double linear[3];
+        double angular[3];
+    };
+
+    /**
+     * @brief Class for deadband filter of one topic, compares each message with the last message which passed
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details a message whose velocity becomes all zero always passes, so a stop is never held back by the velocity threshold.
+     * not thread safe except suppressed_count(), one filter per topic
+    */
+    class DeadbandFilter {
+        private :
+            const DeadbandThresholds thresholds_;
+            MotionSample last_sample_;
+            std::chrono::steady_clock::time_point last_passed_;
+            bool is_sample_passed_;
+            std::atomic<uint64_t> suppressed_count_;
+            bool is_changed(const MotionSample& motion_sample) const;
+        public :
+            explicit DeadbandFilter(const DeadbandThresholds& thresholds);
+            virtual ~DeadbandFilter();
+            bool is_passed(const MotionSample& motion_sample, std::chrono::steady_clock::time_point received);
+            uint64_t suppressed_count() const;
+    };
+
+    MotionSample identity_sample();
+    MotionSample to_sample(const geometry_msgs::msg::Pose& pose_msgs);
+    MotionSample to_sample(const geometry_msgs::msg::Twist& twist_msgs);
+    MotionSample to_sample(const nav_msgs::msg::Odometry& odom_msgs);
+    double distance(const double * first_vector, const double * second_vector);
+    double rotation_angle(const double * first_quaternion, const double * second_quaternion);
+    bool is_zero_velocity(const MotionSample& motion_sample);
+}
+
+#endif
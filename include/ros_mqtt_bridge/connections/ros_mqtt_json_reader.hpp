@@ -0,0 +1,133 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_JSON_READER
+#define ROS_MQTT_JSON_READER
+
+/**
+ * include cpp header files
+ * @see string
+ * @see cstring
+*/
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#define LOG_ROS_JSON_READER "[RosJsonReader]"
+#define JSON_READER_MAX_DEPTH 32
+
+/**
+ * @brief namespace for declare event driven JSON reader which ingress converters fill ros messages with
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details no DOM is built, each scalar is handed to JsonHandler with the key path it was found at
+*/
+namespace ros_json_reader {
+    /**
+     * @brief Class for key path of current JSON value, object keys & array indices from root
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class JsonPath {
+        private :
+            struct JsonPathSegment {
+                const char * key;
+                std::size_t key_size;
+                std::size_t index;
+                bool is_array;
+            };
+            JsonPathSegment segments_[JSON_READER_MAX_DEPTH];
+            std::string escaped_keys_[JSON_READER_MAX_DEPTH];
+            std::size_t depth_;
+            bool is_from(std::size_t depth) const;
+            template<typename... Keys>
+            bool is_from(std::size_t depth, const char * key, Keys... keys) const {
+                return is_key(depth, key) && is_from(depth + 1, keys...);
+            }
+        public :
+            JsonPath();
+            virtual ~JsonPath();
+            std::size_t depth() const;
+            std::size_t index(std::size_t depth) const;
+            bool is_index(std::size_t depth) const;
+            bool is_key(std::size_t depth, const char * key) const;
+            void push_key(const char * key, std::size_t key_size);
+            void push_escaped_key(const std::string& escaped_key);
+            void push_array();
+            void next_index();
+            void pop();
+            template<typename... Keys>
+            bool is(Keys... keys) const {
+                return sizeof...(keys) == depth_ && is_from(0, keys...);
+            }
+            template<typename... Keys>
+            bool starts_with(Keys... keys) const {
+                return sizeof...(keys) <= depth_ && is_from(0, keys...);
+            }
+    };
+
+    /**
+     * @brief Abstract Class for receive JSON events, every callback is optional
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details string values point into the input or reader's scratch buffer & are only valid during the callback
+    */
+    class JsonHandler {
+        public :
+            JsonHandler();
+            virtual ~JsonHandler();
+            virtual void on_begin_object(const JsonPath& json_path);
+            virtual void on_end_object(const JsonPath& json_path);
+            virtual void on_begin_array(const JsonPath& json_path);
+            virtual void on_end_array(const JsonPath& json_path, std::size_t array_size);
+            virtual void on_null(const JsonPath& json_path);
+            virtual void on_bool(const JsonPath& json_path, bool bool_value);
+            virtual void on_number(const JsonPath& json_path, double number_value);
+            virtual void on_string(const JsonPath& json_path, const char * string_value, std::size_t string_size);
+    };
+
+    /**
+     * @brief Class for parse JSON text & dispatch its values into JsonHandler
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details reuse one instance per thread, its path & scratch buffers keep their capacity between calls
+    */
+    class JsonReader {
+        private :
+            const char * cursor_;
+            const char * end_;
+            JsonPath json_path_;
+            std::string string_buffer_;
+            std::string key_buffer_;
+            std::size_t error_offset_;
+            const char * begin_;
+            void skip_whitespace();
+            bool parse_value(JsonHandler& json_handler);
+            bool parse_object(JsonHandler& json_handler);
+            bool parse_array(JsonHandler& json_handler);
+            bool parse_string(std::string& scratch_buffer, const char *& string_value, std::size_t& string_size);
+            bool parse_number(double& number_value);
+            bool parse_literal(const char * literal, std::size_t literal_size);
+            bool fail();
+        public :
+            JsonReader();
+            virtual ~JsonReader();
+            bool parse(const char * json_data, std::size_t json_size, JsonHandler& json_handler);
+            bool parse(const std::string& json_string, JsonHandler& json_handler);
+            std::size_t error_offset() const;
+    };
+}
+
+#endif
@@ -0,0 +1,69 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_LAST_VALUE_CACHE
+#define ROS_MQTT_LAST_VALUE_CACHE
+
+/**
+ * include cpp header files
+ * @see string
+ * @see map
+ * @see mutex
+ * @see chrono
+*/
+#include <string>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief namespace for declare last-value cache of egress mqtt topics
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @see ros_mqtt_connections::manager::Bridge
+*/
+namespace ros_mqtt_cache {
+    /**
+     * @brief Struct for last payload of one topic with wall clock time it was stored
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct CachedEntry {
+        std::string payload;
+        int64_t stamp;
+    };
+
+    /**
+     * @brief Class for keep last payload of each cached topic & serialize all of them into one snapshot envelope
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details payloads are stored from the executor & compression worker threads and read by snapshot requests of the transport thread,
+     * so entries are shared under a mutex. an entry's string keeps its capacity, so storing same-sized payloads does not allocate
+    */
+    class LastValueCache {
+        private :
+            std::map<std::string, CachedEntry, std::less<>> cached_entries_;
+            std::mutex cache_mutex_;
+        public :
+            LastValueCache();
+            virtual ~LastValueCache();
+            void store(const char * mqtt_topic, const std::string& mqtt_payload);
+            std::size_t size();
+            std::string snapshot();
+    };
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_LOGGER
+#define ROS_MQTT_LOGGER
+
+/**
+ * include cpp header files
+ * @see atomic
+ * @see thread
+ * @see map
+ * @see cstdarg
+*/
+#include <iostream>
+#include <string>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstdarg>
+#include <cstdio>
+
+#define LOG_ROS_MQTT_LOGGER "[RosMqttLogger]"
+
+#ifndef LOG_RING_CAPACITY
+#define LOG_RING_CAPACITY 4096
+#endif
+#define LOG_MESSAGE_SIZE 256
+#define LOG_PAYLOAD_MAX_BYTES 160
+#define LOG_DRAIN_INTERVAL_MS 5
+
+/**
+ * @brief macros for leveled logging, arguments are not evaluated when level is disabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+#define ROS_MQTT_LOG(log_level, ...) \
+    do { \
+        ros_mqtt_logger::Logger& ros_mqtt_logger_instance = ros_mqtt_logger::Logger::instance(); \
+        if(ros_mqtt_logger_instance.is_enabled(log_level)) { \
+            ros_mqtt_logger_instance.log(log_level, __VA_ARGS__); \
+        } \
+    } while(0)
+#define ROS_MQTT_LOG_DEBUG(...) ROS_MQTT_LOG(ros_mqtt_logger::LogLevel::DEBUG, __VA_ARGS__)
+#define ROS_MQTT_LOG_INFO(...) ROS_MQTT_LOG(ros_mqtt_logger::LogLevel::INFO, __VA_ARGS__)
+#define ROS_MQTT_LOG_WARN(...) ROS_MQTT_LOG(ros_mqtt_logger::LogLevel::WARN, __VA_ARGS__)
+#define ROS_MQTT_LOG_ERROR(...) ROS_MQTT_LOG(ros_mqtt_logger::LogLevel::ERROR, __VA_ARGS__)
+
+/**
+ * @brief macro for leveled logging sampled per topic, 1 of every N records of the topic is kept
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+#define ROS_MQTT_LOG_TOPIC(log_level, log_topic, ...) \
+    do { \
+        ros_mqtt_logger::Logger& ros_mqtt_logger_instance = ros_mqtt_logger::Logger::instance(); \
+        if(ros_mqtt_logger_instance.is_enabled(log_level) && ros_mqtt_logger_instance.should_sample(log_topic)) { \
+            ros_mqtt_logger_instance.log(log_level, __VA_ARGS__); \
+        } \
+    } while(0)
+
+/**
+ * @brief macro for log arrival of topic at DEBUG level sampled per topic, with payload head when payload dumping is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details both records share one sampling decision, so a kept arrival always comes with its payload
+*/
+#define ROS_MQTT_LOG_PAYLOAD(payload_topic, payload_data, ...) \
+    do { \
+        ros_mqtt_logger::Logger& ros_mqtt_logger_instance = ros_mqtt_logger::Logger::instance(); \
+        if(ros_mqtt_logger_instance.is_enabled(ros_mqtt_logger::LogLevel::DEBUG) && ros_mqtt_logger_instance.should_sample(payload_topic)) { \
+            ros_mqtt_logger_instance.log(ros_mqtt_logger::LogLevel::DEBUG, __VA_ARGS__); \
+            if(ros_mqtt_logger_instance.is_payload_enabled()) { \
+                ros_mqtt_logger_instance.log_payload(payload_topic, payload_data); \
+            } \
+        } \
+    } while(0)
+
+/**
+ * @brief namespace for declare asynchronous logger which hot paths write into without blocking
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details records are formatted into a lock-free ring buffer slot by the caller & written to stdout/stderr by a background thread.
+ * when the ring is full the record is dropped & counted instead of blocking the caller.
+*/
+namespace ros_mqtt_logger {
+    static_assert(LOG_RING_CAPACITY > 0 && (LOG_RING_CAPACITY & (LOG_RING_CAPACITY - 1)) == 0, "LOG_RING_CAPACITY must be a power of two");
+
+    enum class LogLevel : uint8_t {
+        DEBUG = 0,
+        INFO = 1,
+        WARN = 2,
+        ERROR = 3,
+        OFF = 4
+    };
+
+    /**
+     * @brief Class for leveled asynchronous logging through multi producer single consumer ring buffer
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details topic sample rates must be set before other threads start logging, sampling reads them without locks
+    */
+    class Logger {
+        private :
+            struct LogRecord {
+                std::atomic<std::size_t> sequence;
+                LogLevel level;
+                int64_t stamp;
+                std::size_t message_size;
+                char message[LOG_MESSAGE_SIZE];
+            };
+            struct TopicSampler {
+                uint32_t sample_rate;
+                std::atomic<uint32_t> sample_counter;
+            };
+            const std::size_t capacity_;
+            LogRecord * log_records_;
+            std::atomic<std::size_t> enqueue_position_;
+            std::size_t dequeue_position_;
+            std::atomic<uint64_t> dropped_records_;
+            std::atomic<uint8_t> log_level_;
+            std::atomic<bool> is_payload_enabled_;
+            TopicSampler default_sampler_;
+            std::map<std::string, TopicSampler *> topic_samplers_;
+            std::atomic<bool> is_running_;
+            std::thread log_thread_;
+            Logger(std::size_t capacity);
+            bool sample(TopicSampler& topic_sampler);
+            LogRecord * acquire_record(std::size_t& record_position);
+            void commit_record(LogRecord * log_record, std::size_t record_position);
+            bool drain();
+            void run();
+        public :
+            virtual ~Logger();
+            Logger(const Logger&) = delete;
+            Logger& operator=(const Logger&) = delete;
+            static Logger& instance();
+            bool is_enabled(LogLevel log_level) const;
+            bool is_payload_enabled() const;
+            bool should_sample(const std::string& log_topic);
+            void set_level(LogLevel log_level);
+            void set_payload_enabled(bool is_payload_enabled);
+            void set_default_sample_rate(uint32_t sample_rate);
+            void set_topic_sample_rate(const std::string& log_topic, uint32_t sample_rate);
+            void log(LogLevel log_level, const char * log_format, ...) __attribute__((format(printf, 3, 4)));
+            void log_payload(const std::string& log_topic, const std::string& log_payload);
+            uint64_t dropped_records() const;
+            void stop();
+    };
+}
+
+#endif
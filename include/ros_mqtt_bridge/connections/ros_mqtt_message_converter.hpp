@@ -74,6 +74,44 @@
 */
 #include "tf2_msgs/msg/tf_message.hpp"
 
+/**
+ * include ros_mqtt_message_encoder's header file
+ * @see ros_message_encoder::MessageEncoder
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_message_encoder.hpp"
+
+/**
+ * include ros_mqtt_json_reader's header file
+ * @see ros_json_reader::JsonReader
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_json_reader.hpp"
+
+/**
+ * include ros_mqtt_logger's header file
+ * @see ros_mqtt_logger::Logger
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_logger.hpp"
+
+/**
+ * include ros_mqtt_path_simplifier's header file
+ * @see ros_mqtt_path::PathSimplifier
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_path_simplifier.hpp"
+
+/**
+ * include ros_mqtt_path_delta's header file
+ * @see ros_mqtt_path::PathDelta
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_path_delta.hpp"
+
+/**
+ * include ros_mqtt_scan_reducer's header file
+ * @see ros_mqtt_scan::ScanReducer
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_scan_reducer.hpp"
+
+#define PATH_POSE_STRIDE 7
+
 /**
  * @brief namespace for declare Converter Classes for each message types
  * @author reidlo(naru5135@wavem.net)
@@ -81,44 +119,126 @@
 */
 namespace ros_message_converter {
     namespace ros_std_msgs {
-        class StdMessageConverter {                
+        /**
+         * @brief Class for fill std_msgs::msg::String from JSON events, data defaults to "nullstr" when key is missing
+         * @author reidlo(naru5135@wavem.net)
+         * @date 26.10.19
+        */
+        class ChatterJsonHandler : public ros_json_reader::JsonHandler {
+            private :
+                std_msgs::msg::String& std_string_message_;
+            public :
+                ChatterJsonHandler(std_msgs::msg::String& std_string_message);
+                virtual ~ChatterJsonHandler();
+                void on_begin_object(const ros_json_reader::JsonPath& json_path) override;
+                void on_begin_array(const ros_json_reader::JsonPath& json_path) override;
+                void on_null(const ros_json_reader::JsonPath& json_path) override;
+                void on_bool(const ros_json_reader::JsonPath& json_path, bool bool_value) override;
+                void on_number(const ros_json_reader::JsonPath& json_path, double number_value) override;
+                void on_string(const ros_json_reader::JsonPath& json_path, const char * string_value, std::size_t string_size) override;
+        };
+
+        class StdMessageConverter {
+            private :
+                ros_json_reader::JsonReader json_reader_;
+                bool is_parse_failed_;
             public :
                 StdMessageConverter();
                 virtual ~StdMessageConverter();
-                Json::Value convert_header_to_json(const std_msgs::msg::Header header_msgs);
+                bool is_parse_failed() const;
+                void convert_header(const std_msgs::msg::Header& header_msgs, ros_message_encoder::MessageEncoder& message_encoder);
                 std_msgs::msg::Header convert_json_to_header(Json::Value raw_header_data);
+                void convert_chatter(const std_msgs::msg::String& chatter_msgs, ros_message_encoder::MessageEncoder& message_encoder);
                 std::string convert_chatter_to_json(const std_msgs::msg::String::SharedPtr chatter_msgs_ptr);
                 std_msgs::msg::String convert_json_to_chatter(std::string& raw_std_string_data);
+                std_msgs::msg::String convert_json_to_chatter(const Json::Value& std_string_json);
         };
     }
     namespace ros_geometry_msgs {
+        /**
+         * @brief Class for fill geometry_msgs::msg::Twist from JSON events, missing fields stay 0
+         * @author reidlo(naru5135@wavem.net)
+         * @date 26.10.19
+         * @details top-level sent_ns(wall clock nanoseconds of sender) is stored into sent_ns, it stays 0 when absent
+        */
+        class TwistJsonHandler : public ros_json_reader::JsonHandler {
+            private :
+                geometry_msgs::msg::Twist& twist_message_;
+                int64_t& sent_ns_;
+                double * find_field(const ros_json_reader::JsonPath& json_path);
+            public :
+                TwistJsonHandler(geometry_msgs::msg::Twist& twist_message, int64_t& sent_ns);
+                virtual ~TwistJsonHandler();
+                void on_bool(const ros_json_reader::JsonPath& json_path, bool bool_value) override;
+                void on_number(const ros_json_reader::JsonPath& json_path, double number_value) override;
+        };
+
+        /**
+         * @brief Class for fill geometry_msgs::msg::PoseWithCovarianceStamped from JSON events
+         * @author reidlo(naru5135@wavem.net)
+         * @date 26.10.19
+         * @details header.frame_id defaults to "nullstr" when header is given, covariance is kept only when it is an array of 36 numbers
+        */
+        class PoseWithCovarianceStampedJsonHandler : public ros_json_reader::JsonHandler {
+            private :
+                geometry_msgs::msg::PoseWithCovarianceStamped& pose_with_covariance_stamped_message_;
+                std::array<double, 36UL> pose_covariance_array_;
+                bool is_pose_covariance_valid_;
+                double * find_field(const ros_json_reader::JsonPath& json_path);
+                bool is_pose_covariance_element(const ros_json_reader::JsonPath& json_path);
+            public :
+                PoseWithCovarianceStampedJsonHandler(geometry_msgs::msg::PoseWithCovarianceStamped& pose_with_covariance_stamped_message);
+                virtual ~PoseWithCovarianceStampedJsonHandler();
+                void on_begin_object(const ros_json_reader::JsonPath& json_path) override;
+                void on_begin_array(const ros_json_reader::JsonPath& json_path) override;
+                void on_end_array(const ros_json_reader::JsonPath& json_path, std::size_t array_size) override;
+                void on_null(const ros_json_reader::JsonPath& json_path) override;
+                void on_bool(const ros_json_reader::JsonPath& json_path, bool bool_value) override;
+                void on_number(const ros_json_reader::JsonPath& json_path, double number_value) override;
+                void on_string(const ros_json_reader::JsonPath& json_path, const char * string_value, std::size_t string_size) override;
+        };
+
         class GeometryMessageConverter {
             private :
                 ros_message_converter::ros_std_msgs::StdMessageConverter * std_message_converter_;
+                const bool is_converter_owned_;
+                ros_json_reader::JsonReader json_reader_;
+                bool is_parse_failed_;
+                int64_t sent_ns_;
             public :
                 GeometryMessageConverter();
+                explicit GeometryMessageConverter(ros_message_converter::ros_std_msgs::StdMessageConverter& std_message_converter);
                 virtual ~GeometryMessageConverter();
-                Json::Value convert_point_to_json(const geometry_msgs::msg::Point point_msgs);
-                Json::Value convert_quaternion_to_json(const geometry_msgs::msg::Quaternion quaternion_msgs);
+                bool is_parse_failed() const;
+                int64_t sent_ns() const;
+                void convert_point(const geometry_msgs::msg::Point& point_msgs, ros_message_encoder::MessageEncoder& message_encoder);
+                void convert_quaternion(const geometry_msgs::msg::Quaternion& quaternion_msgs, ros_message_encoder::MessageEncoder& message_encoder);
+                void convert_pose(const geometry_msgs::msg::Pose& pose_msgs, ros_message_encoder::MessageEncoder& message_encoder);
                 std::string convert_pose_to_json(const geometry_msgs::msg::Pose::SharedPtr pose_msgs_ptr);
-                Json::Value convert_pose_to_json(const geometry_msgs::msg::Pose pose_msgs);
-                Json::Value convert_vector_to_json(const geometry_msgs::msg::Vector3 vector_msgs);
+                void convert_vector(const geometry_msgs::msg::Vector3& vector_msgs, ros_message_encoder::MessageEncoder& message_encoder);
+                void convert_twist(const geometry_msgs::msg::Twist& twist_msgs, ros_message_encoder::MessageEncoder& message_encoder);
                 std::string convert_twist_to_json(const geometry_msgs::msg::Twist::SharedPtr twistmsgs_ptr);
                 geometry_msgs::msg::Vector3 convert_json_to_vector(Json::Value raw_vector_data);
                 geometry_msgs::msg::Twist convert_json_to_twist(std::string& raw_twist_data);
+                geometry_msgs::msg::Twist convert_json_to_twist(const Json::Value& twist_json);
                 geometry_msgs::msg::Point convert_json_to_point(Json::Value raw_point_data);
                 geometry_msgs::msg::Quaternion convert_json_to_quaternion(Json::Value raw_quaternion_data);
                 std::array<double, 36UL> convert_json_to_pose_covariance(Json::Value raw_pose_data);
                 geometry_msgs::msg::PoseWithCovarianceStamped convert_json_to_pose_with_covariance_stamped(std::string& raw_pose_with_covariance_stamped_data);
+                geometry_msgs::msg::PoseWithCovarianceStamped convert_json_to_pose_with_covariance_stamped(const Json::Value& pose_with_covariance_stamped_json);
         };
     }
     namespace ros_sensor_msgs {
         class SensorMessageConverter {
             private :
                 ros_message_converter::ros_std_msgs::StdMessageConverter * std_message_converter_;
+                const bool is_converter_owned_;
+                ros_mqtt_scan::ScanReducer scan_reducer_;
             public :
                 SensorMessageConverter();
+                explicit SensorMessageConverter(ros_message_converter::ros_std_msgs::StdMessageConverter& std_message_converter);
                 virtual ~SensorMessageConverter();
+                void convert_scan(const sensor_msgs::msg::LaserScan& scan_msgs, ros_message_encoder::MessageEncoder& message_encoder);
                 std::string convert_scan_to_json(const sensor_msgs::msg::LaserScan::SharedPtr scan_msgs_ptr);
         };
     }
@@ -127,12 +247,22 @@ namespace ros_message_converter {
             private :
                 ros_message_converter::ros_std_msgs::StdMessageConverter * std_message_converter_;
                 ros_message_converter::ros_geometry_msgs::GeometryMessageConverter * geometry_message_converter_;
+                const bool is_converter_owned_;
+                ros_mqtt_path::PathSimplifier path_simplifier_;
+                std::vector<ros_mqtt_path::PathPoint> path_points_;
+                std::vector<double> path_values_;
+                const std::vector<double>& simplify_path(const nav_msgs::msg::Path& path_msgs, const ros_message_encoder::OutputOptions& output_options);
             public:
                 NavMessageConverter();
+                NavMessageConverter(ros_message_converter::ros_std_msgs::StdMessageConverter& std_message_converter, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter& geometry_message_converter);
                 virtual ~NavMessageConverter();
+                void convert_odom(const nav_msgs::msg::Odometry& odom_msgs, ros_message_encoder::MessageEncoder& message_encoder);
                 std::string convert_odom_to_json(const nav_msgs::msg::Odometry::SharedPtr odom_msgs_ptr);
+                void convert_path(const nav_msgs::msg::Path& path_msgs, ros_message_encoder::MessageEncoder& message_encoder);
+                void convert_path_delta(const nav_msgs::msg::Path& path_msgs, ros_mqtt_path::PathDelta& path_delta, ros_message_encoder::MessageEncoder& message_encoder);
                 std::string convert_path_to_json(const nav_msgs::msg::Path::SharedPtr path_msgs_ptr);
-                Json::Value convert_meta_data_to_json(const nav_msgs::msg::MapMetaData map_meta_data_msgs);
+                void convert_meta_data(const nav_msgs::msg::MapMetaData& map_meta_data_msgs, ros_message_encoder::MessageEncoder& message_encoder);
+                void convert_map_response(const nav_msgs::srv::GetMap_Response& map_response_msgs, ros_message_encoder::MessageEncoder& message_encoder);
                 std::string convert_map_response_to_json(const nav_msgs::srv::GetMap_Response::SharedPtr map_response_msgs_ptr);
         };
     }
@@ -141,9 +271,14 @@ namespace ros_message_converter {
             private :
                 ros_message_converter::ros_std_msgs::StdMessageConverter * std_message_converter_;
                 ros_message_converter::ros_geometry_msgs::GeometryMessageConverter * geometry_message_converter_;
+                const bool is_converter_owned_;
             public :
                 Tf2MessageConverter();
+                Tf2MessageConverter(ros_message_converter::ros_std_msgs::StdMessageConverter& std_message_converter, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter& geometry_message_converter);
                 virtual ~Tf2MessageConverter();
+                void convert_tf(const tf2_msgs::msg::TFMessage& tf_msgs, ros_message_encoder::MessageEncoder& message_encoder);
+                void convert_transform_stamped(const geometry_msgs::msg::TransformStamped& transform_stamped_msgs, ros_message_encoder::MessageEncoder& message_encoder);
+                void convert_transforms(const tf2_msgs::msg::TFMessage& tf_msgs, ros_message_encoder::MessageEncoder& message_encoder);
                 std::string convert_tf_to_json(const tf2_msgs::msg::TFMessage::SharedPtr tf_msgs_ptr);
         };
     }
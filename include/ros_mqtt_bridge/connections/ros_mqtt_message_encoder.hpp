@@ -0,0 +1,251 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_MESSAGE_ENCODER
+#define ROS_MQTT_MESSAGE_ENCODER
+
+/**
+ * include cpp header files
+ * @see iostream
+ * @see string
+ * @see vector
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cinttypes>
+#include <jsoncpp/json/json.h>
+
+/**
+ * include ros_mqtt_buffer_pool's header file
+ * @see ros_mqtt_buffer_pool::BufferPool
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_buffer_pool.hpp"
+
+/**
+ * include ros_mqtt_number_format's header file
+ * @see ros_number_format::format_double
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_number_format.hpp"
+
+/**
+ * include ros_mqtt_path_simplifier's header file
+ * @see ros_mqtt_path::PathSimplification
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_path_simplifier.hpp"
+
+/**
+ * include ros_mqtt_scan_reducer's header file
+ * @see ros_mqtt_scan::ScanReduction
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_scan_reducer.hpp"
+
+#define LOG_ROS_MESSAGE_ENCODER "[RosMessageEncoder]"
+#define JSON_FLOAT_ARRAY_ELEMENT_SIZE 10
+#define JSON_DOUBLE_ARRAY_ELEMENT_SIZE 20
+#define JSON_SHORTEST_DECIMALS -1
+
+/**
+ * @brief namespace for declare pluggable payload encoders & decoders(JSON, MessagePack, CBOR)
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details every encoding carries the same logical schema, only the wire format differs
+*/
+namespace ros_message_encoder {
+    enum class Encoding : uint8_t {
+        JSON = 0,
+        MSGPACK = 1,
+        CBOR = 2
+    };
+
+    /**
+     * @brief Struct for per-topic output options which converters & encoders apply while writing a message
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details decimals rounds JSON numbers to fixed decimals, JSON_SHORTEST_DECIMALS keeps shortest round trip,
+     * binary encodings keep full float32 / float64 since rounding does not make them smaller.
+     * omitted fields are left out of the object instead of being written as 0, so consumers see the key missing.
+     * paths are simplified within path tolerance(meters) & cut down to path max poses, 0 keeps every pose.
+     * scans are cropped, pooled & clamped by scan reduction
+    */
+    struct OutputOptions {
+        int decimals;
+        bool is_zero_covariance_omitted;
+        bool is_time_increment_omitted;
+        bool is_scan_time_omitted;
+        bool is_intensities_omitted;
+        ros_mqtt_path::PathSimplification path_simplification;
+        double path_tolerance;
+        std::size_t path_max_poses;
+        ros_mqtt_scan::ScanReduction scan_reduction;
+    };
+
+    /**
+     * @brief Abstract Class for streaming encoder which ros_message_converter writes message fields into
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details object & array sizes are given up front since MessagePack & CBOR write them before their elements
+    */
+    class MessageEncoder {
+        protected :
+            std::string buffer_;
+            OutputOptions output_options_;
+        public :
+            MessageEncoder();
+            virtual ~MessageEncoder();
+            virtual Encoding encoding() const = 0;
+            virtual void begin_object(std::size_t object_size) = 0;
+            virtual void end_object() = 0;
+            virtual void begin_array(std::size_t array_size) = 0;
+            virtual void end_array() = 0;
+            virtual void write_key(const char * key) = 0;
+            virtual void write_null() = 0;
+            virtual void write_bool(bool bool_value) = 0;
+            virtual void write_int(int64_t int_value) = 0;
+            virtual void write_uint(uint64_t uint_value) = 0;
+            virtual void write_double(double double_value) = 0;
+            virtual void write_float(float float_value) = 0;
+            virtual void write_string(const std::string& string_value) = 0;
+            virtual void write_float_array(const float * float_values, std::size_t float_count);
+            virtual void write_double_array(const double * double_values, std::size_t double_count);
+            virtual void clear();
+            void set_output_options(const OutputOptions& output_options);
+            const OutputOptions& output_options() const;
+            std::string& buffer();
+            std::string release();
+    };
+
+    class JsonEncoder : public MessageEncoder {
+        private :
+            std::vector<bool> is_first_element_stack_;
+            std::vector<bool> is_array_stack_;
+            void write_separator();
+            void write_escaped(const char * raw_string, std::size_t raw_string_size);
+            std::size_t format_number(double double_value, char * number_buffer);
+            std::size_t format_number(float float_value, char * number_buffer);
+        public :
+            JsonEncoder();
+            virtual ~JsonEncoder();
+            Encoding encoding() const override;
+            void begin_object(std::size_t object_size) override;
+            void end_object() override;
+            void begin_array(std::size_t array_size) override;
+            void end_array() override;
+            void write_key(const char * key) override;
+            void write_null() override;
+            void write_bool(bool bool_value) override;
+            void write_int(int64_t int_value) override;
+            void write_uint(uint64_t uint_value) override;
+            void write_double(double double_value) override;
+            void write_float(float float_value) override;
+            void write_string(const std::string& string_value) override;
+            void write_float_array(const float * float_values, std::size_t float_count) override;
+            void write_double_array(const double * double_values, std::size_t double_count) override;
+            void clear() override;
+    };
+
+    class MessagePackEncoder : public MessageEncoder {
+        private :
+            void write_big_endian(uint64_t value, std::size_t value_size);
+            void write_string_header(std::size_t string_size);
+        public :
+            MessagePackEncoder();
+            virtual ~MessagePackEncoder();
+            Encoding encoding() const override;
+            void begin_object(std::size_t object_size) override;
+            void end_object() override;
+            void begin_array(std::size_t array_size) override;
+            void end_array() override;
+            void write_key(const char * key) override;
+            void write_null() override;
+            void write_bool(bool bool_value) override;
+            void write_int(int64_t int_value) override;
+            void write_uint(uint64_t uint_value) override;
+            void write_double(double double_value) override;
+            void write_float(float float_value) override;
+            void write_string(const std::string& string_value) override;
+    };
+
+    class CborEncoder : public MessageEncoder {
+        private :
+            void write_head(uint8_t major_type, uint64_t argument);
+        public :
+            CborEncoder();
+            virtual ~CborEncoder();
+            Encoding encoding() const override;
+            void begin_object(std::size_t object_size) override;
+            void end_object() override;
+            void begin_array(std::size_t array_size) override;
+            void end_array() override;
+            void write_key(const char * key) override;
+            void write_null() override;
+            void write_bool(bool bool_value) override;
+            void write_int(int64_t int_value) override;
+            void write_uint(uint64_t uint_value) override;
+            void write_double(double double_value) override;
+            void write_float(float float_value) override;
+            void write_string(const std::string& string_value) override;
+    };
+
+    /**
+     * @brief Abstract Class for decoder which turns mqtt payload back into Json::Value for ingress converters
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class MessageDecoder {
+        public :
+            MessageDecoder();
+            virtual ~MessageDecoder();
+            virtual Encoding encoding() const = 0;
+            virtual bool decode(const std::string& raw_payload, Json::Value& decoded_json) = 0;
+    };
+
+    class JsonDecoder : public MessageDecoder {
+        public :
+            JsonDecoder();
+            virtual ~JsonDecoder();
+            Encoding encoding() const override;
+            bool decode(const std::string& raw_payload, Json::Value& decoded_json) override;
+    };
+
+    class MessagePackDecoder : public MessageDecoder {
+        private :
+            bool decode_value(const uint8_t *& cursor, const uint8_t * end, Json::Value& decoded_json, int depth);
+        public :
+            MessagePackDecoder();
+            virtual ~MessagePackDecoder();
+            Encoding encoding() const override;
+            bool decode(const std::string& raw_payload, Json::Value& decoded_json) override;
+    };
+
+    class CborDecoder : public MessageDecoder {
+        private :
+            bool decode_value(const uint8_t *& cursor, const uint8_t * end, Json::Value& decoded_json, int depth);
+        public :
+            CborDecoder();
+            virtual ~CborDecoder();
+            Encoding encoding() const override;
+            bool decode(const std::string& raw_payload, Json::Value& decoded_json) override;
+    };
+
+    OutputOptions default_output_options();
+    bool is_zero_array(const double * double_values, std::size_t double_count);
+    MessageEncoder * create_encoder(Encoding encoding);
+    MessageDecoder * create_decoder(Encoding encoding);
+    bool read_object_header(Encoding encoding, const std::string& encoded_object, std::size_t& object_size, std::size_t& header_size);
+    bool merge_objects(Encoding encoding, std::string& encoded_object, const std::string& encoded_members);
+}
+
+#endif
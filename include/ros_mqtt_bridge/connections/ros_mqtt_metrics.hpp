@@ -0,0 +1,204 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_METRICS
+#define ROS_MQTT_METRICS
+
+/**
+ * include cpp header files
+ * @see atomic
+ * @see map
+ * @see vector
+ * @see functional
+*/
+#include <iostream>
+#include <string>
+#include <map>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+
+/**
+ * include rclcpp header files
+ * @see rclcpp/rclcpp.hpp
+*/
+#include "rclcpp/rclcpp.hpp"
+
+/**
+ * include diagnostic_msgs' header files
+ * @see diagnostic_msgs::msg::DiagnosticArray
+*/
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+
+#define LOG_ROS_MQTT_METRICS "[RosMqttMetrics]"
+#define METRICS_HISTOGRAM_SUB_BUCKET_BITS 4
+#define METRICS_HISTOGRAM_MAX_EXPONENT 40
+
+/**
+ * @brief namespace for declare per-topic counters, latency histograms & their diagnostics / Prometheus exporter
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details counters & histograms are lock-free atomics written from hot paths, the exporter only reads them
+*/
+namespace ros_mqtt_metrics {
+    enum class LatencyStage : uint8_t {
+        RECEIVE_TO_CONVERTED = 0,
+        CONVERTED_TO_ACCEPTED = 1,
+        ACCEPTED_TO_ACKED = 2,
+        RECEIVE_TO_ACKED = 3,
+        RECEIVE_TO_PUBLISHED = 4,
+        COUNT = 5
+    };
+
+    const char * stage_name(LatencyStage latency_stage);
+    std::string escape_label(const std::string& label_value);
+    std::string format_number(double value);
+
+    /**
+     * @brief Struct for steady clock time points of one message, default constructed points are unknown & skipped
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details source_stamp_ns is the ros header stamp of message (0 when message has no header),
+     * is_embedded is set once the trace block has been written into payload so later stages do not write it again,
+     * is_cached once payload went into last-value cache before compression, so compressed bytes are not cached over it
+    */
+    struct LatencyTrace {
+        std::chrono::steady_clock::time_point received;
+        std::chrono::steady_clock::time_point converted;
+        int64_t source_stamp_ns = 0;
+        bool is_embedded = false;
+        bool is_shared = false;
+        bool is_cached = false;
+    };
+
+    LatencyTrace start_trace();
+    int64_t stamp_nanoseconds(int32_t stamp_sec, uint32_t stamp_nanosec);
+    int64_t wall_nanoseconds(std::chrono::steady_clock::time_point steady_time);
+
+    enum class DeadlineSource : uint8_t {
+        RECEIVED = 0,
+        SOURCE_STAMP = 1
+    };
+
+    /**
+     * @brief Struct for max age of messages of one topic
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details RECEIVED measures age from the time bridge received message, SOURCE_STAMP from its ros header stamp against wall clock
+     * & falls back to RECEIVED for messages without header. max_age of 0 never expires
+    */
+    struct Deadline {
+        std::chrono::milliseconds max_age;
+        DeadlineSource source;
+    };
+
+    bool is_expired(const LatencyTrace& latency_trace, const Deadline& deadline, std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Class for HDR-style log-linear histogram of nanosecond latencies
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details every power of two is split into 2^METRICS_HISTOGRAM_SUB_BUCKET_BITS buckets, so relative error stays under ~6%.
+     * values beyond 2^METRICS_HISTOGRAM_MAX_EXPONENT ns are clamped into the last bucket.
+    */
+    class LatencyHistogram {
+        private :
+            static const std::size_t sub_bucket_count_ = 1U << METRICS_HISTOGRAM_SUB_BUCKET_BITS;
+            static const std::size_t bucket_count_ = (METRICS_HISTOGRAM_MAX_EXPONENT - METRICS_HISTOGRAM_SUB_BUCKET_BITS + 1) * sub_bucket_count_;
+            std::atomic<uint64_t> buckets_[bucket_count_];
+            std::atomic<uint64_t> count_;
+            std::atomic<uint64_t> sum_;
+            std::atomic<uint64_t> max_;
+            static std::size_t bucket_index(uint64_t value);
+            static uint64_t bucket_upper_bound(std::size_t index);
+        public :
+            LatencyHistogram();
+            virtual ~LatencyHistogram();
+            void record(uint64_t value);
+            void record(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to);
+            uint64_t count() const;
+            uint64_t sum() const;
+            uint64_t max() const;
+            uint64_t percentile(double quantile) const;
+    };
+
+    /**
+     * @brief Struct for counters & latency histograms of one topic
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct TopicMetrics {
+        std::string direction;
+        std::atomic<uint64_t> messages_in;
+        std::atomic<uint64_t> messages_out;
+        std::atomic<uint64_t> bytes_in;
+        std::atomic<uint64_t> bytes_out;
+        std::atomic<uint64_t> drops;
+        std::atomic<uint64_t> conversion_errors;
+        std::atomic<uint64_t> stale_drops;
+        LatencyHistogram latencies[static_cast<std::size_t>(LatencyStage::COUNT)];
+        TopicMetrics(const std::string& metrics_direction);
+        LatencyHistogram& latency(LatencyStage latency_stage);
+    };
+
+    /**
+     * @brief Class for own per-topic metrics & queue depth gauges of one executable
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details topics & gauges must be registered before other threads start recording, find() reads the map without locks
+    */
+    class MetricsRegistry {
+        private :
+            std::map<std::string, TopicMetrics *, std::less<>> topic_metrics_;
+            std::vector<std::pair<std::string, std::function<double()>>> gauges_;
+            void append_counter(std::string& prometheus_text, const std::string& metric_name, const char * metric_help, std::atomic<uint64_t> TopicMetrics::* counter) const;
+        public :
+            MetricsRegistry();
+            virtual ~MetricsRegistry();
+            TopicMetrics * register_topic(const std::string& topic, const std::string& direction);
+            void register_gauge(const std::string& gauge_name, std::function<double()> gauge_function);
+            TopicMetrics * find(const std::string& topic) const;
+            TopicMetrics * find(const char * topic) const;
+            const std::map<std::string, TopicMetrics *, std::less<>>& topics() const;
+            const std::vector<std::pair<std::string, std::function<double()>>>& gauges() const;
+            std::string to_prometheus(const std::string& metrics_prefix) const;
+            bool write_prometheus_file(const std::string& metrics_prefix, const std::string& prometheus_file_path) const;
+    };
+
+    /**
+     * @brief Class for periodically publish MetricsRegistry on diagnostics topic & into Prometheus text file
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details Prometheus file is written into a temporary file & renamed, so node_exporter's textfile collector never reads a partial file
+    */
+    class MetricsExporter {
+        private :
+            std::shared_ptr<rclcpp::Node> ros_node_ptr_;
+            const MetricsRegistry& metrics_registry_;
+            const std::string metrics_prefix_;
+            const std::string prometheus_file_path_;
+            rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr ros_diagnostics_publisher_ptr_;
+            rclcpp::TimerBase::SharedPtr metrics_timer_ptr_;
+            std::map<std::string, uint64_t> last_faults_;
+            diagnostic_msgs::msg::DiagnosticArray build_diagnostics();
+        public :
+            MetricsExporter(std::shared_ptr<rclcpp::Node> ros_node_ptr, const MetricsRegistry& metrics_registry, const std::string& metrics_prefix, const std::string& diagnostics_topic, const std::string& prometheus_file_path, std::chrono::milliseconds publish_period);
+            virtual ~MetricsExporter();
+            void export_metrics();
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_NUMBER_FORMAT
+#define ROS_MQTT_NUMBER_FORMAT
+
+/**
+ * include cpp header files
+ * @see cstdint
+ * @see cstddef
+*/
+#include <cstdint>
+#include <cstddef>
+
+#define NUMBER_FORMAT_BUFFER_SIZE 32
+#define NUMBER_FORMAT_MAX_FIXED_DECIMALS 15
+
+/**
+ * @brief namespace for declare number formatting engine of JSON payloads
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details shortest formatting finds the shortest decimal which reads back into the same double or float(Schubfach algorithm,
+ * R. Giulietti, "The Schubfach way to render doubles"), so a float32 scan range 0.1f is written as 0.1 instead of 0.10000000149011612.
+ * fixed formatting rounds to a number of decimals & drops trailing zeros.
+ * every function writes at most NUMBER_FORMAT_BUFFER_SIZE characters without terminating '\0' & returns how many it wrote,
+ * values must be finite, non-finite values are left to the caller since JSON has no literal for them
+*/
+namespace ros_number_format {
+    /**
+     * @brief Struct for decimal number significand * 10^exponent, significand has no trailing zeros unless it is 0
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct DecimalNumber {
+        uint64_t significand;
+        int32_t exponent;
+    };
+
+    DecimalNumber to_shortest_decimal(double double_value);
+    DecimalNumber to_shortest_decimal(float float_value);
+    std::size_t format_decimal(bool is_negative, const DecimalNumber& decimal_number, char * output);
+    std::size_t format_double(double double_value, char * output);
+    std::size_t format_float(float float_value, char * output);
+    std::size_t format_fixed(double double_value, int decimals, char * output);
+    void multiply_64(uint64_t multiplicand, uint64_t multiplier, uint64_t& product_high, uint64_t& product_low);
+    uint64_t round_to_odd_64(uint64_t pow10_high, uint64_t pow10_low, uint64_t scaled_bound);
+    uint32_t round_to_odd_32(uint64_t pow10, uint32_t scaled_bound);
+    int32_t floor_shift(int32_t value, int shift);
+    void pow10_significand_128(int32_t exponent, uint64_t& significand_high, uint64_t& significand_low);
+    uint64_t pow10_significand_64(int32_t exponent);
+}
+
+#endif
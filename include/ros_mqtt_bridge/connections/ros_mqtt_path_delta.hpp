@@ -0,0 +1,81 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_PATH_DELTA
+#define ROS_MQTT_PATH_DELTA
+
+/**
+ * include cpp header files
+ * @see string
+ * @see vector
+*/
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief namespace for declare delta encoding of consecutive paths of a topic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+namespace ros_mqtt_path {
+    /**
+     * @brief Struct for difference of a path to the path published before it, counted in poses
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details applying it to the previous poses removes deleted_count poses at start & inserts inserted_count poses of the new path from start,
+     * a keyframe carries every pose(start 0, inserted_count is pose count)
+    */
+    struct PathSplice {
+        bool is_keyframe;
+        uint64_t sequence;
+        std::size_t start;
+        std::size_t deleted_count;
+        std::size_t inserted_count;
+    };
+
+    /**
+     * @brief Class for keep last published poses of one topic & compute splice of next poses against them
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details the splice is the range between common prefix & common suffix of both pose arrays, poses are compared bitwise.
+     * a keyframe is sent first, every keyframe_interval messages, when frame changes or when splice would not be smaller than half of the path,
+     * so receivers which missed a message or joined late recover within keyframe_interval messages.
+     * not thread safe except request_keyframe(), which other threads call when a message of the topic was lost, one per topic
+    */
+    class PathDelta {
+        private :
+            const std::size_t keyframe_interval_;
+            const std::size_t pose_stride_;
+            std::vector<double> last_values_;
+            std::string last_frame_id_;
+            uint64_t sequence_;
+            std::size_t deltas_since_keyframe_;
+            std::atomic<bool> is_keyframe_requested_;
+            uint64_t keyframe_count_;
+            uint64_t delta_count_;
+            bool is_pose_equal(const double * first_pose, const double * second_pose) const;
+        public :
+            PathDelta(std::size_t keyframe_interval, std::size_t pose_stride);
+            virtual ~PathDelta();
+            PathSplice next(const std::string& frame_id, const std::vector<double>& pose_values);
+            void request_keyframe();
+            uint64_t keyframe_count() const;
+            uint64_t delta_count() const;
+    };
+}
+
+#endif
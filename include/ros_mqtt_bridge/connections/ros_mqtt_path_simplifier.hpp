@@ -0,0 +1,95 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_PATH_SIMPLIFIER
+#define ROS_MQTT_PATH_SIMPLIFIER
+
+/**
+ * include cpp header files
+ * @see vector
+ * @see utility
+*/
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief namespace for declare simplification of paths(e.g. global & local plans) before they are published
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details simplifiers return indices of kept points, first & last point of a path are always kept.
+ * Douglas-Peucker keeps points farther than tolerance from the simplified line,
+ * Visvalingam-Whyatt removes points whose triangle with their neighbours is smaller than tolerance squared
+*/
+namespace ros_mqtt_path {
+    enum class PathSimplification : uint8_t {
+        NONE = 0,
+        DOUGLAS_PEUCKER = 1,
+        VISVALINGAM = 2
+    };
+
+    /**
+     * @brief Struct for position of a path point
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct PathPoint {
+        double x;
+        double y;
+        double z;
+    };
+
+    /**
+     * @brief Struct for effective area of a point in Visvalingam-Whyatt heap
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details entries are not removed when area of their point changes, entries whose area differs from current one are skipped
+    */
+    struct AreaEntry {
+        double area;
+        std::size_t index;
+    };
+
+    /**
+     * @brief Class for simplify paths with scratch buffers which are kept between messages
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details not thread safe, one simplifier per converter
+    */
+    class PathSimplifier {
+        private :
+            std::vector<std::size_t> kept_indices_;
+            std::vector<bool> is_kept_;
+            std::vector<std::pair<std::size_t, std::size_t>> segment_stack_;
+            std::vector<std::size_t> previous_indices_;
+            std::vector<std::size_t> next_indices_;
+            std::vector<double> areas_;
+            std::vector<AreaEntry> area_heap_;
+            void simplify_douglas_peucker(const std::vector<PathPoint>& path_points, double tolerance);
+            void simplify_visvalingam(const std::vector<PathPoint>& path_points, double tolerance, std::size_t max_points);
+            void update_area(const std::vector<PathPoint>& path_points, std::size_t index, double removed_area);
+            void limit_points(std::size_t max_points);
+        public :
+            PathSimplifier();
+            virtual ~PathSimplifier();
+            const std::vector<std::size_t>& simplify(const std::vector<PathPoint>& path_points, PathSimplification path_simplification, double tolerance, std::size_t max_points);
+    };
+
+    bool is_larger_area(const AreaEntry& first_entry, const AreaEntry& second_entry);
+    double segment_distance(const PathPoint& point, const PathPoint& segment_begin, const PathPoint& segment_end);
+    double triangle_area(const PathPoint& first_point, const PathPoint& second_point, const PathPoint& third_point);
+}
+
+#endif
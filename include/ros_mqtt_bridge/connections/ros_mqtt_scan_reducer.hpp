@@ -0,0 +1,87 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_SCAN_REDUCER
+#define ROS_MQTT_SCAN_REDUCER
+
+/**
+ * include cpp header files
+ * @see vector
+*/
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief namespace for declare reduction of laser scans(angular crop, min-pool decimation & range clamp) before they are published
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+namespace ros_mqtt_scan {
+    /**
+     * @brief Struct for reduction of a scan stream, the default(all 0 & false) keeps scans as they are
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details crop keeps beams whose angle lies in [crop_angle_min, crop_angle_max] radians, also when the window is given 2 pi apart of the scan angles.
+     * a window across the seam of the scan(angle_max to angle_min) keeps its larger part only.
+     * beam_count pools the cropped beams down to beam_count beams, range_clamp writes ranges beyond it & no returns(nan, +-inf) as range_clamp
+    */
+    struct ScanReduction {
+        std::size_t beam_count;
+        bool is_cropped;
+        float crop_angle_min;
+        float crop_angle_max;
+        float range_clamp;
+    };
+
+    /**
+     * @brief Struct for fields of a laser scan which reduction changes, ranges & intensities are not owned
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct ScanView {
+        float angle_min;
+        float angle_max;
+        float angle_increment;
+        float time_increment;
+        float range_min;
+        float range_max;
+        const float * ranges;
+        std::size_t range_count;
+        const float * intensities;
+        std::size_t intensity_count;
+    };
+
+    /**
+     * @brief Class for reduce scans into scratch buffers which are kept between messages
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details a pooled beam is the nearest valid range of its group(within range_min & range_max), so the nearest obstacle of a group is never lost,
+     * & carries the intensity of that beam. groups without valid range keep the range of their first beam(e.g. inf for no return).
+     * not thread safe, one reducer per converter
+    */
+    class ScanReducer {
+        private :
+            std::vector<float> ranges_;
+            std::vector<float> intensities_;
+        public :
+            ScanReducer();
+            virtual ~ScanReducer();
+            ScanView reduce(const ScanView& scan_view, const ScanReduction& scan_reduction);
+    };
+
+    bool is_reduced(const ScanReduction& scan_reduction);
+    bool is_valid_range(float range, float range_min, float range_max);
+}
+
+#endif
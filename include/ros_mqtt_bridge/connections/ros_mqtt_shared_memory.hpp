@@ -0,0 +1,150 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_SHARED_MEMORY
+#define ROS_MQTT_SHARED_MEMORY
+
+/**
+ * include cpp header files
+ * @see string
+ * @see atomic
+ * @see mutex
+*/
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+/**
+ * include posix shared memory header files
+ * @see sys/mman.h
+ * @see fcntl.h
+*/
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define LOG_ROS_MQTT_SHARED_MEMORY "[RosMqttSharedMemory]"
+#define SHM_RING_MAGIC 0x524d5348
+#define SHM_RING_VERSION 1
+
+/**
+ * @brief namespace for declare per-topic shared memory rings, a local egress sink next to mqtt publishing
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details one ring per topic at /dev/shm/<prefix>.<topic with '/' as '.'>, the bridge is its only writer.
+ * layout : RingHeader, then slot_count slots of slot_size bytes(64 byte aligned), each a SlotHeader followed by the payload.
+ * message of sequence n(from 1) is in slot (n - 1) % slot_count, slot sequence is 0 while it is being written.
+ * readers check slot sequence before & after they used the payload in place(seqlock), so they never copy
+*/
+namespace ros_mqtt_shm {
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared memory rings need lock-free 64 bit atomics");
+
+    /**
+     * @brief Struct for header at the start of shared memory ring
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct RingHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t slot_count;
+        uint64_t slot_size;
+        std::atomic<uint64_t> write_sequence;
+        std::atomic<uint64_t> oversized_drops;
+    };
+
+    /**
+     * @brief Struct for header of one slot, payload follows it
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details encoding is ros_message_encoder::Encoding of payload, publish_ns is wall clock nanoseconds of write
+    */
+    struct SlotHeader {
+        std::atomic<uint64_t> sequence;
+        int64_t publish_ns;
+        uint32_t payload_size;
+        uint8_t encoding;
+        uint8_t reserved[3];
+    };
+
+    enum class ReadStatus : uint8_t {
+        READ = 0,
+        NOT_YET_WRITTEN = 1,
+        OVERWRITTEN = 2
+    };
+
+    /**
+     * @brief Struct for payload read in place from ring, valid while is_intact returns true
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct SharedPayload {
+        uint64_t sequence;
+        int64_t publish_ns;
+        uint8_t encoding;
+        const char * data;
+        std::size_t size;
+    };
+
+    /**
+     * @brief Class for create & write shared memory ring of one topic, unlinks it on destruction
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details writes of one ring are serialized by a mutex, it is uncontended since a topic is published from one thread
+    */
+    class SharedMemoryRing {
+        private :
+            const std::string shm_name_;
+            std::size_t mapped_size_;
+            char * mapped_ptr_;
+            RingHeader * ring_header_ptr_;
+            std::mutex write_mutex_;
+        public :
+            SharedMemoryRing(const std::string& shm_name, std::size_t slot_count, std::size_t slot_size);
+            virtual ~SharedMemoryRing();
+            bool is_open() const;
+            std::size_t payload_capacity() const;
+            bool write(const std::string& payload, uint8_t encoding, int64_t publish_ns);
+            uint64_t write_sequence() const;
+            uint64_t oversized_drops() const;
+    };
+
+    /**
+     * @brief Class for map shared memory ring read-only & read its payloads in place
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class SharedMemoryReader {
+        private :
+            std::size_t mapped_size_;
+            const char * mapped_ptr_;
+            const RingHeader * ring_header_ptr_;
+            const SlotHeader * slot_header(uint64_t sequence) const;
+        public :
+            explicit SharedMemoryReader(const std::string& shm_name);
+            virtual ~SharedMemoryReader();
+            bool is_open() const;
+            uint64_t latest_sequence() const;
+            ReadStatus read(uint64_t sequence, SharedPayload& shared_payload) const;
+            bool is_intact(const SharedPayload& shared_payload) const;
+    };
+
+    std::string shm_name_of(const std::string& shm_prefix, const std::string& mqtt_topic);
+    std::size_t align_to_cache_line(std::size_t size);
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_TF_AGGREGATOR
+#define ROS_MQTT_TF_AGGREGATOR
+
+/**
+ * include cpp header files
+ * @see string
+ * @see vector
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * include tf2 header files
+ * @see tf2::BufferCore
+*/
+#include "tf2/buffer_core.h"
+#include "tf2/exceptions.h"
+#include "tf2/time.h"
+
+/**
+ * include tf2_msgs' header files
+ * @see tf2_msgs::msg::TFMessage
+*/
+#include "tf2_msgs/msg/tf_message.hpp"
+
+#define LOG_ROS_MQTT_TF_AGGREGATOR "[RosMqttTfAggregator]"
+#define TF_AGGREGATOR_AUTHORITY "ros_mqtt_bridge"
+
+/**
+ * @brief namespace for declare tf tree aggregation which composes configured frame pairs out of /tf & /tf_static
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @see ros_mqtt_connections::manager::Bridge
+*/
+namespace ros_mqtt_tf {
+    /**
+     * @brief Struct for one composed transform, source frame expressed in target frame(e.g. map -> base_link)
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct FramePair {
+        std::string target_frame;
+        std::string source_frame;
+    };
+
+    /**
+     * @brief Class for keep tf tree in tf2::BufferCore & look up latest composed transform of each frame pair
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details only frame pairs leave the bridge, so its bandwidth does not grow with frames the robot publishes.
+     * a pair is reported as updated when its composed stamp moved since the last lookup, pairs which can not be composed yet are skipped
+    */
+    class FramePairAggregator {
+        private :
+            tf2::BufferCore tf_buffer_core_;
+            const std::vector<FramePair> frame_pairs_;
+            std::vector<int64_t> looked_up_stamps_;
+            uint64_t rejected_count_;
+        public :
+            FramePairAggregator(const std::vector<FramePair>& frame_pairs, tf2::Duration cache_time);
+            virtual ~FramePairAggregator();
+            void add_transforms(const tf2_msgs::msg::TFMessage& tf_msgs, bool is_static);
+            std::size_t lookup_transforms(tf2_msgs::msg::TFMessage& composed_tf_msgs);
+            std::size_t frame_pair_count() const;
+            uint64_t rejected_count() const;
+    };
+}
+
+#endif
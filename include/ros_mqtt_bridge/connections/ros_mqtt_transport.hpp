@@ -0,0 +1,186 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_TRANSPORT
+#define ROS_MQTT_TRANSPORT
+
+/**
+ * include cpp header files
+ * @see string
+ * @see vector
+ * @see set
+ * @see map
+ * @see atomic
+ * @see thread
+ * @see mutex
+ * @see functional
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+#include "mqtt/async_client.h"
+
+#define LOG_ROS_MQTT_TRANSPORT "[RosMqttTransport]"
+#define MQTT_TRANSPORT_SUCCESS 0
+#define MQTT_TRANSPORT_NOT_CONNECTED -1
+#define MQTT_TRANSPORT_EXCEPTION -2
+#define MQTT_TRANSPORT_QUEUE_FULL -3
+#define MQTT_LOOPBACK_CAPACITY 4096
+#define MQTT_TRANSPORT_CONNECT_POLL_MS 50
+
+/**
+ * @brief namespace for declare mqtt transports the bridge publishes & subscribes through
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details PAHO talks to a broker, LOOPBACK delivers published messages back to its own subscriptions in-process,
+ * which measures conversion & dispatch of the bridge without network & broker
+*/
+namespace ros_mqtt_transport {
+    enum class TransportKind : uint8_t {
+        PAHO = 0,
+        LOOPBACK = 1
+    };
+
+    /**
+     * @brief Struct for result of one blocking publish
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details accepted is when the transport took the message, acked is when its delivery completed
+    */
+    struct PublishResult {
+        int return_code;
+        std::chrono::steady_clock::time_point accepted;
+        std::chrono::steady_clock::time_point acked;
+    };
+
+    /**
+     * @brief Class for receive events of transport, called on the transport's own thread
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class TransportCallback {
+        public :
+            virtual ~TransportCallback();
+            virtual void connection_lost(const std::string& connection_lost_cause) = 0;
+            virtual void message_arrived(const std::string& mqtt_topic, const std::string& mqtt_payload) = 0;
+            virtual void delivery_complete(int message_id) = 0;
+    };
+
+    /**
+     * @brief Class for publish, subscribe & connect of mqtt messages, errors are return codes instead of exceptions
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    class Transport {
+        public :
+            virtual ~Transport();
+            virtual void set_callback(TransportCallback& transport_callback) = 0;
+            virtual bool connect(std::chrono::seconds connect_timeout, std::function<bool()> cancel_function) = 0;
+            virtual bool is_connected() const = 0;
+            virtual void disconnect() = 0;
+            virtual int subscribe(const std::string& mqtt_topic, int mqtt_qos) = 0;
+            virtual PublishResult publish(const std::string& mqtt_topic, const std::string& mqtt_payload, int mqtt_qos, bool is_retained) = 0;
+            virtual std::size_t pending_count() = 0;
+    };
+
+    /**
+     * @brief Class for transport over paho mqtt::async_client
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @see mqtt::async_client
+    */
+    class PahoTransport : public Transport, public virtual mqtt::callback {
+        private :
+            mqtt::async_client mqtt_async_client_;
+            TransportCallback * transport_callback_ptr_;
+            void connection_lost(const std::string& mqtt_connection_lost_cause) override;
+            void message_arrived(mqtt::const_message_ptr mqtt_message) override;
+            void delivery_complete(mqtt::delivery_token_ptr mqtt_delivered_token) override;
+        public :
+            PahoTransport(const std::string& mqtt_address, const std::string& mqtt_client_id);
+            virtual ~PahoTransport();
+            void set_callback(TransportCallback& transport_callback) override;
+            bool connect(std::chrono::seconds connect_timeout, std::function<bool()> cancel_function) override;
+            bool is_connected() const override;
+            void disconnect() override;
+            int subscribe(const std::string& mqtt_topic, int mqtt_qos) override;
+            PublishResult publish(const std::string& mqtt_topic, const std::string& mqtt_payload, int mqtt_qos, bool is_retained) override;
+            std::size_t pending_count() override;
+    };
+
+    /**
+     * @brief Class for in-process transport which delivers published messages to its own matching subscriptions
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details publishers enqueue into a bounded lock-free ring(sequence number per slot), one delivery thread dequeues & calls back.
+     * publish spins while the ring is full, so no message is lost & publishers are paced by delivery.
+     * slots keep capacity of their strings, so steady state publishing does not allocate.
+     * subscriptions are copy-on-write snapshots, only subscribe & retained publish take a mutex.
+     * retained messages are kept per topic & delivered again to every later matching subscription like a broker does.
+     * paddings keep producer & consumer positions on their own cache lines
+    */
+    class LoopbackTransport : public Transport {
+        private :
+            struct LoopbackSlot {
+                std::atomic<std::size_t> sequence;
+                std::string mqtt_topic;
+                std::string mqtt_payload;
+            };
+            const std::size_t capacity_mask_;
+            LoopbackSlot * loopback_slots_;
+            char producer_padding_[64];
+            std::atomic<std::size_t> enqueue_position_;
+            char consumer_padding_[64];
+            std::size_t dequeue_position_;
+            char counter_padding_[64];
+            std::atomic<uint64_t> published_count_;
+            std::atomic<uint64_t> delivered_count_;
+            std::atomic<const std::set<std::string> *> subscriptions_ptr_;
+            std::vector<const std::set<std::string> *> retired_subscriptions_ptrs_;
+            std::map<std::string, std::string> retained_messages_;
+            std::mutex subscription_mutex_;
+            std::atomic<TransportCallback *> transport_callback_ptr_;
+            std::atomic<bool> is_running_;
+            std::thread delivery_thread_;
+            void run();
+            bool is_subscribed(const std::string& mqtt_topic) const;
+        public :
+            explicit LoopbackTransport(std::size_t capacity = MQTT_LOOPBACK_CAPACITY);
+            virtual ~LoopbackTransport();
+            void set_callback(TransportCallback& transport_callback) override;
+            bool connect(std::chrono::seconds connect_timeout, std::function<bool()> cancel_function) override;
+            bool is_connected() const override;
+            void disconnect() override;
+            int subscribe(const std::string& mqtt_topic, int mqtt_qos) override;
+            PublishResult publish(const std::string& mqtt_topic, const std::string& mqtt_payload, int mqtt_qos, bool is_retained) override;
+            std::size_t pending_count() override;
+            uint64_t published_count() const;
+            uint64_t delivered_count() const;
+    };
+
+    std::size_t round_up_power_of_two(std::size_t value);
+    bool topic_matches(const std::string& topic_filter, const std::string& mqtt_topic);
+    Transport * create_transport(TransportKind transport_kind, const std::string& mqtt_address, const std::string& mqtt_client_id);
+}
+
+#endif
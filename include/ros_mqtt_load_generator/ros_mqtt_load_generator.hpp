@@ -0,0 +1,180 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROS_MQTT_LOAD_GENERATOR
+#define ROS_MQTT_LOAD_GENERATOR
+
+/**
+ * include cpp header files
+ * @see atomic
+ * @see map
+ * @see vector
+*/
+#include <iostream>
+#include <string>
+#include <map>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <jsoncpp/json/json.h>
+
+#include "mqtt/async_client.h"
+
+/**
+ * include rclcpp header files
+ * @see rclcpp/rclcpp.hpp
+*/
+#include "rclcpp/rclcpp.hpp"
+
+/**
+ * include ros message header files
+ * @see std_msgs::msg::String
+ * @see sensor_msgs::msg::LaserScan
+ * @see nav_msgs::msg::Odometry
+ * @see tf2_msgs::msg::TFMessage
+*/
+#include "std_msgs/msg/string.hpp"
+#include "sensor_msgs/msg/laser_scan.hpp"
+#include "nav_msgs/msg/odometry.hpp"
+#include "tf2_msgs/msg/tf_message.hpp"
+
+/**
+ * include ros_mqtt_bridge's header files
+ * @see ros_mqtt_metrics::LatencyHistogram
+ * @see ros_message_encoder::MessageDecoder
+ * @see ros_mqtt_compression::decompress
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_metrics.hpp"
+#include "ros_mqtt_bridge/connections/ros_mqtt_message_encoder.hpp"
+#include "ros_mqtt_bridge/connections/ros_mqtt_compressor.hpp"
+
+#define LOG_ROS_MQTT_LOAD_GENERATOR "[RosMqttLoadGenerator]"
+#define LOAD_MQTT_ADDRESS "tcp://localhost:1883"
+#define LOAD_MQTT_CLIENT_ID "ros_mqtt_load_generator"
+#define LOAD_MQTT_QOS 0
+#define LOAD_SCAN_RATE_HZ 10.0
+#define LOAD_SCAN_BEAMS 1440
+#define LOAD_TF_RATE_HZ 50.0
+#define LOAD_TF_TRANSFORMS 10
+#define LOAD_ODOM_RATE_HZ 50.0
+#define LOAD_ECHO_RATE_HZ 10.0
+#define LOAD_WARMUP_SEC 3
+#define LOAD_DURATION_SEC 30
+#define LOAD_DRAIN_MS 2000
+#define LOAD_REPORT_FILE "/tmp/ros_mqtt_load_report.json"
+
+/**
+ * @brief namespace for declare end-to-end load generator of ros_connection_bridge & ros_mqtt_bridge
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details synthetic messages are stamped with wall clock at publish, so the receiving side measures latency of the whole path
+ * & counts only messages which were sent inside of the measurement window
+*/
+namespace ros_mqtt_load {
+    /**
+     * @brief Struct for counters & latency histogram of one measured path
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+    */
+    struct LoadPath {
+        const std::string origin;
+        const std::string destination;
+        const double rate_hz;
+        std::atomic<uint64_t> sent;
+        std::atomic<uint64_t> received;
+        ros_mqtt_metrics::LatencyHistogram latency;
+        LoadPath(const std::string& path_origin, const std::string& path_destination, double path_rate_hz);
+    };
+
+    /**
+     * @brief Class for publish synthetic scan/tf/odom into ros & echo requests into mqtt, then receive them on the other side
+     * @author reidlo(naru5135@wavem.net)
+     * @date 26.10.19
+     * @details paths
+     * - scan, tf, odom : origin ros topic -> ros_connection_bridge -> connection_bridge topics -> ros_mqtt_bridge -> mqtt topic
+     * - echo_ingress : mqtt /echo/request -> ros_mqtt_bridge -> ros mqtt_bridge/echo
+     * - echo_round_trip : mqtt /echo/request -> ros -> mqtt /echo/response, needs ros_mqtt_bridge built with MQTT_ECHO_ENABLED
+    */
+    class LoadGenerator : public rclcpp::Node, public virtual mqtt::callback {
+        private :
+            mqtt::async_client mqtt_async_client_;
+            ros_message_encoder::MessageDecoder * mqtt_decoder_ptr_;
+            std::map<std::string, LoadPath *> load_paths_;
+            std::map<std::string, std::string> mqtt_topic_paths_;
+            rclcpp::Publisher<sensor_msgs::msg::LaserScan>::SharedPtr ros_scan_publisher_ptr_;
+            rclcpp::Publisher<tf2_msgs::msg::TFMessage>::SharedPtr ros_tf_publisher_ptr_;
+            rclcpp::Publisher<nav_msgs::msg::Odometry>::SharedPtr ros_odom_publisher_ptr_;
+            rclcpp::Subscription<std_msgs::msg::String>::SharedPtr ros_echo_subscription_ptr_;
+            std::vector<rclcpp::TimerBase::SharedPtr> load_timer_ptrs_;
+            rclcpp::TimerBase::SharedPtr finish_timer_ptr_;
+            sensor_msgs::msg::LaserScan scan_message_;
+            tf2_msgs::msg::TFMessage tf_message_;
+            nav_msgs::msg::Odometry odom_message_;
+            std::atomic<int64_t> window_start_ns_;
+            std::atomic<int64_t> window_end_ns_;
+            std::atomic<uint64_t> undecodable_payloads_;
+            std::string report_file_;
+            int mqtt_qos_;
+            bool is_finished_;
+            void initialize_messages(int64_t scan_beams, int64_t tf_transforms);
+            void initialize_paths(double scan_rate_hz, double tf_rate_hz, double odom_rate_hz, double echo_rate_hz);
+            void mqtt_connect();
+            void start_load(double scan_rate_hz, double tf_rate_hz, double odom_rate_hz, double echo_rate_hz);
+            void add_load_timer(double rate_hz, std::function<void()> load_function);
+            bool is_in_window(int64_t sent_ns) const;
+            void count_sent(const std::string& path_name, int64_t sent_ns);
+            void count_received(const std::string& path_name, int64_t sent_ns, int64_t received_ns);
+            void publish_scan();
+            void publish_tf();
+            void publish_odom();
+            void publish_echo_request();
+            void receive_payload(const std::string& path_name, const Json::Value& payload_json, int64_t received_ns);
+            void connection_lost(const std::string& mqtt_connection_lost_cause) override;
+            void message_arrived(mqtt::const_message_ptr mqtt_message) override;
+            void finish();
+            std::string build_report(int64_t window_ns);
+        public :
+            LoadGenerator();
+            virtual ~LoadGenerator();
+    };
+
+    int64_t wall_now_ns();
+    int64_t header_stamp_ns(const Json::Value& header_json);
+}
+
+/**
+ * @brief namespace for declare topics of load paths, they follow ros_connection_bridge & ros_mqtt_bridge topics
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+namespace load_topics {
+    namespace ros {
+        const char * scan = "/scan";
+        const char * tf = "/tf";
+        const char * odom = "/odom";
+        const char * echo = "mqtt_bridge/echo";
+    }
+    namespace broker {
+        const char * scan = "/scan";
+        const char * tf = "/tf";
+        const char * odom = "/odom";
+        const char * batch = "/batch";
+        const char * echo_request = "/echo/request";
+        const char * echo_response = "/echo/response";
+    }
+}
+
+#endif
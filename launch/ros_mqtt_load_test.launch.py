@@ -0,0 +1,73 @@
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument, ExecuteProcess, RegisterEventHandler, Shutdown
+from launch.conditions import IfCondition
+from launch.event_handlers import OnProcessExit
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import Node
+
+def generate_launch_description():
+
+    load_arguments = {
+        'mqtt_address': 'tcp://localhost:1883',
+        'mqtt_encoding': '0',
+        'scan_rate_hz': '10.0',
+        'scan_beams': '1440',
+        'tf_rate_hz': '50.0',
+        'tf_transforms': '10',
+        'odom_rate_hz': '50.0',
+        'echo_rate_hz': '10.0',
+        'warmup_sec': '3',
+        'duration_sec': '30',
+        'drain_ms': '2000',
+        'report_file': '/tmp/ros_mqtt_load_report.json'
+    }
+
+    load_generator = Node(
+        package = 'rclcpp_mqtt_bridge',
+        name = 'ros_mqtt_load_generator',
+        executable = 'ros_mqtt_load_generator',
+        output = 'screen',
+        parameters = [{
+            'mqtt_address': LaunchConfiguration('mqtt_address'),
+            'mqtt_encoding': LaunchConfiguration('mqtt_encoding'),
+            'scan_rate_hz': LaunchConfiguration('scan_rate_hz'),
+            'scan_beams': LaunchConfiguration('scan_beams'),
+            'tf_rate_hz': LaunchConfiguration('tf_rate_hz'),
+            'tf_transforms': LaunchConfiguration('tf_transforms'),
+            'odom_rate_hz': LaunchConfiguration('odom_rate_hz'),
+            'echo_rate_hz': LaunchConfiguration('echo_rate_hz'),
+            'warmup_sec': LaunchConfiguration('warmup_sec'),
+            'duration_sec': LaunchConfiguration('duration_sec'),
+            'drain_ms': LaunchConfiguration('drain_ms'),
+            'report_file': LaunchConfiguration('report_file')
+        }]
+    )
+
+    return LaunchDescription(
+        [DeclareLaunchArgument(name, default_value = value) for name, value in load_arguments.items()] + [
+        DeclareLaunchArgument('start_broker', default_value = 'true'),
+        ExecuteProcess(
+            cmd = ['mosquitto', '-p', '1883'],
+            output = 'screen',
+            condition = IfCondition(LaunchConfiguration('start_broker'))
+        ),
+        Node(
+            package = 'rclcpp_mqtt_bridge',
+            name = 'ros_connection_bridge',
+            executable = 'ros_connection_bridge',
+            output = 'screen'
+        ),
+        Node(
+            package = 'rclcpp_mqtt_bridge',
+            name = 'ros_mqtt_bridge',
+            executable = 'ros_mqtt_bridge',
+            output = 'screen'
+        ),
+        load_generator,
+        RegisterEventHandler(
+            OnProcessExit(
+                target_action = load_generator,
+                on_exit = [Shutdown(reason = 'load test finished')]
+            )
+        )
+    ])
@@ -19,11 +19,13 @@
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
  * @param ros_node_ptr std::shared_ptr<rclcpp::Node>
+ * @param ros_metrics_registry_ptr ros_mqtt_metrics::MetricsRegistry * per-topic metrics are not recorded when nullptr
  * @see rclcpp
 */
-ros_connections::ros_connections_to_mqtt::Bridge::Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr)
+ros_connections::ros_connections_to_mqtt::Bridge::Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr, ros_mqtt_metrics::MetricsRegistry * ros_metrics_registry_ptr)
 : ros_node_ptr_(ros_node_ptr),
-ros_default_qos_(ROS_DEFAULT_QOS) {
+ros_default_qos_(ROS_DEFAULT_QOS),
+ros_metrics_registry_ptr_(ros_metrics_registry_ptr) {
     this->initialize_bridge();
 }
 
@@ -169,7 +171,9 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::to_mqtt::origin::chatter,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const std_msgs::msg::String::SharedPtr callback_chatter_data) {
+                ros_mqtt_metrics::LatencyTrace chatter_trace = this->record_received(ros_topics::to_mqtt::origin::chatter);
                 ros_chatter_publisher_ptr_->publish(*callback_chatter_data);
+                this->record_relayed(ros_topics::to_mqtt::origin::chatter, chatter_trace);
             }
         );    
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -181,7 +185,9 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::to_mqtt::origin::robot_pose,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const geometry_msgs::msg::Pose::SharedPtr callback_robot_pose_data) {
+                ros_mqtt_metrics::LatencyTrace robot_pose_trace = this->record_received(ros_topics::to_mqtt::origin::robot_pose);
                 ros_robot_pose_publisher_ptr_->publish(*callback_robot_pose_data);
+                this->record_relayed(ros_topics::to_mqtt::origin::robot_pose, robot_pose_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -193,7 +199,9 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::to_mqtt::origin::scan,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const sensor_msgs::msg::LaserScan::SharedPtr callback_scan_data) {
+                ros_mqtt_metrics::LatencyTrace scan_trace = this->record_received(ros_topics::to_mqtt::origin::scan);
                 ros_scan_publisher_ptr_->publish(*callback_scan_data);
+                this->record_relayed(ros_topics::to_mqtt::origin::scan, scan_trace);
             }
         );        
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -205,7 +213,9 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::to_mqtt::origin::tf,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const tf2_msgs::msg::TFMessage::SharedPtr callback_tf_data) {
+                ros_mqtt_metrics::LatencyTrace tf_trace = this->record_received(ros_topics::to_mqtt::origin::tf);
                 ros_tf_publisher_ptr_->publish(*callback_tf_data);
+                this->record_relayed(ros_topics::to_mqtt::origin::tf, tf_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -217,7 +227,9 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::to_mqtt::origin::tf_static,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const tf2_msgs::msg::TFMessage::SharedPtr callback_tf_static_data) {
+                ros_mqtt_metrics::LatencyTrace tf_static_trace = this->record_received(ros_topics::to_mqtt::origin::tf_static);
                 ros_tf_static_publisher_ptr_->publish(*callback_tf_static_data);
+                this->record_relayed(ros_topics::to_mqtt::origin::tf_static, tf_static_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -229,7 +241,9 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::to_mqtt::origin::odom,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const nav_msgs::msg::Odometry::SharedPtr callback_odom_data) {
+                ros_mqtt_metrics::LatencyTrace odom_trace = this->record_received(ros_topics::to_mqtt::origin::odom);
                 ros_odom_publisher_ptr_->publish(*callback_odom_data);
+                this->record_relayed(ros_topics::to_mqtt::origin::odom, odom_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -241,7 +255,9 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::to_mqtt::origin::global_plan,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const nav_msgs::msg::Path::SharedPtr callback_global_plan_data) {
+                ros_mqtt_metrics::LatencyTrace global_plan_trace = this->record_received(ros_topics::to_mqtt::origin::global_plan);
                 ros_global_plan_publisher_ptr_->publish(*callback_global_plan_data);
+                this->record_relayed(ros_topics::to_mqtt::origin::global_plan, global_plan_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -253,7 +269,9 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::to_mqtt::origin::local_plan,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const nav_msgs::msg::Path::SharedPtr callback_local_plan_data) {
+                ros_mqtt_metrics::LatencyTrace local_plan_trace = this->record_received(ros_topics::to_mqtt::origin::local_plan);
                 ros_local_plan_publisher_ptr_->publish(*callback_local_plan_data);
+                this->record_relayed(ros_topics::to_mqtt::origin::local_plan, local_plan_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -265,6 +283,7 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
             ros_topics::from_mqtt::bridge::map_server_map,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const std_msgs::msg::String::SharedPtr callback_map_server_map_request_data) {
+                ros_mqtt_metrics::LatencyTrace map_server_map_trace = this->record_received(ros_topics::from_mqtt::bridge::map_server_map);
                 std::cout << "[ROS to MQTT] service call to /map_server/map" << '\n';
                 bool is_map_server_map_service_ready = ros_map_server_map_service_client_ptr_->wait_for_service(std::chrono::seconds(5));
                 if(is_map_server_map_service_ready) {
@@ -285,12 +304,14 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
                     const std::shared_ptr<nav_msgs::srv::GetMap_Response> map_server_map_service_call_result = map_response_future.get();
                     std::cout << "[ROS to MQTT] /map_server/map size of map : " << map_server_map_service_call_result->map.info.width * map_server_map_service_call_result->map.info.height << '\n';
                     ros_map_server_map_service_publisher_ptr_->publish(*map_server_map_service_call_result);
+                    this->record_relayed(ros_topics::from_mqtt::bridge::map_server_map, map_server_map_trace);
                 } else if (map_status == std::future_status::timeout) {
                     std::cerr << "[ROS to MQTT] /map_server/map service call timed out!" << '\n';
-                    
+                    this->record_dropped(ros_topics::from_mqtt::bridge::map_server_map);
                     return;
                 } else {
                     std::cerr << "[ROS to MQTT] Error while waiting for /map_server/map service response!" << '\n';
+                    this->record_dropped(ros_topics::from_mqtt::bridge::map_server_map);
                     return;
                 }
             }
@@ -301,27 +322,104 @@ void ros_connections::ros_connections_to_mqtt::Bridge::initialize_subscriptions(
 }
 
 /**
- * @brief Function for invoke initialize_publishers(), initialize_subscriptions()
+ * @brief Function for invoke initialize_metrics(), initialize_publishers(), initialize_subscriptions()
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
  * @return void
  * @see rclcpp
 */
 void ros_connections::ros_connections_to_mqtt::Bridge::initialize_bridge() {
+    this->initialize_metrics();
     this->initialize_publishers();
     this->initialize_subscriptions();
 }
 
+/**
+ * @brief Function for register subscribed topics into metrics registry
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_metrics::MetricsRegistry
+*/
+void ros_connections::ros_connections_to_mqtt::Bridge::initialize_metrics() {
+    if(ros_metrics_registry_ptr_ == nullptr) {
+        return;
+    }
+
+    const char * relayed_topics[] = {
+        ros_topics::to_mqtt::origin::chatter,
+        ros_topics::to_mqtt::origin::robot_pose,
+        ros_topics::to_mqtt::origin::scan,
+        ros_topics::to_mqtt::origin::tf,
+        ros_topics::to_mqtt::origin::tf_static,
+        ros_topics::to_mqtt::origin::odom,
+        ros_topics::to_mqtt::origin::global_plan,
+        ros_topics::to_mqtt::origin::local_plan,
+        ros_topics::from_mqtt::bridge::map_server_map
+    };
+    for(const char * relayed_topic : relayed_topics) {
+        ros_metrics_registry_ptr_->register_topic(relayed_topic, "egress");
+    }
+}
+
+/**
+ * @brief Function for count ros message which is received on subscribed topic & start its latency trace
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param ros_topic const char *
+ * @return ros_mqtt_metrics::LatencyTrace
+*/
+ros_mqtt_metrics::LatencyTrace ros_connections::ros_connections_to_mqtt::Bridge::record_received(const char * ros_topic) {
+    ros_mqtt_metrics::TopicMetrics * received_metrics = ros_metrics_registry_ptr_ != nullptr ? ros_metrics_registry_ptr_->find(ros_topic) : nullptr;
+    if(received_metrics != nullptr) {
+        received_metrics->messages_in.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ros_mqtt_metrics::start_trace();
+}
+
+/**
+ * @brief Function for count ros message which is relayed into bridge topic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param ros_topic const char *
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return void
+*/
+void ros_connections::ros_connections_to_mqtt::Bridge::record_relayed(const char * ros_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    ros_mqtt_metrics::TopicMetrics * relayed_metrics = ros_metrics_registry_ptr_ != nullptr ? ros_metrics_registry_ptr_->find(ros_topic) : nullptr;
+    if(relayed_metrics == nullptr) {
+        return;
+    }
+    relayed_metrics->messages_out.fetch_add(1, std::memory_order_relaxed);
+    relayed_metrics->latency(ros_mqtt_metrics::LatencyStage::RECEIVE_TO_PUBLISHED).record(latency_trace.received, std::chrono::steady_clock::now());
+}
+
+/**
+ * @brief Function for count ros message which could not be relayed
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param ros_topic const char *
+ * @return void
+*/
+void ros_connections::ros_connections_to_mqtt::Bridge::record_dropped(const char * ros_topic) {
+    ros_mqtt_metrics::TopicMetrics * dropped_metrics = ros_metrics_registry_ptr_ != nullptr ? ros_metrics_registry_ptr_->find(ros_topic) : nullptr;
+    if(dropped_metrics != nullptr) {
+        dropped_metrics->drops.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
 /**
  * @brief Constructor for initialize this class instance & invoke initialize_bridge()
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
  * @param ros_node_ptr std::shared_ptr<rclcpp::Node>
+ * @param ros_metrics_registry_ptr ros_mqtt_metrics::MetricsRegistry * per-topic metrics are not recorded when nullptr
  * @see rclcpp
 */
-ros_connections::ros_connections_from_mqtt::Bridge::Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr)
+ros_connections::ros_connections_from_mqtt::Bridge::Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr, ros_mqtt_metrics::MetricsRegistry * ros_metrics_registry_ptr)
 : ros_node_ptr_(ros_node_ptr),
-ros_default_qos_(ROS_DEFAULT_QOS) {
+ros_default_qos_(ROS_DEFAULT_QOS),
+ros_metrics_registry_ptr_(ros_metrics_registry_ptr) {
     this->initialize_bridge();
 }
 
@@ -383,7 +481,9 @@ void ros_connections::ros_connections_from_mqtt::Bridge::initialize_subscription
             ros_topics::from_mqtt::bridge::chatter,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const std_msgs::msg::String::SharedPtr callback_chatter_data) {
+                ros_mqtt_metrics::LatencyTrace chatter_trace = this->record_received(ros_topics::from_mqtt::bridge::chatter);
                 ros_chatter_publisher_ptr_->publish(*callback_chatter_data);
+                this->record_relayed(ros_topics::from_mqtt::bridge::chatter, chatter_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -395,7 +495,9 @@ void ros_connections::ros_connections_from_mqtt::Bridge::initialize_subscription
             ros_topics::from_mqtt::bridge::cmd_vel,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const geometry_msgs::msg::Twist::SharedPtr callback_cmd_vel_data) {
+                ros_mqtt_metrics::LatencyTrace cmd_vel_trace = this->record_received(ros_topics::from_mqtt::bridge::cmd_vel);
                 ros_cmd_vel_publisher_ptr_->publish(*callback_cmd_vel_data);
+                this->record_relayed(ros_topics::from_mqtt::bridge::cmd_vel, cmd_vel_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -407,7 +509,9 @@ void ros_connections::ros_connections_from_mqtt::Bridge::initialize_subscription
             ros_topics::from_mqtt::bridge::initial_pose,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const geometry_msgs::msg::PoseWithCovarianceStamped::SharedPtr callback_initial_pose_data) {
+                ros_mqtt_metrics::LatencyTrace initial_pose_trace = this->record_received(ros_topics::from_mqtt::bridge::initial_pose);
                 ros_initial_pose_publisher_ptr_->publish(*callback_initial_pose_data);
+                this->record_relayed(ros_topics::from_mqtt::bridge::initial_pose, initial_pose_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -416,17 +520,72 @@ void ros_connections::ros_connections_from_mqtt::Bridge::initialize_subscription
 }
 
 /**
- * @brief Function for invoke initialize_publishers(), initialize_subscriptions()
+ * @brief Function for invoke initialize_metrics(), initialize_publishers(), initialize_subscriptions()
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
  * @return void
  * @see rclcpp
 */
 void ros_connections::ros_connections_from_mqtt::Bridge::initialize_bridge() {
+    this->initialize_metrics();
     this->initialize_publishers();
     this->initialize_subscriptions();
 }
 
+/**
+ * @brief Function for register subscribed topics into metrics registry
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_metrics::MetricsRegistry
+*/
+void ros_connections::ros_connections_from_mqtt::Bridge::initialize_metrics() {
+    if(ros_metrics_registry_ptr_ == nullptr) {
+        return;
+    }
+
+    const char * relayed_topics[] = {
+        ros_topics::from_mqtt::bridge::chatter,
+        ros_topics::from_mqtt::bridge::cmd_vel,
+        ros_topics::from_mqtt::bridge::initial_pose
+    };
+    for(const char * relayed_topic : relayed_topics) {
+        ros_metrics_registry_ptr_->register_topic(relayed_topic, "ingress");
+    }
+}
+
+/**
+ * @brief Function for count ros message which is received on subscribed topic & start its latency trace
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param ros_topic const char *
+ * @return ros_mqtt_metrics::LatencyTrace
+*/
+ros_mqtt_metrics::LatencyTrace ros_connections::ros_connections_from_mqtt::Bridge::record_received(const char * ros_topic) {
+    ros_mqtt_metrics::TopicMetrics * received_metrics = ros_metrics_registry_ptr_ != nullptr ? ros_metrics_registry_ptr_->find(ros_topic) : nullptr;
+    if(received_metrics != nullptr) {
+        received_metrics->messages_in.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ros_mqtt_metrics::start_trace();
+}
+
+/**
+ * @brief Function for count ros message which is relayed into bridge topic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param ros_topic const char *
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return void
+*/
+void ros_connections::ros_connections_from_mqtt::Bridge::record_relayed(const char * ros_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    ros_mqtt_metrics::TopicMetrics * relayed_metrics = ros_metrics_registry_ptr_ != nullptr ? ros_metrics_registry_ptr_->find(ros_topic) : nullptr;
+    if(relayed_metrics == nullptr) {
+        return;
+    }
+    relayed_metrics->messages_out.fetch_add(1, std::memory_order_relaxed);
+    relayed_metrics->latency(ros_mqtt_metrics::LatencyStage::RECEIVE_TO_PUBLISHED).record(latency_trace.received, std::chrono::steady_clock::now());
+}
+
 
 /**
  * @brief Constructor for initialize this class instance & create rclcpp::Node named with ros_connection_bridge & invoke ros_connections classes' constructors
@@ -440,8 +599,17 @@ RosConnectionBridge::RosConnectionBridge()
 : Node("ros_connection_bridge"),
 log_ros_(LOG_ROS_CONNECTION_BRIDGE) {
     ros_node_ptr_ = std::shared_ptr<rclcpp::Node>(this, [](rclcpp::Node*){});
-    ros_connections_to_mqtt_bridge_ptr_ = new ros_connections::ros_connections_to_mqtt::Bridge(ros_node_ptr_);
-    ros_connections_from_mqtt_bridge_ptr_ = new ros_connections::ros_connections_from_mqtt::Bridge(ros_node_ptr_);
+    ros_metrics_registry_ptr_ = new ros_mqtt_metrics::MetricsRegistry();
+    ros_connections_to_mqtt_bridge_ptr_ = new ros_connections::ros_connections_to_mqtt::Bridge(ros_node_ptr_, ros_metrics_registry_ptr_);
+    ros_connections_from_mqtt_bridge_ptr_ = new ros_connections::ros_connections_from_mqtt::Bridge(ros_node_ptr_, ros_metrics_registry_ptr_);
+    ros_metrics_exporter_ptr_ = new ros_mqtt_metrics::MetricsExporter(
+        ros_node_ptr_,
+        *ros_metrics_registry_ptr_,
+        METRICS_PREFIX,
+        METRICS_DIAGNOSTICS_TOPIC,
+        METRICS_PROMETHEUS_FILE,
+        std::chrono::milliseconds(METRICS_PUBLISH_PERIOD_MS)
+    );
 
     this->check_current_topics_and_types();
 }
@@ -454,8 +622,10 @@ log_ros_(LOG_ROS_CONNECTION_BRIDGE) {
  * @see ros_connection_subscription_ptr_
 */
 RosConnectionBridge::~RosConnectionBridge() {
+    delete ros_metrics_exporter_ptr_;
     delete ros_connections_to_mqtt_bridge_ptr_;
     delete ros_connections_from_mqtt_bridge_ptr_;
+    delete ros_metrics_registry_ptr_;
 }
 
 /**
@@ -0,0 +1,170 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_backpressure.hpp"
+
+/**
+ * @brief Function for get name of pressure level
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param pressure_level PressureLevel
+ * @return const char *
+*/
+const char * ros_mqtt_backpressure::level_name(PressureLevel pressure_level) {
+    switch(pressure_level) {
+        case PressureLevel::NORMAL :
+            return "normal";
+        case PressureLevel::THROTTLED :
+            return "throttled";
+        case PressureLevel::DEGRADED :
+            return "degraded";
+        default :
+            return "unknown";
+    }
+}
+
+/**
+ * @brief Constructor for initialize this class instance at normal level
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param backpressure_options const BackpressureOptions&
+*/
+ros_mqtt_backpressure::EgressGovernor::EgressGovernor(const BackpressureOptions& backpressure_options)
+: backpressure_options_(backpressure_options),
+pressure_level_(static_cast<uint8_t>(PressureLevel::NORMAL)),
+worst_latency_ns_(0),
+throttled_count_(0),
+escalation_count_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_backpressure::EgressGovernor::~EgressGovernor() {
+
+}
+
+/**
+ * @brief Function for record end-to-end latency of a published message, only the worst one since last update is kept
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param end_to_end_latency std::chrono::nanoseconds
+ * @return void
+*/
+void ros_mqtt_backpressure::EgressGovernor::record_latency(std::chrono::nanoseconds end_to_end_latency) {
+    const int64_t latency_ns = end_to_end_latency.count();
+    int64_t worst_latency_ns = worst_latency_ns_.load(std::memory_order_relaxed);
+    while(latency_ns > worst_latency_ns && !worst_latency_ns_.compare_exchange_weak(worst_latency_ns, latency_ns, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Function for move pressure level by one step from queue depth & worst latency since last update
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param queue_depth std::size_t messages waiting in transport & bridge queues
+ * @param now std::chrono::steady_clock::time_point
+ * @return PressureLevel level after update
+*/
+ros_mqtt_backpressure::PressureLevel ros_mqtt_backpressure::EgressGovernor::update(std::size_t queue_depth, std::chrono::steady_clock::time_point now) {
+    const std::chrono::nanoseconds worst_latency(worst_latency_ns_.exchange(0, std::memory_order_relaxed));
+    const bool is_congested = queue_depth >= backpressure_options_.queue_high || worst_latency > backpressure_options_.latency_target;
+    const bool is_calm = queue_depth <= backpressure_options_.queue_low && worst_latency * 2 <= backpressure_options_.latency_target;
+    uint8_t pressure_level = pressure_level_.load(std::memory_order_relaxed);
+
+    if(is_congested) {
+        calm_since_ = std::chrono::steady_clock::time_point();
+        if(pressure_level < static_cast<uint8_t>(PressureLevel::DEGRADED) && now - level_changed_ >= backpressure_options_.settle) {
+            pressure_level++;
+            level_changed_ = now;
+            escalation_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else if(!is_calm) {
+        calm_since_ = std::chrono::steady_clock::time_point();
+    } else if(pressure_level > static_cast<uint8_t>(PressureLevel::NORMAL)) {
+        if(calm_since_ == std::chrono::steady_clock::time_point()) {
+            calm_since_ = now;
+        } else if(now - calm_since_ >= backpressure_options_.recover_hold) {
+            pressure_level--;
+            level_changed_ = now;
+            calm_since_ = now;
+        }
+    }
+
+    pressure_level_.store(pressure_level, std::memory_order_relaxed);
+    return static_cast<PressureLevel>(pressure_level);
+}
+
+/**
+ * @brief Function for get current pressure level
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return PressureLevel
+*/
+ros_mqtt_backpressure::PressureLevel ros_mqtt_backpressure::EgressGovernor::level() const {
+    return static_cast<PressureLevel>(pressure_level_.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Function for check whether message of bulk topic may be published now at the rate of current level
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param now std::chrono::steady_clock::time_point
+ * @return bool always true at normal level, admitted messages are remembered so intervals count from last admitted message
+*/
+bool ros_mqtt_backpressure::EgressGovernor::is_admitted(const char * mqtt_topic, std::chrono::steady_clock::time_point now) {
+    std::chrono::milliseconds admit_interval(0);
+    const PressureLevel pressure_level = this->level();
+    if(pressure_level == PressureLevel::THROTTLED) {
+        admit_interval = backpressure_options_.throttled_interval;
+    } else if(pressure_level == PressureLevel::DEGRADED) {
+        admit_interval = backpressure_options_.degraded_interval;
+    }
+
+    std::map<std::string, std::chrono::steady_clock::time_point, std::less<>>::iterator admitted_time = admitted_times_.find(mqtt_topic);
+    if(admitted_time == admitted_times_.end()) {
+        admitted_times_.emplace(mqtt_topic, now);
+        return true;
+    }
+    if(admit_interval.count() > 0 && now - admitted_time->second < admit_interval) {
+        throttled_count_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    admitted_time->second = now;
+    return true;
+}
+
+/**
+ * @brief Function for get count of bulk messages which were not admitted
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_backpressure::EgressGovernor::throttled_count() const {
+    return throttled_count_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for get count of level escalations
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_backpressure::EgressGovernor::escalation_count() const {
+    return escalation_count_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,148 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_batcher.hpp"
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param max_messages std::size_t
+ * @param max_delay std::chrono::milliseconds
+*/
+ros_mqtt_batch::MessageBatcher::MessageBatcher(std::size_t max_messages, std::chrono::milliseconds max_delay)
+: max_messages_(max_messages),
+max_delay_(max_delay) {
+    batch_entries_.reserve(max_messages_);
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_batch::MessageBatcher::~MessageBatcher() {
+
+}
+
+/**
+ * @brief Function for append converted payload into current batch with bridge receive time
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param ros_message_type const char *
+ * @param receive_stamp int64_t wall clock nanoseconds the bridge received message at, 0 when unknown & time of batching is taken
+ * @param mqtt_payload std::string
+ * @return bool true when current batch reached max messages & should be flushed
+*/
+bool ros_mqtt_batch::MessageBatcher::add(const char * mqtt_topic, const char * ros_message_type, int64_t receive_stamp, std::string mqtt_payload) {
+    if(receive_stamp == 0) {
+        const std::chrono::system_clock::time_point receive_time = std::chrono::system_clock::now();
+        receive_stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time.time_since_epoch()).count();
+    }
+
+    std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+    if(batch_entries_.empty()) {
+        oldest_entry_time_ = std::chrono::steady_clock::now();
+    }
+    batch_entries_.push_back(BatchEntry{mqtt_topic, ros_message_type, receive_stamp, std::move(mqtt_payload)});
+
+    return batch_entries_.size() >= max_messages_;
+}
+
+/**
+ * @brief Function for check oldest entry in current batch has waited for max delay
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool
+*/
+bool ros_mqtt_batch::MessageBatcher::is_expired() {
+    std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+    if(batch_entries_.empty()) {
+        return false;
+    }
+    return std::chrono::steady_clock::now() - oldest_entry_time_ >= max_delay_;
+}
+
+/**
+ * @brief Function for get count of entries in current batch
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_batch::MessageBatcher::size() {
+    std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+    return batch_entries_.size();
+}
+
+/**
+ * @brief Function for take current batch & serialize it into envelope payload
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::string empty when there is nothing to flush
+*/
+std::string ros_mqtt_batch::MessageBatcher::flush() {
+    std::vector<BatchEntry> flushed_entries;
+    flushed_entries.reserve(max_messages_);
+
+    {
+        std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+        if(batch_entries_.empty()) {
+            return std::string();
+        }
+        flushed_entries.swap(batch_entries_);
+    }
+
+    return serialize_envelope(flushed_entries);
+}
+
+/**
+ * @brief Function for serialize batch entries into envelope JSON without re-parsing converted payloads
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param batch_entries const std::vector<BatchEntry>&
+ * @return std::string
+ * @details each entry payload is already a JSON document from ros_message_converter, so it is spliced in as-is
+*/
+std::string ros_mqtt_batch::MessageBatcher::serialize_envelope(const std::vector<BatchEntry>& batch_entries) {
+    std::size_t envelope_size = 32;
+    for(const BatchEntry& batch_entry : batch_entries) {
+        envelope_size += batch_entry.topic.size() + batch_entry.type.size() + batch_entry.payload.size() + 64;
+    }
+
+    std::string envelope;
+    envelope.reserve(envelope_size);
+    envelope += "{\"count\":";
+    envelope += std::to_string(batch_entries.size());
+    envelope += ",\"entries\":[";
+
+    for(std::size_t i = 0; i < batch_entries.size(); i++) {
+        const BatchEntry& batch_entry = batch_entries[i];
+        if(i > 0) {
+            envelope += ',';
+        }
+        envelope += "{\"topic\":\"";
+        envelope += batch_entry.topic;
+        envelope += "\",\"type\":\"";
+        envelope += batch_entry.type;
+        envelope += "\",\"stamp\":";
+        envelope += std::to_string(batch_entry.stamp);
+        envelope += ",\"payload\":";
+        envelope += batch_entry.payload;
+        envelope += '}';
+    }
+
+    envelope += "]}";
+    return envelope;
+}
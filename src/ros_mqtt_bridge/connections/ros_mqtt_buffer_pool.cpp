@@ -0,0 +1,126 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_buffer_pool.hpp"
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param max_buffers std::size_t
+ * @param max_buffer_capacity std::size_t
+*/
+ros_mqtt_buffer_pool::BufferPool::BufferPool(std::size_t max_buffers, std::size_t max_buffer_capacity)
+: max_buffers_(max_buffers),
+max_buffer_capacity_(max_buffer_capacity),
+reused_count_(0),
+missed_count_(0) {
+    free_buffers_.reserve(max_buffers_);
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_buffer_pool::BufferPool::~BufferPool() {
+
+}
+
+/**
+ * @brief Function for get process wide payload pool, created on first use
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return BufferPool&
+*/
+ros_mqtt_buffer_pool::BufferPool& ros_mqtt_buffer_pool::BufferPool::instance() {
+    static BufferPool buffer_pool(BUFFER_POOL_MAX_BUFFERS, BUFFER_POOL_MAX_CAPACITY);
+    return buffer_pool;
+}
+
+/**
+ * @brief Function for take empty buffer out of pool
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::string empty, keeps capacity of a recycled buffer or has none when pool is empty
+*/
+std::string ros_mqtt_buffer_pool::BufferPool::acquire() {
+    std::string buffer;
+    {
+        std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+        if(!free_buffers_.empty()) {
+            buffer.swap(free_buffers_.back());
+            free_buffers_.pop_back();
+        }
+    }
+
+    if(buffer.capacity() == std::string().capacity()) {
+        missed_count_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        reused_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    buffer.clear();
+    return buffer;
+}
+
+/**
+ * @brief Function for give buffer back into pool
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param buffer std::string& left empty when it is kept, buffers without heap storage, larger than max capacity or over max buffers are left to their owner
+ * @return void
+*/
+void ros_mqtt_buffer_pool::BufferPool::recycle(std::string& buffer) {
+    if(buffer.capacity() == std::string().capacity() || buffer.capacity() > max_buffer_capacity_) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+    if(free_buffers_.size() >= max_buffers_) {
+        return;
+    }
+    free_buffers_.push_back(std::string());
+    free_buffers_.back().swap(buffer);
+}
+
+/**
+ * @brief Function for get count of buffers which are kept in pool
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_buffer_pool::BufferPool::size() {
+    std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+    return free_buffers_.size();
+}
+
+/**
+ * @brief Function for get count of acquires which got a recycled buffer
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_buffer_pool::BufferPool::reused_count() const {
+    return reused_count_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for get count of acquires which found pool empty, their buffers allocate on first write
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_buffer_pool::BufferPool::missed_count() const {
+    return missed_count_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,106 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_command_hold.hpp"
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param watchdog std::chrono::milliseconds max age of a command which is still handed out
+*/
+ros_mqtt_command::CommandHold::CommandHold(std::chrono::milliseconds watchdog)
+: watchdog_(watchdog),
+held_command_(),
+is_held_(false),
+coalesced_count_(0),
+timeout_count_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_command::CommandHold::~CommandHold() {
+
+}
+
+/**
+ * @brief Function for replace held command with latest one
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param twist_msgs const geometry_msgs::msg::Twist&
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace& its received time is the age watchdog compares with
+ * @return void
+*/
+void ros_mqtt_command::CommandHold::hold(const geometry_msgs::msg::Twist& twist_msgs, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    std::lock_guard<std::mutex> command_lock(command_mutex_);
+    if(is_held_ && held_command_.is_fresh) {
+        coalesced_count_++;
+    }
+    held_command_.twist = twist_msgs;
+    held_command_.latency_trace = latency_trace;
+    held_command_.is_fresh = true;
+    held_command_.is_timed_out = false;
+    is_held_ = true;
+}
+
+/**
+ * @brief Function for get command which is published on this tick
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param now std::chrono::steady_clock::time_point
+ * @param held_command HeldCommand& written when this function returns true
+ * @return bool false when there is nothing to publish, before first command & after zero velocity of an expired command
+*/
+bool ros_mqtt_command::CommandHold::tick(std::chrono::steady_clock::time_point now, HeldCommand& held_command) {
+    std::lock_guard<std::mutex> command_lock(command_mutex_);
+    if(!is_held_) {
+        return false;
+    }
+
+    if(now - held_command_.latency_trace.received > watchdog_) {
+        held_command_.twist = geometry_msgs::msg::Twist();
+        held_command_.is_timed_out = true;
+        is_held_ = false;
+        timeout_count_++;
+    }
+    held_command = held_command_;
+    held_command_.is_fresh = false;
+    return true;
+}
+
+/**
+ * @brief Function for get count of commands which were replaced before any tick handed them out
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_command::CommandHold::coalesced_count() {
+    std::lock_guard<std::mutex> command_lock(command_mutex_);
+    return coalesced_count_;
+}
+
+/**
+ * @brief Function for get count of watchdog expiries
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_command::CommandHold::timeout_count() {
+    std::lock_guard<std::mutex> command_lock(command_mutex_);
+    return timeout_count_;
+}
@@ -0,0 +1,305 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_compressor.hpp"
+
+/**
+ * @brief Function for check mqtt payload starts with compression header
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_payload const std::string&
+ * @return bool
+*/
+bool ros_mqtt_compression::is_compressed(const std::string& mqtt_payload) {
+    return mqtt_payload.size() >= MQTT_COMPRESSION_HEADER_SIZE && mqtt_payload[0] == '\0' && mqtt_payload[1] == 'Z';
+}
+
+/**
+ * @brief Function for compress payload with codec & level, prefixed with compression header
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param raw_payload const std::string&
+ * @param compression_options const CompressionOptions&
+ * @param compressed_payload std::string&
+ * @return bool false when payload is under threshold, codec is unavailable or compression did not shrink it
+*/
+bool ros_mqtt_compression::compress(const std::string& raw_payload, const CompressionOptions& compression_options, std::string& compressed_payload) {
+    if(compression_options.codec == Codec::NONE || raw_payload.size() < compression_options.threshold || raw_payload.size() > UINT32_MAX) {
+        return false;
+    }
+
+    const uint32_t raw_size = static_cast<uint32_t>(raw_payload.size());
+    std::size_t compressed_size = 0;
+
+    if(compression_options.codec == Codec::DEFLATE) {
+        uLongf deflate_bound = compressBound(raw_size);
+        compressed_payload.resize(MQTT_COMPRESSION_HEADER_SIZE + deflate_bound);
+        int deflate_result = compress2(
+            reinterpret_cast<Bytef *>(&compressed_payload[MQTT_COMPRESSION_HEADER_SIZE]),
+            &deflate_bound,
+            reinterpret_cast<const Bytef *>(raw_payload.data()),
+            raw_size,
+            compression_options.level
+        );
+        if(deflate_result != Z_OK) {
+            std::cerr << LOG_ROS_MQTT_COMPRESSOR << " deflate err : " << deflate_result << '\n';
+            return false;
+        }
+        compressed_size = deflate_bound;
+    } else if(compression_options.codec == Codec::ZSTD) {
+#ifdef ROS_MQTT_BRIDGE_WITH_ZSTD
+        std::size_t zstd_bound = ZSTD_compressBound(raw_size);
+        compressed_payload.resize(MQTT_COMPRESSION_HEADER_SIZE + zstd_bound);
+        std::size_t zstd_result = ZSTD_compress(
+            &compressed_payload[MQTT_COMPRESSION_HEADER_SIZE],
+            zstd_bound,
+            raw_payload.data(),
+            raw_size,
+            compression_options.level
+        );
+        if(ZSTD_isError(zstd_result)) {
+            std::cerr << LOG_ROS_MQTT_COMPRESSOR << " zstd err : " << ZSTD_getErrorName(zstd_result) << '\n';
+            return false;
+        }
+        compressed_size = zstd_result;
+#else
+        std::cerr << LOG_ROS_MQTT_COMPRESSOR << " zstd is not available in this build" << '\n';
+        return false;
+#endif
+    } else {
+        return false;
+    }
+
+    if(MQTT_COMPRESSION_HEADER_SIZE + compressed_size >= raw_payload.size()) {
+        return false;
+    }
+
+    compressed_payload.resize(MQTT_COMPRESSION_HEADER_SIZE + compressed_size);
+    compressed_payload[0] = '\0';
+    compressed_payload[1] = 'Z';
+    compressed_payload[2] = static_cast<char>(compression_options.codec);
+    compressed_payload[3] = static_cast<char>((raw_size >> 24) & 0xFF);
+    compressed_payload[4] = static_cast<char>((raw_size >> 16) & 0xFF);
+    compressed_payload[5] = static_cast<char>((raw_size >> 8) & 0xFF);
+    compressed_payload[6] = static_cast<char>(raw_size & 0xFF);
+
+    return true;
+}
+
+/**
+ * @brief Function for decompress payload by codec written in compression header
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param compressed_payload const std::string&
+ * @param raw_payload std::string&
+ * @return bool false also when header claims more than MQTT_DECOMPRESSION_MAX_SIZE bytes, or for deflate more than MQTT_DEFLATE_MAX_RATIO times the compressed size
+ * which deflate can not reach, so an untrusted header never sizes the allocation
+*/
+bool ros_mqtt_compression::decompress(const std::string& compressed_payload, std::string& raw_payload) {
+    if(!is_compressed(compressed_payload)) {
+        return false;
+    }
+
+    const Codec codec = static_cast<Codec>(compressed_payload[2]);
+    const uint32_t raw_size =
+        (static_cast<uint32_t>(static_cast<uint8_t>(compressed_payload[3])) << 24) |
+        (static_cast<uint32_t>(static_cast<uint8_t>(compressed_payload[4])) << 16) |
+        (static_cast<uint32_t>(static_cast<uint8_t>(compressed_payload[5])) << 8) |
+        static_cast<uint32_t>(static_cast<uint8_t>(compressed_payload[6]));
+    const char * compressed_data = compressed_payload.data() + MQTT_COMPRESSION_HEADER_SIZE;
+    const std::size_t compressed_size = compressed_payload.size() - MQTT_COMPRESSION_HEADER_SIZE;
+
+    const bool is_ratio_exceeded = codec == Codec::DEFLATE && raw_size > static_cast<uint64_t>(compressed_size) * MQTT_DEFLATE_MAX_RATIO;
+    if(raw_size > MQTT_DECOMPRESSION_MAX_SIZE || is_ratio_exceeded) {
+        std::cerr << LOG_ROS_MQTT_COMPRESSOR << " rejected header claiming " << raw_size << " bytes from " << compressed_size << " compressed bytes" << '\n';
+        return false;
+    }
+    raw_payload.resize(raw_size);
+
+    if(codec == Codec::DEFLATE) {
+        uLongf inflated_size = raw_size;
+        int inflate_result = uncompress(
+            reinterpret_cast<Bytef *>(&raw_payload[0]),
+            &inflated_size,
+            reinterpret_cast<const Bytef *>(compressed_data),
+            compressed_size
+        );
+        if(inflate_result != Z_OK || inflated_size != raw_size) {
+            std::cerr << LOG_ROS_MQTT_COMPRESSOR << " inflate err : " << inflate_result << '\n';
+            return false;
+        }
+    } else if(codec == Codec::ZSTD) {
+#ifdef ROS_MQTT_BRIDGE_WITH_ZSTD
+        std::size_t zstd_result = ZSTD_decompress(&raw_payload[0], raw_size, compressed_data, compressed_size);
+        if(ZSTD_isError(zstd_result) || zstd_result != raw_size) {
+            std::cerr << LOG_ROS_MQTT_COMPRESSOR << " zstd decompress err" << '\n';
+            return false;
+        }
+#else
+        std::cerr << LOG_ROS_MQTT_COMPRESSOR << " zstd is not available in this build" << '\n';
+        return false;
+#endif
+    } else {
+        std::cerr << LOG_ROS_MQTT_COMPRESSOR << " unknown codec : " << static_cast<int>(codec) << '\n';
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Constructor for initialize this class instance & start compression worker thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param max_queue_size std::size_t
+ * @param publish_function std::function<void(const char *, std::string, const ros_mqtt_metrics::LatencyTrace&)>
+ * @param drop_function std::function<void(const char *)> called with topic of every job dropped from full queue
+*/
+ros_mqtt_compression::CompressionWorker::CompressionWorker(std::size_t max_queue_size, std::function<void(const char *, std::string, const ros_mqtt_metrics::LatencyTrace&)> publish_function, std::function<void(const char *)> drop_function)
+: max_queue_size_(max_queue_size),
+publish_function_(publish_function),
+drop_function_(drop_function),
+is_running_(true) {
+    compression_thread_ = std::thread(&CompressionWorker::run, this);
+}
+
+/**
+ * @brief Virtual Destructor for this class & join compression worker thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_compression::CompressionWorker::~CompressionWorker() {
+    this->stop();
+}
+
+/**
+ * @brief Function for queue payload to be compressed & published by worker thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param mqtt_payload std::string
+ * @param compression_options const CompressionOptions&
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return void
+ * @details when queue is full the oldest job is dropped, since a newer sample supersedes it
+*/
+void ros_mqtt_compression::CompressionWorker::submit(const char * mqtt_topic, std::string mqtt_payload, const CompressionOptions& compression_options, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    {
+        std::lock_guard<std::mutex> compression_lock(compression_mutex_);
+        if(!is_running_) {
+            return;
+        }
+        if(compression_jobs_.size() >= max_queue_size_) {
+            std::cerr << LOG_ROS_MQTT_COMPRESSOR << " queue is full, dropped oldest payload of " << compression_jobs_.front().mqtt_topic << '\n';
+            if(drop_function_) {
+                drop_function_(compression_jobs_.front().mqtt_topic.c_str());
+            }
+            compression_jobs_.pop_front();
+        }
+        compression_jobs_.push_back(CompressionJob{mqtt_topic, std::move(mqtt_payload), compression_options, latency_trace});
+    }
+    compression_condition_.notify_one();
+}
+
+/**
+ * @brief Function for get number of jobs waiting for worker thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_compression::CompressionWorker::queue_size() {
+    std::lock_guard<std::mutex> compression_lock(compression_mutex_);
+    return compression_jobs_.size();
+}
+
+/**
+ * @brief Function for stop worker thread after remaining jobs are published
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_compression::CompressionWorker::stop() {
+    {
+        std::lock_guard<std::mutex> compression_lock(compression_mutex_);
+        is_running_ = false;
+    }
+    compression_condition_.notify_all();
+    if(compression_thread_.joinable()) {
+        compression_thread_.join();
+    }
+}
+
+/**
+ * @brief Function for stop accepting jobs & publish queued jobs until deadline, jobs still queued at deadline are dropped
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param drain_deadline std::chrono::steady_clock::time_point
+ * @return std::size_t count of dropped jobs
+ * @details worker thread is joined afterwards, so a job which is being published at deadline is waited for
+*/
+std::size_t ros_mqtt_compression::CompressionWorker::drain(std::chrono::steady_clock::time_point drain_deadline) {
+    std::deque<CompressionJob> dropped_jobs;
+    {
+        std::unique_lock<std::mutex> compression_lock(compression_mutex_);
+        is_running_ = false;
+        compression_condition_.notify_all();
+        while(!compression_jobs_.empty() && std::chrono::steady_clock::now() < drain_deadline) {
+            compression_lock.unlock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(MQTT_COMPRESSION_DRAIN_POLL_MS));
+            compression_lock.lock();
+        }
+        dropped_jobs.swap(compression_jobs_);
+    }
+
+    for(const CompressionJob& dropped_job : dropped_jobs) {
+        std::cerr << LOG_ROS_MQTT_COMPRESSOR << " drain deadline passed, dropped payload of " << dropped_job.mqtt_topic << '\n';
+        if(drop_function_) {
+            drop_function_(dropped_job.mqtt_topic.c_str());
+        }
+    }
+    if(compression_thread_.joinable()) {
+        compression_thread_.join();
+    }
+    return dropped_jobs.size();
+}
+
+/**
+ * @brief Function for worker thread loop
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_compression::CompressionWorker::run() {
+    std::string compressed_payload;
+
+    while(true) {
+        CompressionJob compression_job;
+        {
+            std::unique_lock<std::mutex> compression_lock(compression_mutex_);
+            compression_condition_.wait(compression_lock, [this]() { return !is_running_ || !compression_jobs_.empty(); });
+            if(compression_jobs_.empty()) {
+                return;
+            }
+            compression_job = std::move(compression_jobs_.front());
+            compression_jobs_.pop_front();
+        }
+
+        if(compress(compression_job.mqtt_payload, compression_job.compression_options, compressed_payload)) {
+            publish_function_(compression_job.mqtt_topic.c_str(), std::move(compressed_payload), compression_job.latency_trace);
+            compressed_payload.clear();
+        } else {
+            publish_function_(compression_job.mqtt_topic.c_str(), std::move(compression_job.mqtt_payload), compression_job.latency_trace);
+        }
+    }
+}
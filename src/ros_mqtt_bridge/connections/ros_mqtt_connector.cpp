@@ -0,0 +1,299 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_connector.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Function for get name of connection state
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param connection_state ConnectionState
+ * @return const char *
+*/
+const char * ros_mqtt_connector::state_name(ConnectionState connection_state) {
+    switch(connection_state) {
+        case ConnectionState::DISCONNECTED :
+            return "disconnected";
+        case ConnectionState::CONNECTING :
+            return "connecting";
+        case ConnectionState::CONNECTED :
+            return "connected";
+        default :
+            return "unknown";
+    }
+}
+
+/**
+ * @brief Constructor for initialize this class instance, connecting starts with start()
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param transport ros_mqtt_transport::Transport& callback of transport must be set before start()
+ * @param connector_options const ConnectorOptions&
+ * @param connected_function std::function<void()>
+ * @param state_function std::function<void(ConnectionState)>
+*/
+ros_mqtt_connector::Connector::Connector(ros_mqtt_transport::Transport& transport, const ConnectorOptions& connector_options, std::function<void()> connected_function, std::function<void(ConnectionState)> state_function)
+: transport_(transport),
+connector_options_(connector_options),
+connected_function_(connected_function),
+state_function_(state_function),
+connection_state_(static_cast<uint8_t>(ConnectionState::DISCONNECTED)),
+attempt_count_(0),
+is_running_(false),
+is_lost_(false) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class & stop connector thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_connector::Connector::~Connector() {
+    this->stop();
+}
+
+/**
+ * @brief Function for start connector thread, returns immediately
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_connector::Connector::start() {
+    std::lock_guard<std::mutex> connector_lock(connector_mutex_);
+    if(is_running_) {
+        return;
+    }
+    is_running_ = true;
+    connector_thread_ = std::thread(&Connector::run, this);
+}
+
+/**
+ * @brief Function for stop connector thread, transport is left as it is
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_connector::Connector::stop() {
+    {
+        std::lock_guard<std::mutex> connector_lock(connector_mutex_);
+        is_running_ = false;
+    }
+    connector_condition_.notify_all();
+    if(connector_thread_.joinable()) {
+        connector_thread_.join();
+    }
+}
+
+/**
+ * @brief Function for tell connector that connection was lost, so it connects again
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_connector::Connector::notify_lost() {
+    {
+        std::lock_guard<std::mutex> connector_lock(connector_mutex_);
+        is_lost_ = true;
+    }
+    connector_condition_.notify_all();
+}
+
+/**
+ * @brief Function for check connector is not stopped, e.g. to end long work in connected_function
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool
+*/
+bool ros_mqtt_connector::Connector::is_running() {
+    std::lock_guard<std::mutex> connector_lock(connector_mutex_);
+    return is_running_;
+}
+
+/**
+ * @brief Function for get current connection state
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return ConnectionState
+*/
+ros_mqtt_connector::ConnectionState ros_mqtt_connector::Connector::state() const {
+    return static_cast<ConnectionState>(connection_state_.load(std::memory_order_acquire));
+}
+
+/**
+ * @brief Function for get count of connect attempts
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_connector::Connector::attempt_count() const {
+    return attempt_count_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for connect, wait for lost connection & connect again until stopped
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_connector::Connector::run() {
+    std::chrono::milliseconds retry_delay = connector_options_.retry_min;
+    std::unique_lock<std::mutex> connector_lock(connector_mutex_);
+    while(is_running_) {
+        is_lost_ = false;
+        connector_lock.unlock();
+        this->change_state(ConnectionState::CONNECTING);
+        attempt_count_.fetch_add(1, std::memory_order_relaxed);
+        const bool is_connected = transport_.connect(connector_options_.connect_timeout, [this]() {
+            return !this->is_running();
+        });
+        if(is_connected && connected_function_) {
+            connected_function_();
+        }
+        this->change_state(is_connected ? ConnectionState::CONNECTED : ConnectionState::DISCONNECTED);
+        connector_lock.lock();
+
+        if(is_connected) {
+            retry_delay = connector_options_.retry_min;
+            connector_condition_.wait(connector_lock, [this]() { return !is_running_ || is_lost_; });
+            if(is_running_) {
+                connector_lock.unlock();
+                this->change_state(ConnectionState::DISCONNECTED);
+                connector_lock.lock();
+            }
+        } else {
+            connector_condition_.wait_for(connector_lock, retry_delay, [this]() { return !is_running_; });
+            retry_delay = std::min(retry_delay * 2, connector_options_.retry_max);
+        }
+    }
+}
+
+/**
+ * @brief Function for store connection state & report it when it changed
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param connection_state ConnectionState
+ * @return void
+*/
+void ros_mqtt_connector::Connector::change_state(ConnectionState connection_state) {
+    const uint8_t last_state = connection_state_.exchange(static_cast<uint8_t>(connection_state), std::memory_order_acq_rel);
+    if(last_state != static_cast<uint8_t>(connection_state) && state_function_) {
+        state_function_(connection_state);
+    }
+}
+
+/**
+ * @brief Constructor for initialize this class instance, open since transport is not connected yet
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param capacity std::size_t
+ * @param drop_function std::function<void(const char *)>
+*/
+ros_mqtt_connector::OfflineBuffer::OfflineBuffer(std::size_t capacity, std::function<void(const char *)> drop_function)
+: capacity_(capacity),
+drop_function_(drop_function),
+is_open_(true),
+dropped_count_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_connector::OfflineBuffer::~OfflineBuffer() {
+
+}
+
+/**
+ * @brief Function for take message while not connected
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char * copied into buffered message
+ * @param mqtt_payload std::string& moved from when message is taken
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return bool false when buffer is closed & message is published as usual, true when it was buffered or dropped
+*/
+bool ros_mqtt_connector::OfflineBuffer::hold(const char * mqtt_topic, std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+    if(!is_open_) {
+        return false;
+    }
+
+    if(capacity_ == 0) {
+        dropped_count_.fetch_add(1, std::memory_order_relaxed);
+        if(drop_function_) {
+            drop_function_(mqtt_topic);
+        }
+        return true;
+    }
+    if(offline_messages_.size() >= capacity_) {
+        dropped_count_.fetch_add(1, std::memory_order_relaxed);
+        if(drop_function_) {
+            drop_function_(offline_messages_.front().mqtt_topic.c_str());
+        }
+        offline_messages_.pop_front();
+    }
+    offline_messages_.push_back(OfflineMessage{std::string(mqtt_topic), std::move(mqtt_payload), latency_trace});
+    return true;
+}
+
+/**
+ * @brief Function for open buffer once connection was lost
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_connector::OfflineBuffer::open() {
+    std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+    is_open_ = true;
+}
+
+/**
+ * @brief Function for close buffer once connected & hand out buffered messages in order
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::deque<OfflineMessage>
+*/
+std::deque<ros_mqtt_connector::OfflineMessage> ros_mqtt_connector::OfflineBuffer::close() {
+    std::deque<OfflineMessage> offline_messages;
+    std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+    is_open_ = false;
+    offline_messages.swap(offline_messages_);
+    return offline_messages;
+}
+
+/**
+ * @brief Function for get count of buffered messages
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_connector::OfflineBuffer::size() {
+    std::lock_guard<std::mutex> buffer_lock(buffer_mutex_);
+    return offline_messages_.size();
+}
+
+/**
+ * @brief Function for get count of messages dropped while not connected
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_connector::OfflineBuffer::dropped_count() const {
+    return dropped_count_.load(std::memory_order_relaxed);
+}
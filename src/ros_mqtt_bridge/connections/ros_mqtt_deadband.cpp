@@ -0,0 +1,206 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_deadband.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param thresholds const DeadbandThresholds&
+*/
+ros_mqtt_deadband::DeadbandFilter::DeadbandFilter(const DeadbandThresholds& thresholds)
+: thresholds_(thresholds),
+last_sample_(identity_sample()),
+is_sample_passed_(false),
+suppressed_count_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_deadband::DeadbandFilter::~DeadbandFilter() {
+
+}
+
+/**
+ * @brief Function for check whether message passes deadband, a passed message becomes the one next messages are compared with
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param motion_sample const MotionSample&
+ * @param received std::chrono::steady_clock::time_point when message was received
+ * @return bool true for first message, changes beyond thresholds, stops & heartbeats
+*/
+bool ros_mqtt_deadband::DeadbandFilter::is_passed(const MotionSample& motion_sample, std::chrono::steady_clock::time_point received) {
+    const bool is_heartbeat = thresholds_.heartbeat.count() > 0 && received - last_passed_ >= thresholds_.heartbeat;
+    const bool is_stopped = is_zero_velocity(motion_sample) && !is_zero_velocity(last_sample_);
+    if(is_sample_passed_ && !is_heartbeat && !is_stopped && !is_changed(motion_sample)) {
+        suppressed_count_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    last_sample_ = motion_sample;
+    last_passed_ = received;
+    is_sample_passed_ = true;
+    return true;
+}
+
+/**
+ * @brief Function for get count of suppressed messages
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_deadband::DeadbandFilter::suppressed_count() const {
+    return suppressed_count_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for check whether sample changed beyond a threshold since last passed sample
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param motion_sample const MotionSample&
+ * @return bool
+*/
+bool ros_mqtt_deadband::DeadbandFilter::is_changed(const MotionSample& motion_sample) const {
+    return distance(motion_sample.position, last_sample_.position) > thresholds_.translation
+        || rotation_angle(motion_sample.orientation, last_sample_.orientation) > thresholds_.rotation
+        || distance(motion_sample.linear, last_sample_.linear) > thresholds_.velocity
+        || distance(motion_sample.angular, last_sample_.angular) > thresholds_.velocity;
+}
+
+/**
+ * @brief Function for make sample at origin with identity orientation & zero velocity
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return MotionSample
+*/
+ros_mqtt_deadband::MotionSample ros_mqtt_deadband::identity_sample() {
+    const MotionSample motion_sample{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 1.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+    return motion_sample;
+}
+
+/**
+ * @brief Function for make sample of pose
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param pose_msgs const geometry_msgs::msg::Pose&
+ * @return MotionSample
+*/
+ros_mqtt_deadband::MotionSample ros_mqtt_deadband::to_sample(const geometry_msgs::msg::Pose& pose_msgs) {
+    MotionSample motion_sample = identity_sample();
+    motion_sample.position[0] = pose_msgs.position.x;
+    motion_sample.position[1] = pose_msgs.position.y;
+    motion_sample.position[2] = pose_msgs.position.z;
+    motion_sample.orientation[0] = pose_msgs.orientation.x;
+    motion_sample.orientation[1] = pose_msgs.orientation.y;
+    motion_sample.orientation[2] = pose_msgs.orientation.z;
+    motion_sample.orientation[3] = pose_msgs.orientation.w;
+    return motion_sample;
+}
+
+/**
+ * @brief Function for make sample of twist
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param twist_msgs const geometry_msgs::msg::Twist&
+ * @return MotionSample
+*/
+ros_mqtt_deadband::MotionSample ros_mqtt_deadband::to_sample(const geometry_msgs::msg::Twist& twist_msgs) {
+    MotionSample motion_sample = identity_sample();
+    motion_sample.linear[0] = twist_msgs.linear.x;
+    motion_sample.linear[1] = twist_msgs.linear.y;
+    motion_sample.linear[2] = twist_msgs.linear.z;
+    motion_sample.angular[0] = twist_msgs.angular.x;
+    motion_sample.angular[1] = twist_msgs.angular.y;
+    motion_sample.angular[2] = twist_msgs.angular.z;
+    return motion_sample;
+}
+
+/**
+ * @brief Function for make sample of odometry pose & twist
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param odom_msgs const nav_msgs::msg::Odometry&
+ * @return MotionSample
+*/
+ros_mqtt_deadband::MotionSample ros_mqtt_deadband::to_sample(const nav_msgs::msg::Odometry& odom_msgs) {
+    MotionSample motion_sample = to_sample(odom_msgs.pose.pose);
+    const MotionSample twist_sample = to_sample(odom_msgs.twist.twist);
+    std::copy(twist_sample.linear, twist_sample.linear + 3, motion_sample.linear);
+    std::copy(twist_sample.angular, twist_sample.angular + 3, motion_sample.angular);
+    return motion_sample;
+}
+
+/**
+ * @brief Function for get euclidean distance of two 3d vectors
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param first_vector const double * 3 elements
+ * @param second_vector const double * 3 elements
+ * @return double
+*/
+double ros_mqtt_deadband::distance(const double * first_vector, const double * second_vector) {
+    const double delta_x = first_vector[0] - second_vector[0];
+    const double delta_y = first_vector[1] - second_vector[1];
+    const double delta_z = first_vector[2] - second_vector[2];
+    return std::sqrt(delta_x * delta_x + delta_y * delta_y + delta_z * delta_z);
+}
+
+/**
+ * @brief Function for get angle of rotation between two orientations
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param first_quaternion const double * x, y, z, w
+ * @param second_quaternion const double * x, y, z, w
+ * @return double radians in [0, pi], quaternions are normalized first & an all zero quaternion(unset orientation) only equals another one
+*/
+double ros_mqtt_deadband::rotation_angle(const double * first_quaternion, const double * second_quaternion) {
+    double first_norm = 0.0;
+    double second_norm = 0.0;
+    double quaternion_dot = 0.0;
+    for(std::size_t i = 0; i < 4; i++) {
+        first_norm += first_quaternion[i] * first_quaternion[i];
+        second_norm += second_quaternion[i] * second_quaternion[i];
+        quaternion_dot += first_quaternion[i] * second_quaternion[i];
+    }
+    if(first_norm == 0.0 || second_norm == 0.0) {
+        return first_norm == second_norm ? 0.0 : M_PI;
+    }
+
+    const double cosine = std::min(1.0, std::fabs(quaternion_dot) / std::sqrt(first_norm * second_norm));
+    return 2.0 * std::acos(cosine);
+}
+
+/**
+ * @brief Function for check whether sample has no linear & angular velocity
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param motion_sample const MotionSample&
+ * @return bool
+*/
+bool ros_mqtt_deadband::is_zero_velocity(const MotionSample& motion_sample) {
+    for(std::size_t i = 0; i < 3; i++) {
+        if(motion_sample.linear[i] != 0.0 || motion_sample.angular[i] != 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
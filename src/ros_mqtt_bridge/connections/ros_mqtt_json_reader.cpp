@@ -0,0 +1,727 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_json_reader.hpp"
+
+#include <cstdlib>
+#include <clocale>
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_json_reader::JsonPath::JsonPath()
+: depth_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_json_reader::JsonPath::~JsonPath() {
+
+}
+
+/**
+ * @brief Function for get depth of current value, 0 is root
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_json_reader::JsonPath::depth() const {
+    return depth_;
+}
+
+/**
+ * @brief Function for get array index of path segment
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param depth std::size_t
+ * @return std::size_t
+*/
+std::size_t ros_json_reader::JsonPath::index(std::size_t depth) const {
+    return segments_[depth].index;
+}
+
+/**
+ * @brief Function for check path segment is array element
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param depth std::size_t
+ * @return bool
+*/
+bool ros_json_reader::JsonPath::is_index(std::size_t depth) const {
+    return segments_[depth].is_array;
+}
+
+/**
+ * @brief Function for push object key which points into JSON input
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param key const char *
+ * @param key_size std::size_t
+ * @return void
+*/
+void ros_json_reader::JsonPath::push_key(const char * key, std::size_t key_size) {
+    segments_[depth_] = JsonPathSegment{key, key_size, 0, false};
+    depth_++;
+}
+
+/**
+ * @brief Function for push object key that had escapes, copied since reader's key buffer is reused
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param escaped_key const std::string&
+ * @return void
+*/
+void ros_json_reader::JsonPath::push_escaped_key(const std::string& escaped_key) {
+    escaped_keys_[depth_] = escaped_key;
+    segments_[depth_] = JsonPathSegment{escaped_keys_[depth_].data(), escaped_keys_[depth_].size(), 0, false};
+    depth_++;
+}
+
+/**
+ * @brief Function for push array segment starting at index 0
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_json_reader::JsonPath::push_array() {
+    segments_[depth_] = JsonPathSegment{nullptr, 0, 0, true};
+    depth_++;
+}
+
+/**
+ * @brief Function for advance index of innermost array segment
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_json_reader::JsonPath::next_index() {
+    segments_[depth_ - 1].index++;
+}
+
+/**
+ * @brief Function for pop innermost segment
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_json_reader::JsonPath::pop() {
+    depth_--;
+}
+
+/**
+ * @brief Function for check path segment is object key equal to given key
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param depth std::size_t
+ * @param key const char *
+ * @return bool
+*/
+bool ros_json_reader::JsonPath::is_key(std::size_t depth, const char * key) const {
+    const JsonPathSegment& path_segment = segments_[depth];
+    return !path_segment.is_array
+        && std::strncmp(path_segment.key, key, path_segment.key_size) == 0
+        && key[path_segment.key_size] == '\0';
+}
+
+/**
+ * @brief Function for terminate variadic key comparison
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param depth std::size_t
+ * @return bool
+*/
+bool ros_json_reader::JsonPath::is_from(std::size_t depth) const {
+    (void) depth;
+    return true;
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_json_reader::JsonHandler::JsonHandler() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_json_reader::JsonHandler::~JsonHandler() {
+
+}
+
+void ros_json_reader::JsonHandler::on_begin_object(const JsonPath& json_path) {
+    (void) json_path;
+}
+
+void ros_json_reader::JsonHandler::on_end_object(const JsonPath& json_path) {
+    (void) json_path;
+}
+
+void ros_json_reader::JsonHandler::on_begin_array(const JsonPath& json_path) {
+    (void) json_path;
+}
+
+void ros_json_reader::JsonHandler::on_end_array(const JsonPath& json_path, std::size_t array_size) {
+    (void) json_path;
+    (void) array_size;
+}
+
+void ros_json_reader::JsonHandler::on_null(const JsonPath& json_path) {
+    (void) json_path;
+}
+
+void ros_json_reader::JsonHandler::on_bool(const JsonPath& json_path, bool bool_value) {
+    (void) json_path;
+    (void) bool_value;
+}
+
+void ros_json_reader::JsonHandler::on_number(const JsonPath& json_path, double number_value) {
+    (void) json_path;
+    (void) number_value;
+}
+
+void ros_json_reader::JsonHandler::on_string(const JsonPath& json_path, const char * string_value, std::size_t string_size) {
+    (void) json_path;
+    (void) string_value;
+    (void) string_size;
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_json_reader::JsonReader::JsonReader()
+: cursor_(nullptr),
+end_(nullptr),
+error_offset_(0),
+begin_(nullptr) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_json_reader::JsonReader::~JsonReader() {
+
+}
+
+/**
+ * @brief Function for parse JSON text & dispatch its values into json handler
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_data const char *
+ * @param json_size std::size_t
+ * @param json_handler JsonHandler&
+ * @return bool false on malformed JSON, values before the error offset were already dispatched
+*/
+bool ros_json_reader::JsonReader::parse(const char * json_data, std::size_t json_size, JsonHandler& json_handler) {
+    begin_ = json_data;
+    cursor_ = json_data;
+    end_ = json_data + json_size;
+    error_offset_ = 0;
+    while(json_path_.depth() > 0) {
+        json_path_.pop();
+    }
+
+    skip_whitespace();
+    if(!parse_value(json_handler)) {
+        return false;
+    }
+    skip_whitespace();
+    if(cursor_ != end_) {
+        return fail();
+    }
+    return true;
+}
+
+/**
+ * @brief Function for parse JSON string & dispatch its values into json handler
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_string const std::string&
+ * @param json_handler JsonHandler&
+ * @return bool
+*/
+bool ros_json_reader::JsonReader::parse(const std::string& json_string, JsonHandler& json_handler) {
+    return this->parse(json_string.data(), json_string.size(), json_handler);
+}
+
+/**
+ * @brief Function for get byte offset where last parse failed
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_json_reader::JsonReader::error_offset() const {
+    return error_offset_;
+}
+
+/**
+ * @brief Function for record error offset
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool always false
+*/
+bool ros_json_reader::JsonReader::fail() {
+    error_offset_ = static_cast<std::size_t>(cursor_ - begin_);
+    return false;
+}
+
+/**
+ * @brief Function for skip JSON whitespace
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_json_reader::JsonReader::skip_whitespace() {
+    while(cursor_ != end_ && (*cursor_ == ' ' || *cursor_ == '\n' || *cursor_ == '\r' || *cursor_ == '\t')) {
+        cursor_++;
+    }
+}
+
+/**
+ * @brief Function for parse any JSON value at cursor
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_handler JsonHandler&
+ * @return bool
+*/
+bool ros_json_reader::JsonReader::parse_value(JsonHandler& json_handler) {
+    if(cursor_ == end_) {
+        return fail();
+    }
+
+    switch(*cursor_) {
+        case '{' :
+            return parse_object(json_handler);
+        case '[' :
+            return parse_array(json_handler);
+        case '"' : {
+            const char * string_value = nullptr;
+            std::size_t string_size = 0;
+            if(!parse_string(string_buffer_, string_value, string_size)) {
+                return false;
+            }
+            json_handler.on_string(json_path_, string_value, string_size);
+            return true;
+        }
+        case 't' :
+            if(!parse_literal("true", 4)) {
+                return false;
+            }
+            json_handler.on_bool(json_path_, true);
+            return true;
+        case 'f' :
+            if(!parse_literal("false", 5)) {
+                return false;
+            }
+            json_handler.on_bool(json_path_, false);
+            return true;
+        case 'n' :
+            if(!parse_literal("null", 4)) {
+                return false;
+            }
+            json_handler.on_null(json_path_);
+            return true;
+        default : {
+            double number_value = 0.0;
+            if(!parse_number(number_value)) {
+                return false;
+            }
+            json_handler.on_number(json_path_, number_value);
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Function for parse JSON object at cursor, pushing each key into json path
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_handler JsonHandler&
+ * @return bool
+*/
+bool ros_json_reader::JsonReader::parse_object(JsonHandler& json_handler) {
+    if(json_path_.depth() >= JSON_READER_MAX_DEPTH) {
+        return fail();
+    }
+
+    cursor_++;
+    json_handler.on_begin_object(json_path_);
+    skip_whitespace();
+
+    if(cursor_ != end_ && *cursor_ == '}') {
+        cursor_++;
+        json_handler.on_end_object(json_path_);
+        return true;
+    }
+
+    while(true) {
+        skip_whitespace();
+        if(cursor_ == end_ || *cursor_ != '"') {
+            return fail();
+        }
+
+        const char * key = nullptr;
+        std::size_t key_size = 0;
+        if(!parse_string(key_buffer_, key, key_size)) {
+            return false;
+        }
+        if(key == key_buffer_.data()) {
+            json_path_.push_escaped_key(key_buffer_);
+        } else {
+            json_path_.push_key(key, key_size);
+        }
+
+        skip_whitespace();
+        if(cursor_ == end_ || *cursor_ != ':') {
+            return fail();
+        }
+        cursor_++;
+        skip_whitespace();
+
+        if(!parse_value(json_handler)) {
+            return false;
+        }
+        json_path_.pop();
+
+        skip_whitespace();
+        if(cursor_ == end_) {
+            return fail();
+        }
+        if(*cursor_ == ',') {
+            cursor_++;
+            continue;
+        }
+        if(*cursor_ == '}') {
+            cursor_++;
+            json_handler.on_end_object(json_path_);
+            return true;
+        }
+        return fail();
+    }
+}
+
+/**
+ * @brief Function for parse JSON array at cursor, pushing element index into json path
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_handler JsonHandler&
+ * @return bool
+*/
+bool ros_json_reader::JsonReader::parse_array(JsonHandler& json_handler) {
+    if(json_path_.depth() >= JSON_READER_MAX_DEPTH) {
+        return fail();
+    }
+
+    cursor_++;
+    json_handler.on_begin_array(json_path_);
+    skip_whitespace();
+
+    if(cursor_ != end_ && *cursor_ == ']') {
+        cursor_++;
+        json_handler.on_end_array(json_path_, 0);
+        return true;
+    }
+
+    json_path_.push_array();
+    std::size_t array_size = 0;
+
+    while(true) {
+        skip_whitespace();
+        if(!parse_value(json_handler)) {
+            return false;
+        }
+        array_size++;
+
+        skip_whitespace();
+        if(cursor_ == end_) {
+            return fail();
+        }
+        if(*cursor_ == ',') {
+            cursor_++;
+            json_path_.next_index();
+            continue;
+        }
+        if(*cursor_ == ']') {
+            cursor_++;
+            json_path_.pop();
+            json_handler.on_end_array(json_path_, array_size);
+            return true;
+        }
+        return fail();
+    }
+}
+
+/**
+ * @brief Function for parse JSON string at cursor
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param scratch_buffer std::string& used only when string has escapes
+ * @param string_value const char *& points into input, or into scratch_buffer when string has escapes
+ * @param string_size std::size_t&
+ * @return bool
+*/
+bool ros_json_reader::JsonReader::parse_string(std::string& scratch_buffer, const char *& string_value, std::size_t& string_size) {
+    cursor_++;
+    const char * string_begin = cursor_;
+
+    while(cursor_ != end_ && *cursor_ != '"' && *cursor_ != '\\') {
+        if(static_cast<unsigned char>(*cursor_) < 0x20) {
+            return fail();
+        }
+        cursor_++;
+    }
+    if(cursor_ == end_) {
+        return fail();
+    }
+    if(*cursor_ == '"') {
+        string_value = string_begin;
+        string_size = static_cast<std::size_t>(cursor_ - string_begin);
+        cursor_++;
+        return true;
+    }
+
+    scratch_buffer.assign(string_begin, cursor_);
+    while(cursor_ != end_ && *cursor_ != '"') {
+        if(*cursor_ != '\\') {
+            if(static_cast<unsigned char>(*cursor_) < 0x20) {
+                return fail();
+            }
+            scratch_buffer += *cursor_;
+            cursor_++;
+            continue;
+        }
+
+        cursor_++;
+        if(cursor_ == end_) {
+            return fail();
+        }
+        switch(*cursor_) {
+            case '"' : scratch_buffer += '"'; break;
+            case '\\' : scratch_buffer += '\\'; break;
+            case '/' : scratch_buffer += '/'; break;
+            case 'b' : scratch_buffer += '\b'; break;
+            case 'f' : scratch_buffer += '\f'; break;
+            case 'n' : scratch_buffer += '\n'; break;
+            case 'r' : scratch_buffer += '\r'; break;
+            case 't' : scratch_buffer += '\t'; break;
+            case 'u' : {
+                uint32_t code_point = 0;
+                for(int surrogate = 0; surrogate < 2; surrogate++) {
+                    if(end_ - cursor_ < 5) {
+                        return fail();
+                    }
+                    uint32_t code_unit = 0;
+                    for(int i = 1; i <= 4; i++) {
+                        const char hex_digit = cursor_[i];
+                        code_unit <<= 4;
+                        if(hex_digit >= '0' && hex_digit <= '9') {
+                            code_unit |= static_cast<uint32_t>(hex_digit - '0');
+                        } else if(hex_digit >= 'a' && hex_digit <= 'f') {
+                            code_unit |= static_cast<uint32_t>(hex_digit - 'a' + 10);
+                        } else if(hex_digit >= 'A' && hex_digit <= 'F') {
+                            code_unit |= static_cast<uint32_t>(hex_digit - 'A' + 10);
+                        } else {
+                            return fail();
+                        }
+                    }
+                    cursor_ += 4;
+
+                    if(surrogate == 0) {
+                        code_point = code_unit;
+                        if(code_unit < 0xD800 || code_unit > 0xDBFF) {
+                            break;
+                        }
+                        if(end_ - cursor_ < 7 || cursor_[1] != '\\' || cursor_[2] != 'u') {
+                            return fail();
+                        }
+                        cursor_ += 2;
+                    } else {
+                        if(code_unit < 0xDC00 || code_unit > 0xDFFF) {
+                            return fail();
+                        }
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (code_unit - 0xDC00);
+                    }
+                }
+
+                if(code_point < 0x80) {
+                    scratch_buffer += static_cast<char>(code_point);
+                } else if(code_point < 0x800) {
+                    scratch_buffer += static_cast<char>(0xC0 | (code_point >> 6));
+                    scratch_buffer += static_cast<char>(0x80 | (code_point & 0x3F));
+                } else if(code_point < 0x10000) {
+                    scratch_buffer += static_cast<char>(0xE0 | (code_point >> 12));
+                    scratch_buffer += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                    scratch_buffer += static_cast<char>(0x80 | (code_point & 0x3F));
+                } else {
+                    scratch_buffer += static_cast<char>(0xF0 | (code_point >> 18));
+                    scratch_buffer += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+                    scratch_buffer += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                    scratch_buffer += static_cast<char>(0x80 | (code_point & 0x3F));
+                }
+                break;
+            }
+            default :
+                return fail();
+        }
+        cursor_++;
+    }
+    if(cursor_ == end_) {
+        return fail();
+    }
+
+    cursor_++;
+    string_value = scratch_buffer.data();
+    string_size = scratch_buffer.size();
+    return true;
+}
+
+/**
+ * @brief Function for parse JSON number at cursor
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param number_value double&
+ * @return bool
+ * @details numbers with up to 15 significant digits & small exponents are exact with one multiply or divide,
+ * others fall back to strtod on a locale independent copy
+*/
+bool ros_json_reader::JsonReader::parse_number(double& number_value) {
+    static const double powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char * number_begin = cursor_;
+    bool is_negative = false;
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int decimal_exponent = 0;
+
+    if(*cursor_ == '-') {
+        is_negative = true;
+        cursor_++;
+    }
+    if(cursor_ == end_ || *cursor_ < '0' || *cursor_ > '9') {
+        return fail();
+    }
+
+    if(*cursor_ == '0') {
+        cursor_++;
+    } else {
+        while(cursor_ != end_ && *cursor_ >= '0' && *cursor_ <= '9') {
+            if(significant_digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor_ - '0');
+                significant_digits++;
+            } else {
+                decimal_exponent++;
+                significant_digits++;
+            }
+            cursor_++;
+        }
+    }
+
+    if(cursor_ != end_ && *cursor_ == '.') {
+        cursor_++;
+        if(cursor_ == end_ || *cursor_ < '0' || *cursor_ > '9') {
+            return fail();
+        }
+        while(cursor_ != end_ && *cursor_ >= '0' && *cursor_ <= '9') {
+            if(significant_digits < 19) {
+                if(mantissa != 0 || *cursor_ != '0') {
+                    significant_digits++;
+                }
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor_ - '0');
+                decimal_exponent--;
+            } else {
+                significant_digits++;
+            }
+            cursor_++;
+        }
+    }
+
+    if(cursor_ != end_ && (*cursor_ == 'e' || *cursor_ == 'E')) {
+        cursor_++;
+        bool is_exponent_negative = false;
+        if(cursor_ != end_ && (*cursor_ == '+' || *cursor_ == '-')) {
+            is_exponent_negative = *cursor_ == '-';
+            cursor_++;
+        }
+        if(cursor_ == end_ || *cursor_ < '0' || *cursor_ > '9') {
+            return fail();
+        }
+        int exponent = 0;
+        while(cursor_ != end_ && *cursor_ >= '0' && *cursor_ <= '9') {
+            if(exponent < 100000) {
+                exponent = exponent * 10 + (*cursor_ - '0');
+            }
+            cursor_++;
+        }
+        decimal_exponent += is_exponent_negative ? -exponent : exponent;
+    }
+
+    if(significant_digits <= 15 && decimal_exponent >= -22 && decimal_exponent <= 22) {
+        number_value = static_cast<double>(mantissa);
+        if(decimal_exponent < 0) {
+            number_value /= powers_of_ten[-decimal_exponent];
+        } else {
+            number_value *= powers_of_ten[decimal_exponent];
+        }
+        if(is_negative) {
+            number_value = -number_value;
+        }
+        return true;
+    }
+
+    std::string number_string(number_begin, cursor_);
+    const char decimal_point = std::localeconv()->decimal_point[0];
+    if(decimal_point != '.') {
+        for(char& number_char : number_string) {
+            if(number_char == '.') {
+                number_char = decimal_point;
+            }
+        }
+    }
+    number_value = std::strtod(number_string.c_str(), nullptr);
+    return true;
+}
+
+/**
+ * @brief Function for parse JSON literal(true, false, null) at cursor
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param literal const char *
+ * @param literal_size std::size_t
+ * @return bool
+*/
+bool ros_json_reader::JsonReader::parse_literal(const char * literal, std::size_t literal_size) {
+    if(static_cast<std::size_t>(end_ - cursor_) < literal_size || std::memcmp(cursor_, literal, literal_size) != 0) {
+        return fail();
+    }
+    cursor_ += literal_size;
+    return true;
+}
@@ -0,0 +1,131 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_last_value_cache.hpp"
+
+#include <vector>
+#include <jsoncpp/json/json.h>
+
+/**
+ * include ros_mqtt_compressor's header file
+ * @see ros_mqtt_compression::decompress
+*/
+#include "ros_mqtt_bridge/connections/ros_mqtt_compressor.hpp"
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_cache::LastValueCache::LastValueCache() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_cache::LastValueCache::~LastValueCache() {
+
+}
+
+/**
+ * @brief Function for replace last payload of mqtt topic with wall clock time of now
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param mqtt_payload const std::string& copied, so caller still publishes it
+ * @return void
+*/
+void ros_mqtt_cache::LastValueCache::store(const char * mqtt_topic, const std::string& mqtt_payload) {
+    const std::chrono::system_clock::time_point store_time = std::chrono::system_clock::now();
+    const int64_t store_stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(store_time.time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+    std::map<std::string, CachedEntry, std::less<>>::iterator cached_entry = cached_entries_.find(mqtt_topic);
+    if(cached_entry == cached_entries_.end()) {
+        cached_entry = cached_entries_.emplace(mqtt_topic, CachedEntry{std::string(), 0}).first;
+    }
+    cached_entry->second.payload.assign(mqtt_payload);
+    cached_entry->second.stamp = store_stamp;
+}
+
+/**
+ * @brief Function for get count of cached topics
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_cache::LastValueCache::size() {
+    std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+    return cached_entries_.size();
+}
+
+/**
+ * @brief Function for serialize every cached topic into one envelope JSON, shaped like the batch envelope
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::string {"count":..,"entries":[{"topic":..,"stamp":..,"payload":..}]}
+ * @details entries are copied out under the mutex & serialized after, so publishers are not held up by large maps.
+ * compressed payloads are decompressed, JSON payloads are spliced in as-is & other payloads are written as JSON strings
+*/
+std::string ros_mqtt_cache::LastValueCache::snapshot() {
+    std::vector<std::pair<std::string, CachedEntry>> snapshot_entries;
+    {
+        std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+        snapshot_entries.reserve(cached_entries_.size());
+        for(const std::pair<const std::string, CachedEntry>& cached_entry : cached_entries_) {
+            snapshot_entries.push_back(cached_entry);
+        }
+    }
+
+    std::size_t envelope_size = 32;
+    for(const std::pair<std::string, CachedEntry>& snapshot_entry : snapshot_entries) {
+        envelope_size += snapshot_entry.first.size() + snapshot_entry.second.payload.size() + 64;
+    }
+
+    std::string envelope;
+    envelope.reserve(envelope_size);
+    envelope += "{\"count\":";
+    envelope += std::to_string(snapshot_entries.size());
+    envelope += ",\"entries\":[";
+
+    std::string raw_payload;
+    for(std::size_t i = 0; i < snapshot_entries.size(); i++) {
+        const std::pair<std::string, CachedEntry>& snapshot_entry = snapshot_entries[i];
+        const std::string * entry_payload = &snapshot_entry.second.payload;
+        if(ros_mqtt_compression::is_compressed(*entry_payload) && ros_mqtt_compression::decompress(*entry_payload, raw_payload)) {
+            entry_payload = &raw_payload;
+        }
+
+        if(i > 0) {
+            envelope += ',';
+        }
+        envelope += "{\"topic\":\"";
+        envelope += snapshot_entry.first;
+        envelope += "\",\"stamp\":";
+        envelope += std::to_string(snapshot_entry.second.stamp);
+        envelope += ",\"payload\":";
+        if(!entry_payload->empty() && (entry_payload->front() == '{' || entry_payload->front() == '[')) {
+            envelope += *entry_payload;
+        } else {
+            envelope += Json::valueToQuotedString(entry_payload->c_str());
+        }
+        envelope += '}';
+    }
+
+    envelope += "]}";
+    return envelope;
+}
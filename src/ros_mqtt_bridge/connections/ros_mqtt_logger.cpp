@@ -0,0 +1,364 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_logger.hpp"
+
+#include <ctime>
+
+/**
+ * @brief Constructor for initialize ring buffer & start log thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param capacity std::size_t rounded up to power of two
+*/
+ros_mqtt_logger::Logger::Logger(std::size_t capacity)
+: capacity_([capacity]() {
+    std::size_t power_of_two = 2;
+    while(power_of_two < capacity) {
+        power_of_two <<= 1;
+    }
+    return power_of_two;
+}()),
+log_records_(nullptr),
+enqueue_position_(0),
+dequeue_position_(0),
+dropped_records_(0),
+log_level_(static_cast<uint8_t>(LogLevel::INFO)),
+is_payload_enabled_(false),
+is_running_(true) {
+    default_sampler_.sample_rate = 1;
+    default_sampler_.sample_counter.store(0, std::memory_order_relaxed);
+    log_records_ = new LogRecord[capacity_];
+    for(std::size_t i = 0; i < capacity_; i++) {
+        log_records_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    log_thread_ = std::thread(&Logger::run, this);
+}
+
+/**
+ * @brief Virtual Destructor for this class, drain remaining records & join log thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_logger::Logger::~Logger() {
+    this->stop();
+    for(std::pair<const std::string, TopicSampler *>& topic_sampler : topic_samplers_) {
+        delete topic_sampler.second;
+    }
+    delete[] log_records_;
+}
+
+/**
+ * @brief Function for get process wide logger, created on first use
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return Logger&
+*/
+ros_mqtt_logger::Logger& ros_mqtt_logger::Logger::instance() {
+    static Logger logger(LOG_RING_CAPACITY);
+    return logger;
+}
+
+/**
+ * @brief Function for check log level is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param log_level LogLevel
+ * @return bool
+*/
+bool ros_mqtt_logger::Logger::is_enabled(LogLevel log_level) const {
+    return static_cast<uint8_t>(log_level) >= log_level_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for check payload dumping is enabled, implies DEBUG level
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool
+*/
+bool ros_mqtt_logger::Logger::is_payload_enabled() const {
+    return is_payload_enabled_.load(std::memory_order_relaxed) && is_enabled(LogLevel::DEBUG);
+}
+
+/**
+ * @brief Function for decide whether current record of log topic is kept
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param log_topic const std::string&
+ * @return bool
+*/
+bool ros_mqtt_logger::Logger::should_sample(const std::string& log_topic) {
+    std::map<std::string, TopicSampler *>::const_iterator topic_sampler = topic_samplers_.find(log_topic);
+    if(topic_sampler == topic_samplers_.end()) {
+        return sample(default_sampler_);
+    }
+    return sample(*topic_sampler->second);
+}
+
+/**
+ * @brief Function for count record on sampler & keep 1 of every sample rate records
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param topic_sampler TopicSampler&
+ * @return bool
+*/
+bool ros_mqtt_logger::Logger::sample(TopicSampler& topic_sampler) {
+    if(topic_sampler.sample_rate <= 1) {
+        return topic_sampler.sample_rate == 1;
+    }
+    return topic_sampler.sample_counter.fetch_add(1, std::memory_order_relaxed) % topic_sampler.sample_rate == 0;
+}
+
+/**
+ * @brief Function for set minimum log level
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param log_level LogLevel
+ * @return void
+*/
+void ros_mqtt_logger::Logger::set_level(LogLevel log_level) {
+    log_level_.store(static_cast<uint8_t>(log_level), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for enable or disable payload dumping
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param is_payload_enabled bool
+ * @return void
+*/
+void ros_mqtt_logger::Logger::set_payload_enabled(bool is_payload_enabled) {
+    is_payload_enabled_.store(is_payload_enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for set sample rate shared by topics without their own rate
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param sample_rate uint32_t
+ * @return void
+*/
+void ros_mqtt_logger::Logger::set_default_sample_rate(uint32_t sample_rate) {
+    default_sampler_.sample_rate = sample_rate;
+}
+
+/**
+ * @brief Function for keep 1 of every sample_rate records of log topic, 0 drops all of them
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param log_topic const std::string&
+ * @param sample_rate uint32_t
+ * @return void
+*/
+void ros_mqtt_logger::Logger::set_topic_sample_rate(const std::string& log_topic, uint32_t sample_rate) {
+    std::map<std::string, TopicSampler *>::iterator topic_sampler = topic_samplers_.find(log_topic);
+    if(topic_sampler == topic_samplers_.end()) {
+        TopicSampler * new_topic_sampler = new TopicSampler();
+        new_topic_sampler->sample_rate = sample_rate;
+        new_topic_sampler->sample_counter.store(0, std::memory_order_relaxed);
+        topic_samplers_[log_topic] = new_topic_sampler;
+    } else {
+        topic_sampler->second->sample_rate = sample_rate;
+    }
+}
+
+/**
+ * @brief Function for claim free ring buffer slot
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param record_position std::size_t&
+ * @return LogRecord * nullptr when ring buffer is full
+*/
+ros_mqtt_logger::Logger::LogRecord * ros_mqtt_logger::Logger::acquire_record(std::size_t& record_position) {
+    record_position = enqueue_position_.load(std::memory_order_relaxed);
+
+    while(true) {
+        LogRecord * log_record = &log_records_[record_position & (capacity_ - 1)];
+        const std::size_t sequence = log_record->sequence.load(std::memory_order_acquire);
+        const intptr_t sequence_difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(record_position);
+
+        if(sequence_difference == 0) {
+            if(enqueue_position_.compare_exchange_weak(record_position, record_position + 1, std::memory_order_relaxed)) {
+                return log_record;
+            }
+        } else if(sequence_difference < 0) {
+            dropped_records_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            record_position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Function for publish filled slot to log thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param log_record LogRecord *
+ * @param record_position std::size_t
+ * @return void
+*/
+void ros_mqtt_logger::Logger::commit_record(LogRecord * log_record, std::size_t record_position) {
+    log_record->sequence.store(record_position + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Function for format record into ring buffer, never blocks
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param log_level LogLevel
+ * @param log_format const char * printf style format
+ * @return void
+*/
+void ros_mqtt_logger::Logger::log(LogLevel log_level, const char * log_format, ...) {
+    std::size_t record_position = 0;
+    LogRecord * log_record = acquire_record(record_position);
+    if(log_record == nullptr) {
+        return;
+    }
+
+    log_record->level = log_level;
+    log_record->stamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    va_list log_arguments;
+    va_start(log_arguments, log_format);
+    const int formatted_size = std::vsnprintf(log_record->message, LOG_MESSAGE_SIZE, log_format, log_arguments);
+    va_end(log_arguments);
+
+    if(formatted_size < 0) {
+        log_record->message_size = 0;
+    } else if(static_cast<std::size_t>(formatted_size) >= LOG_MESSAGE_SIZE) {
+        log_record->message_size = LOG_MESSAGE_SIZE - 1;
+        log_record->message[LOG_MESSAGE_SIZE - 4] = '.';
+        log_record->message[LOG_MESSAGE_SIZE - 3] = '.';
+        log_record->message[LOG_MESSAGE_SIZE - 2] = '.';
+    } else {
+        log_record->message_size = static_cast<std::size_t>(formatted_size);
+    }
+
+    commit_record(log_record, record_position);
+}
+
+/**
+ * @brief Function for dump head of payload at DEBUG level
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param log_topic const std::string&
+ * @param log_payload const std::string&
+ * @return void
+ * @details only LOG_PAYLOAD_MAX_BYTES are kept, non printable bytes(binary encodings) are written as '.'
+*/
+void ros_mqtt_logger::Logger::log_payload(const std::string& log_topic, const std::string& log_payload) {
+    char payload_head[LOG_PAYLOAD_MAX_BYTES + 1];
+    const std::size_t payload_head_size = log_payload.size() < LOG_PAYLOAD_MAX_BYTES ? log_payload.size() : LOG_PAYLOAD_MAX_BYTES;
+    for(std::size_t i = 0; i < payload_head_size; i++) {
+        const unsigned char payload_char = static_cast<unsigned char>(log_payload[i]);
+        payload_head[i] = (payload_char >= 0x20 && payload_char < 0x7F) ? static_cast<char>(payload_char) : '.';
+    }
+    payload_head[payload_head_size] = '\0';
+
+    this->log(LogLevel::DEBUG, "%s payload(%zu bytes) : %s%s", log_topic.c_str(), log_payload.size(), payload_head, log_payload.size() > payload_head_size ? "..." : "");
+}
+
+/**
+ * @brief Function for get count of records dropped because ring buffer was full
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_logger::Logger::dropped_records() const {
+    return dropped_records_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for stop log thread after remaining records are written
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_logger::Logger::stop() {
+    is_running_.store(false, std::memory_order_release);
+    if(log_thread_.joinable()) {
+        log_thread_.join();
+    }
+}
+
+/**
+ * @brief Function for write every committed record, WARN & ERROR into stderr & others into stdout
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool true when any record was written
+*/
+bool ros_mqtt_logger::Logger::drain() {
+    static const char * log_level_names[] = {"DEBUG", "INFO", "WARN", "ERROR", "OFF"};
+    bool is_drained = false;
+
+    while(true) {
+        LogRecord * log_record = &log_records_[dequeue_position_ & (capacity_ - 1)];
+        if(log_record->sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+            break;
+        }
+
+        const std::time_t stamp_seconds = static_cast<std::time_t>(log_record->stamp / 1000000);
+        std::tm stamp_time;
+        localtime_r(&stamp_seconds, &stamp_time);
+        char stamp_string[32];
+        std::strftime(stamp_string, sizeof(stamp_string), "%H:%M:%S", &stamp_time);
+
+        FILE * log_stream = log_record->level >= LogLevel::WARN ? stderr : stdout;
+        std::fprintf(
+            log_stream,
+            "[%s.%06lld] [%s] %.*s\n",
+            stamp_string,
+            static_cast<long long>(log_record->stamp % 1000000),
+            log_level_names[static_cast<uint8_t>(log_record->level)],
+            static_cast<int>(log_record->message_size),
+            log_record->message
+        );
+
+        log_record->sequence.store(dequeue_position_ + capacity_, std::memory_order_release);
+        dequeue_position_++;
+        is_drained = true;
+    }
+
+    if(is_drained) {
+        std::fflush(stdout);
+        std::fflush(stderr);
+    }
+    return is_drained;
+}
+
+/**
+ * @brief Function for log thread loop, reports dropped records once they stop growing
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_logger::Logger::run() {
+    uint64_t reported_dropped_records = 0;
+
+    while(is_running_.load(std::memory_order_acquire)) {
+        if(!drain()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(LOG_DRAIN_INTERVAL_MS));
+        }
+
+        const uint64_t dropped_records = dropped_records_.load(std::memory_order_relaxed);
+        if(dropped_records != reported_dropped_records) {
+            std::fprintf(stderr, "%s dropped %llu log records, ring buffer was full\n", LOG_ROS_MQTT_LOGGER, static_cast<unsigned long long>(dropped_records - reported_dropped_records));
+            reported_dropped_records = dropped_records;
+        }
+    }
+
+    drain();
+}
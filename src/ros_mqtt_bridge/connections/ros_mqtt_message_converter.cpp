@@ -15,12 +15,124 @@
 #include "ros_mqtt_bridge/connections/ros_mqtt_message_converter.hpp"
 
 
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param std_string_message std_msgs::msg::String& message to fill
+*/
+ros_message_converter::ros_std_msgs::ChatterJsonHandler::ChatterJsonHandler(std_msgs::msg::String& std_string_message)
+: std_string_message_(std_string_message) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_converter::ros_std_msgs::ChatterJsonHandler::~ChatterJsonHandler() {
+
+}
+
+/**
+ * @brief Function for set data default when root object starts, clear it when data is object
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return void
+*/
+void ros_message_converter::ros_std_msgs::ChatterJsonHandler::on_begin_object(const ros_json_reader::JsonPath& json_path) {
+    if(json_path.depth() == 0) {
+        std_string_message_.data = "nullstr";
+    } else if(json_path.is("data")) {
+        std_string_message_.data.clear();
+    }
+}
+
+/**
+ * @brief Function for clear data when data is array
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return void
+*/
+void ros_message_converter::ros_std_msgs::ChatterJsonHandler::on_begin_array(const ros_json_reader::JsonPath& json_path) {
+    if(json_path.is("data")) {
+        std_string_message_.data.clear();
+    }
+}
+
+/**
+ * @brief Function for clear data when data is null
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return void
+*/
+void ros_message_converter::ros_std_msgs::ChatterJsonHandler::on_null(const ros_json_reader::JsonPath& json_path) {
+    if(json_path.is("data")) {
+        std_string_message_.data.clear();
+    }
+}
+
+/**
+ * @brief Function for fill data with bool as string
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param bool_value bool
+ * @return void
+*/
+void ros_message_converter::ros_std_msgs::ChatterJsonHandler::on_bool(const ros_json_reader::JsonPath& json_path, bool bool_value) {
+    if(json_path.is("data")) {
+        std_string_message_.data = bool_value ? "true" : "false";
+    }
+}
+
+/**
+ * @brief Function for fill data with number as string
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param number_value double
+ * @return void
+*/
+void ros_message_converter::ros_std_msgs::ChatterJsonHandler::on_number(const ros_json_reader::JsonPath& json_path, double number_value) {
+    if(!json_path.is("data")) {
+        return;
+    }
+    if(number_value == std::floor(number_value) && std::fabs(number_value) < 9.2e18) {
+        std_string_message_.data = std::to_string(static_cast<int64_t>(number_value));
+    } else {
+        char number_string[32];
+        std::snprintf(number_string, sizeof(number_string), "%.17g", number_value);
+        std_string_message_.data = number_string;
+    }
+}
+
+/**
+ * @brief Function for fill data with string
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param string_value const char *
+ * @param string_size std::size_t
+ * @return void
+*/
+void ros_message_converter::ros_std_msgs::ChatterJsonHandler::on_string(const ros_json_reader::JsonPath& json_path, const char * string_value, std::size_t string_size) {
+    if(json_path.is("data")) {
+        std_string_message_.data.assign(string_value, string_size);
+    }
+}
+
 /**
  * @brief Constructor for initialize this class instance
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.12
 */
-ros_message_converter::ros_std_msgs::StdMessageConverter::StdMessageConverter() {
+ros_message_converter::ros_std_msgs::StdMessageConverter::StdMessageConverter()
+: is_parse_failed_(false) {
 
 }
 
@@ -34,24 +146,53 @@ ros_message_converter::ros_std_msgs::StdMessageConverter::~StdMessageConverter()
 }
 
 /**
- * @brief Function for convert ros message std_msgs::msg::Header data into Json::Value
+ * @brief Function for check whether last ingress JSON string could not be parsed
  * @author reidlo(naru5135@wavem.net)
- * @date 23.05.12
- * @param header_msgs const std_msgs::msg::Header
- * @return Json::Value
+ * @date 26.10.19
+ * @return bool
+ * @details reflects the last convert_json_to_* call, decoded Json::Value overloads always reset it
 */
-Json::Value ros_message_converter::ros_std_msgs::StdMessageConverter::convert_header_to_json(const std_msgs::msg::Header header_msgs) {
-    Json::Value header_json;
+bool ros_message_converter::ros_std_msgs::StdMessageConverter::is_parse_failed() const {
+    return is_parse_failed_;
+}
 
-    try {
-        header_json["frame_id"] = header_msgs.frame_id;
-        header_json["seq"] = header_msgs.stamp.sec;
-        header_json["stamp"] = header_msgs.stamp.sec + header_msgs.stamp.nanosec * 1e-9;
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing std std_string to std_msg::msg::String  err: " << json_expn.what() << '\n';
-    }
+/**
+ * @brief Function for convert ros message std_msgs::msg::Header data into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details stamp is kept as seconds in double for existing consumers, sec & nanosec carry the exact stamp
+ * @param header_msgs const std_msgs::msg::Header&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+*/
+void ros_message_converter::ros_std_msgs::StdMessageConverter::convert_header(const std_msgs::msg::Header& header_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(5);
+    message_encoder.write_key("frame_id");
+    message_encoder.write_string(header_msgs.frame_id);
+    message_encoder.write_key("seq");
+    message_encoder.write_int(header_msgs.stamp.sec);
+    message_encoder.write_key("stamp");
+    message_encoder.write_double(header_msgs.stamp.sec + header_msgs.stamp.nanosec * 1e-9);
+    message_encoder.write_key("sec");
+    message_encoder.write_int(header_msgs.stamp.sec);
+    message_encoder.write_key("nanosec");
+    message_encoder.write_uint(header_msgs.stamp.nanosec);
+    message_encoder.end_object();
+}
 
-    return header_json;
+/**
+ * @brief Function for convert ros message std_msgs::msg::String data into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param chatter_msgs const std_msgs::msg::String&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+*/
+void ros_message_converter::ros_std_msgs::StdMessageConverter::convert_chatter(const std_msgs::msg::String& chatter_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(1);
+    message_encoder.write_key("data");
+    message_encoder.write_string(chatter_msgs.data);
+    message_encoder.end_object();
 }
 
 /**
@@ -62,16 +203,9 @@ Json::Value ros_message_converter::ros_std_msgs::StdMessageConverter::convert_he
  * @return std::string
 */
 std::string ros_message_converter::ros_std_msgs::StdMessageConverter::convert_chatter_to_json(const std_msgs::msg::String::SharedPtr chatter_msgs_ptr) {
-    Json::Value chatter_json;
-
-    try {
-        chatter_json["data"] = chatter_msgs_ptr->data;
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing std chatter to json err: " << json_expn.what() << '\n';
-    }
-
-    std::string chatter_json_str = Json::StyledWriter().write(chatter_json);
-    return chatter_json_str;
+    ros_message_encoder::JsonEncoder json_encoder;
+    this->convert_chatter(*chatter_msgs_ptr, json_encoder);
+    return json_encoder.release();
 }
 
 /**
@@ -80,22 +214,34 @@ std::string ros_message_converter::ros_std_msgs::StdMessageConverter::convert_ch
  * @date 23.05.12
  * @param raw_std_string_data std::string&
  * @return std_msgs::msg::String
+ * @see ChatterJsonHandler
 */
 std_msgs::msg::String ros_message_converter::ros_std_msgs::StdMessageConverter::convert_json_to_chatter(std::string& raw_std_string_data) {
-    std::cout << "[RosMessageConverter] json to std_msgs raw data : " << raw_std_string_data << '\n';
+    std_msgs::msg::String std_string_message = std_msgs::msg::String();
+    ChatterJsonHandler chatter_json_handler(std_string_message);
 
-    Json::Value std_string_json;
-    Json::Reader json_reader;
+    bool is_parsing_success = json_reader_.parse(raw_std_string_data, chatter_json_handler);
+    is_parse_failed_ = !is_parsing_success;
+    if(!is_parsing_success) {
+        std::cerr << "[RosMessageConverter] parsing JSON string to json err at offset : " << json_reader_.error_offset() << '\n';
+        return std_msgs::msg::String();
+    }
+
+    return std_string_message;
+}
+/**
+ * @brief Function for convert decoded Json::Value into ros message std_msgs::msg::String
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param std_string_json const Json::Value&
+ * @return std_msgs::msg::String
+*/
+std_msgs::msg::String ros_message_converter::ros_std_msgs::StdMessageConverter::convert_json_to_chatter(const Json::Value& std_string_json) {
     std_msgs::msg::String std_string_message = std_msgs::msg::String();
-    
+    is_parse_failed_ = false;
+
     try {
-        bool is_parsing_success = json_reader.parse(raw_std_string_data, std_string_json);
-        if(is_parsing_success) {
-            std::cout << "[RosMessageConverter] parsing JSON string to json completed : " << std_string_json << '\n';
-            std_string_message.data = std_string_json.get("data", "nullstr").asString();
-        } else {
-            std::cerr << "[RosMessageConverter] parsing JSON string to json err : "  << json_reader.getFormatedErrorMessages() << '\n';
-        }
+        std_string_message.data = std_string_json.get("data", "nullstr").asString();
     } catch(const Json::Exception& json_expn) {
         std::cerr << "[RosMessageConverter] parsing JSON string to std_msg::msg::String  err: " << json_expn.what() << '\n';
     }
@@ -115,8 +261,8 @@ std_msgs::msg::Header ros_message_converter::ros_std_msgs::StdMessageConverter::
 
     try {
         header_message.frame_id = raw_header_data.get("frame_id", "nullstr").asString();
-        header_message.stamp.sec = raw_header_data.get("sec", 0.0).asDouble();
-        header_message.stamp.nanosec = raw_header_data.get("nanosec", 0.0).asDouble();
+        header_message.stamp.sec = raw_header_data.get("sec", 0).asInt();
+        header_message.stamp.nanosec = raw_header_data.get("nanosec", 0).asUInt();
     } catch(Json::Exception& json_expn) {
         std::cerr << "[RosMessageConverter] parsing json to std_msgs::msg::Header err : " << json_expn.what() << '\n';
     }
@@ -127,120 +273,445 @@ std_msgs::msg::Header ros_message_converter::ros_std_msgs::StdMessageConverter::
 /**
  * @brief Constructor for initialize this class instance
  * @author reidlo(naru5135@wavem.net)
- * @date 23.05.12
+ * @date 26.10.19
+ * @param twist_message geometry_msgs::msg::Twist& message to fill
+ * @param sent_ns int64_t& sender stamp to fill
 */
-ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::GeometryMessageConverter() {
-    std_message_converter_ = new ros_message_converter::ros_std_msgs::StdMessageConverter();
+ros_message_converter::ros_geometry_msgs::TwistJsonHandler::TwistJsonHandler(geometry_msgs::msg::Twist& twist_message, int64_t& sent_ns)
+: twist_message_(twist_message),
+sent_ns_(sent_ns) {
+
 }
 
 /**
  * @brief Virtual Destructor for this class
  * @author reidlo(naru5135@wavem.net)
- * @date 23.05.12
+ * @date 26.10.19
 */
-ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::~GeometryMessageConverter() {
-    delete std_message_converter_;
+ros_message_converter::ros_geometry_msgs::TwistJsonHandler::~TwistJsonHandler() {
+
 }
 
+/**
+ * @brief Function for find twist field of json path
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return double * nullptr when json path is not a twist field
+*/
+double * ros_message_converter::ros_geometry_msgs::TwistJsonHandler::find_field(const ros_json_reader::JsonPath& json_path) {
+    if(json_path.depth() != 2) {
+        return nullptr;
+    }
+
+    geometry_msgs::msg::Vector3 * vector_message = nullptr;
+    if(json_path.starts_with("linear")) {
+        vector_message = &twist_message_.linear;
+    } else if(json_path.starts_with("angular")) {
+        vector_message = &twist_message_.angular;
+    } else {
+        return nullptr;
+    }
+
+    if(json_path.is_key(1, "x")) {
+        return &vector_message->x;
+    } else if(json_path.is_key(1, "y")) {
+        return &vector_message->y;
+    } else if(json_path.is_key(1, "z")) {
+        return &vector_message->z;
+    }
+    return nullptr;
+}
 
 /**
- * @brief Function for convert ros geometry_msgs::msg::Point into Json::Value
+ * @brief Function for fill twist field with bool as 1 or 0
  * @author reidlo(naru5135@wavem.net)
- * @date 23.05.12
- * @param point_msgs const geometry_msgs::msg::Point
- * @return Json::Value
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param bool_value bool
+ * @return void
 */
-Json::Value ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_point_to_json(const geometry_msgs::msg::Point point_msgs) {
-    Json::Value point_json;
+void ros_message_converter::ros_geometry_msgs::TwistJsonHandler::on_bool(const ros_json_reader::JsonPath& json_path, bool bool_value) {
+    this->on_number(json_path, bool_value ? 1.0 : 0.0);
+}
 
-    try {
-        point_json["x"] = point_msgs.x;
-        point_json["y"] = point_msgs.y;
-        point_json["z"] = point_msgs.z;
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing json to geometry_msgs::msg::Point err : " << json_expn.what() << '\n';
+/**
+ * @brief Function for fill twist field with number
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param number_value double
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::TwistJsonHandler::on_number(const ros_json_reader::JsonPath& json_path, double number_value) {
+    if(json_path.is("sent_ns")) {
+        sent_ns_ = static_cast<int64_t>(number_value);
+        return;
+    }
+    double * twist_field = find_field(json_path);
+    if(twist_field != nullptr) {
+        *twist_field = number_value;
     }
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param pose_with_covariance_stamped_message geometry_msgs::msg::PoseWithCovarianceStamped& message to fill
+*/
+ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::PoseWithCovarianceStampedJsonHandler(geometry_msgs::msg::PoseWithCovarianceStamped& pose_with_covariance_stamped_message)
+: pose_with_covariance_stamped_message_(pose_with_covariance_stamped_message),
+pose_covariance_array_(),
+is_pose_covariance_valid_(false) {
 
-    return point_json;
 }
 
 /**
- * @brief Function for convert ros geometry_msgs::msg::Quaternion into Json::Value
+ * @brief Virtual Destructor for this class
  * @author reidlo(naru5135@wavem.net)
- * @date 23.05.12
- * @param quaternion_msgs const geometry_msgs::msg::Quaternion
- * @return Json::Value
+ * @date 26.10.19
 */
-Json::Value ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_quaternion_to_json(const geometry_msgs::msg::Quaternion quaternion_msgs) {
-    Json::Value quaternion_json;
+ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::~PoseWithCovarianceStampedJsonHandler() {
 
-    try {
-        quaternion_json["x"] = quaternion_msgs.x;
-        quaternion_json["y"] = quaternion_msgs.y;
-        quaternion_json["z"] = quaternion_msgs.z;
-        quaternion_json["w"] = quaternion_msgs.w;
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing json to geometry_msgs::msg::Quaternion err : " << json_expn.what() << '\n';
+}
+
+/**
+ * @brief Function for find numeric field of json path, header.sec & header.nanosec are handled by on_number
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return double * nullptr when json path is not a numeric pose field
+*/
+double * ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::find_field(const ros_json_reader::JsonPath& json_path) {
+    if(json_path.depth() != 4 || !json_path.starts_with("pose", "pose")) {
+        return nullptr;
     }
 
-    return quaternion_json;
+    geometry_msgs::msg::Pose& pose_message = pose_with_covariance_stamped_message_.pose.pose;
+    if(json_path.is_key(2, "position")) {
+        if(json_path.is_key(3, "x")) {
+            return &pose_message.position.x;
+        } else if(json_path.is_key(3, "y")) {
+            return &pose_message.position.y;
+        } else if(json_path.is_key(3, "z")) {
+            return &pose_message.position.z;
+        }
+    } else if(json_path.is_key(2, "orientation")) {
+        if(json_path.is_key(3, "x")) {
+            return &pose_message.orientation.x;
+        } else if(json_path.is_key(3, "y")) {
+            return &pose_message.orientation.y;
+        } else if(json_path.is_key(3, "z")) {
+            return &pose_message.orientation.z;
+        } else if(json_path.is_key(3, "w")) {
+            return &pose_message.orientation.w;
+        }
+    }
+    return nullptr;
 }
 
 /**
- * @brief Function for convert ros message geometry_msg::msg::Pose data into std::string(JSON value)
+ * @brief Function for check json path is an element of pose.covariance
  * @author reidlo(naru5135@wavem.net)
- * @date 23.05.12
- * @param pose_msgs_ptr const geometry_msgs::msg::Pose::SharedPtr
- * @return std::string
- * @see convert_point_to_json
- * @see convert_quaternion_to_json
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return bool
 */
-std::string ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_pose_to_json(const geometry_msgs::msg::Pose::SharedPtr pose_msgs_ptr) {
-    Json::Value pose_json;
+bool ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::is_pose_covariance_element(const ros_json_reader::JsonPath& json_path) {
+    return json_path.depth() == 3 && json_path.is_index(2) && json_path.starts_with("pose", "covariance");
+}
 
-    try {
-        pose_json["position"] = convert_point_to_json(pose_msgs_ptr->position);
-        pose_json["orientation"] = convert_quaternion_to_json(pose_msgs_ptr->orientation);
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing geometry_msgs::msg::Pose::SharedPtr to json err : " << json_expn.what() << '\n';
+/**
+ * @brief Function for set header.frame_id default when header starts, invalidate covariance when element is object
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::on_begin_object(const ros_json_reader::JsonPath& json_path) {
+    if(json_path.is("header")) {
+        pose_with_covariance_stamped_message_.header.frame_id = "nullstr";
+    } else if(is_pose_covariance_element(json_path)) {
+        is_pose_covariance_valid_ = false;
     }
+}
 
-    std::string pose_json_str = Json::StyledWriter().write(pose_json);
-    return pose_json_str;
+/**
+ * @brief Function for start collecting pose.covariance, invalidate it when element is array
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::on_begin_array(const ros_json_reader::JsonPath& json_path) {
+    if(json_path.is("pose", "covariance")) {
+        is_pose_covariance_valid_ = true;
+    } else if(is_pose_covariance_element(json_path)) {
+        is_pose_covariance_valid_ = false;
+    }
 }
 
-Json::Value ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_pose_to_json(const geometry_msgs::msg::Pose pose_msgs) {
-    Json::Value pose_json;
+/**
+ * @brief Function for commit pose.covariance when it had exactly 36 numbers
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param array_size std::size_t
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::on_end_array(const ros_json_reader::JsonPath& json_path, std::size_t array_size) {
+    if(!json_path.is("pose", "covariance")) {
+        return;
+    }
+    if(is_pose_covariance_valid_ && array_size == pose_covariance_array_.size()) {
+        pose_with_covariance_stamped_message_.pose.covariance = pose_covariance_array_;
+    } else {
+        std::cerr << "[RosMessageCoverter] parsing pose with covariance stamped pose.covariance is not array or out of range" << '\n';
+    }
+    is_pose_covariance_valid_ = false;
+}
 
-    try {
-        pose_json["position"] = convert_point_to_json(pose_msgs.position);
-        pose_json["orientation"] = convert_quaternion_to_json(pose_msgs.orientation);
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing geometry_msgs::msg::Pose::SharedPtr to json err : " << json_expn.what() << '\n';
+/**
+ * @brief Function for invalidate covariance when element is null
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::on_null(const ros_json_reader::JsonPath& json_path) {
+    if(is_pose_covariance_element(json_path)) {
+        is_pose_covariance_valid_ = false;
+    }
+}
+
+/**
+ * @brief Function for fill numeric field with bool as 1 or 0
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param bool_value bool
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::on_bool(const ros_json_reader::JsonPath& json_path, bool bool_value) {
+    if(is_pose_covariance_element(json_path)) {
+        is_pose_covariance_valid_ = false;
+        return;
+    }
+    this->on_number(json_path, bool_value ? 1.0 : 0.0);
+}
+
+/**
+ * @brief Function for fill numeric field, header stamp or pose.covariance element with number
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param number_value double
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::on_number(const ros_json_reader::JsonPath& json_path, double number_value) {
+    double * pose_field = find_field(json_path);
+    if(pose_field != nullptr) {
+        *pose_field = number_value;
+    } else if(is_pose_covariance_element(json_path)) {
+        const std::size_t covariance_index = json_path.index(2);
+        if(covariance_index < pose_covariance_array_.size()) {
+            pose_covariance_array_[covariance_index] = number_value;
+        }
+    } else if(json_path.is("header", "sec")) {
+        pose_with_covariance_stamped_message_.header.stamp.sec = static_cast<int32_t>(number_value);
+    } else if(json_path.is("header", "nanosec")) {
+        pose_with_covariance_stamped_message_.header.stamp.nanosec = static_cast<uint32_t>(number_value);
     }
+}
 
-    return pose_json;
+/**
+ * @brief Function for fill header.frame_id, invalidate covariance when element is string
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param json_path const ros_json_reader::JsonPath&
+ * @param string_value const char *
+ * @param string_size std::size_t
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::PoseWithCovarianceStampedJsonHandler::on_string(const ros_json_reader::JsonPath& json_path, const char * string_value, std::size_t string_size) {
+    if(json_path.is("header", "frame_id")) {
+        pose_with_covariance_stamped_message_.header.frame_id.assign(string_value, string_size);
+    } else if(is_pose_covariance_element(json_path)) {
+        is_pose_covariance_valid_ = false;
+    }
 }
 
 /**
- * @brief Function for convert ros geometry_msgs::msg::Vector3 into Json::Value
+ * @brief Constructor for initialize this class instance
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.12
- * @param vector_msgs const geometry_msgs::msg::Vector3
- * @return Json::Value
 */
-Json::Value ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_vector_to_json(const geometry_msgs::msg::Vector3 vector_msgs) {
-    Json::Value vector_json;
+ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::GeometryMessageConverter()
+: std_message_converter_(new ros_message_converter::ros_std_msgs::StdMessageConverter()),
+is_converter_owned_(true),
+is_parse_failed_(false),
+sent_ns_(0) {
 
-    try {
-        vector_json["x"] = vector_msgs.x;
-        vector_json["y"] = vector_msgs.y;
-        vector_json["z"] = vector_msgs.z;
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing geometry_msgs::msg::Vector3 to json err : " << json_expn.what() << '\n';
+}
+
+/**
+ * @brief Constructor for initialize this class instance with std converter shared by the bridge
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param std_message_converter ros_message_converter::ros_std_msgs::StdMessageConverter& not owned, must outlive this instance
+ * @details sharing is safe since only convert_header & convert_json_to_header(Json::Value) are called on it, they keep no state
+*/
+ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::GeometryMessageConverter(ros_message_converter::ros_std_msgs::StdMessageConverter& std_message_converter)
+: std_message_converter_(&std_message_converter),
+is_converter_owned_(false),
+is_parse_failed_(false),
+sent_ns_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 23.05.12
+*/
+ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::~GeometryMessageConverter() {
+    if(is_converter_owned_) {
+        delete std_message_converter_;
     }
+}
+
+/**
+ * @brief Function for check whether last ingress JSON string could not be parsed
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool
+ * @details reflects the last convert_json_to_* call, decoded Json::Value overloads always reset it
+*/
+bool ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::is_parse_failed() const {
+    return is_parse_failed_;
+}
 
-    return vector_json;
+/**
+ * @brief Function for get sender stamp of last ingress twist
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return int64_t wall clock nanoseconds of top-level sent_ns, 0 when last twist had none
+*/
+int64_t ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::sent_ns() const {
+    return sent_ns_;
+}
+
+
+/**
+ * @brief Function for convert ros geometry_msgs::msg::Point into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param point_msgs const geometry_msgs::msg::Point&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_point(const geometry_msgs::msg::Point& point_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(3);
+    message_encoder.write_key("x");
+    message_encoder.write_double(point_msgs.x);
+    message_encoder.write_key("y");
+    message_encoder.write_double(point_msgs.y);
+    message_encoder.write_key("z");
+    message_encoder.write_double(point_msgs.z);
+    message_encoder.end_object();
+}
+
+/**
+ * @brief Function for convert ros geometry_msgs::msg::Quaternion into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param quaternion_msgs const geometry_msgs::msg::Quaternion&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_quaternion(const geometry_msgs::msg::Quaternion& quaternion_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(4);
+    message_encoder.write_key("x");
+    message_encoder.write_double(quaternion_msgs.x);
+    message_encoder.write_key("y");
+    message_encoder.write_double(quaternion_msgs.y);
+    message_encoder.write_key("z");
+    message_encoder.write_double(quaternion_msgs.z);
+    message_encoder.write_key("w");
+    message_encoder.write_double(quaternion_msgs.w);
+    message_encoder.end_object();
+}
+
+/**
+ * @brief Function for convert ros message geometry_msg::msg::Pose data into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param pose_msgs const geometry_msgs::msg::Pose&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+ * @see convert_point
+ * @see convert_quaternion
+*/
+void ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_pose(const geometry_msgs::msg::Pose& pose_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(2);
+    message_encoder.write_key("position");
+    this->convert_point(pose_msgs.position, message_encoder);
+    message_encoder.write_key("orientation");
+    this->convert_quaternion(pose_msgs.orientation, message_encoder);
+    message_encoder.end_object();
+}
+
+/**
+ * @brief Function for convert ros message geometry_msg::msg::Pose data into std::string(JSON value)
+ * @author reidlo(naru5135@wavem.net)
+ * @date 23.05.12
+ * @param pose_msgs_ptr const geometry_msgs::msg::Pose::SharedPtr
+ * @return std::string
+ * @see convert_pose
+*/
+std::string ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_pose_to_json(const geometry_msgs::msg::Pose::SharedPtr pose_msgs_ptr) {
+    ros_message_encoder::JsonEncoder json_encoder;
+    this->convert_pose(*pose_msgs_ptr, json_encoder);
+    return json_encoder.release();
+}
+
+
+/**
+ * @brief Function for convert ros geometry_msgs::msg::Vector3 into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param vector_msgs const geometry_msgs::msg::Vector3&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+*/
+void ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_vector(const geometry_msgs::msg::Vector3& vector_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(3);
+    message_encoder.write_key("x");
+    message_encoder.write_double(vector_msgs.x);
+    message_encoder.write_key("y");
+    message_encoder.write_double(vector_msgs.y);
+    message_encoder.write_key("z");
+    message_encoder.write_double(vector_msgs.z);
+    message_encoder.end_object();
+}
+
+/**
+ * @brief Function for convert ros geometry_msgs::msg::Twist into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param twist_msgs const geometry_msgs::msg::Twist&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+ * @see convert_vector
+*/
+void ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_twist(const geometry_msgs::msg::Twist& twist_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(2);
+    message_encoder.write_key("linear");
+    this->convert_vector(twist_msgs.linear, message_encoder);
+    message_encoder.write_key("angular");
+    this->convert_vector(twist_msgs.angular, message_encoder);
+    message_encoder.end_object();
 }
 
 /**
@@ -249,20 +720,12 @@ Json::Value ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::
  * @date 23.05.12
  * @param twist_msgs_ptr const geometry_msgs::msg::Twist::SharedPtr
  * @return std::string
- * @see convert_vector_to_json
+ * @see convert_twist
 */
 std::string ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_twist_to_json(const geometry_msgs::msg::Twist::SharedPtr twist_msgs_ptr) {
-    Json::Value twist_json;
-
-    try {
-        twist_json["linear"] = convert_vector_to_json(twist_msgs_ptr->linear);
-        twist_json["angular"] = convert_vector_to_json(twist_msgs_ptr->angular);
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing geometry_msgs::msg::Twist::SharedPtr to json err : " << json_expn.what() << '\n';
-    }
-
-    std::string twist_json_str = Json::StyledWriter().write(twist_json);
-    return twist_json_str;
+    ros_message_encoder::JsonEncoder json_encoder;
+    this->convert_twist(*twist_msgs_ptr, json_encoder);
+    return json_encoder.release();
 }
 
 /**
@@ -287,44 +750,67 @@ geometry_msgs::msg::Vector3 ros_message_converter::ros_geometry_msgs::GeometryMe
 }
 
 /**
- * @brief Function for convert Json::Value into ros message geometry_msgs::msg::Twist
+ * @brief Function for convert std::string(JSON style) into ros message geometry_msgs::msg::Twist
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.12
  * @param raw_twist_data std::string&
  * @return geometry_msgs::msg::Twist
- * @see convert_json_to_vector
+ * @see TwistJsonHandler
 */
 geometry_msgs::msg::Twist ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_json_to_twist(std::string& raw_twist_data) {
-    Json::Value twist_json;   
-    Json::Reader json_reader;
     geometry_msgs::msg::Twist twist_message = geometry_msgs::msg::Twist();
+    sent_ns_ = 0;
+    TwistJsonHandler twist_json_handler(twist_message, sent_ns_);
+
+    bool is_twist_parsing_success = json_reader_.parse(raw_twist_data, twist_json_handler);
+    is_parse_failed_ = !is_twist_parsing_success;
+    if(!is_twist_parsing_success) {
+        std::cerr << "[RosMessageConverter] parsing twist json err at offset : " << json_reader_.error_offset() << '\n';
+        return geometry_msgs::msg::Twist();
+    }
+
+    return twist_message;
+}
+/**
+ * @brief Function for convert decoded Json::Value into ros message geometry_msgs::msg::Twist
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param twist_json const Json::Value&
+ * @return geometry_msgs::msg::Twist
+ * @see convert_json_to_vector
+*/
+geometry_msgs::msg::Twist ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_json_to_twist(const Json::Value& twist_json) {
+    geometry_msgs::msg::Twist twist_message = geometry_msgs::msg::Twist();
+    is_parse_failed_ = false;
+    sent_ns_ = 0;
 
     try {
-        bool is_twist_parsing_success = json_reader.parse(raw_twist_data, twist_json);
-        if(is_twist_parsing_success) {
-            std::cout << "[RosMessageConverter] twist parsing completed : " << twist_json << '\n';
-            
-            Json::Value linear_json = twist_json.get("linear", Json::Value::null);
-            if(!linear_json.isNull()) {
-                std::cout << "[RosMessageConverter] linear parsing completed : " << linear_json << '\n';
-                twist_message.linear = convert_json_to_vector(linear_json);
-            } else {
-                std::cerr << "[RosMessageConverter] parsing twist linear json is null " << '\n';
-            }
+        const Json::Value& sent_ns_json = twist_json["sent_ns"];
+        if(sent_ns_json.isIntegral()) {
+            sent_ns_ = sent_ns_json.asInt64();
+        } else if(sent_ns_json.isNumeric()) {
+            sent_ns_ = static_cast<int64_t>(sent_ns_json.asDouble());
+        }
 
-            Json::Value angular_json = twist_json.get("angular", Json::Value::null);
-            if(!angular_json.isNull()) {
-                std::cout << "[RosMessageConverter] angular parsing completed : " << angular_json << '\n';
-                twist_message.angular = convert_json_to_vector(angular_json);
-            } else {
-                std::cerr << "[RosMessageConverter] parsing twist angular json is null " << '\n';
-            }
+        const Json::Value& linear_json = twist_json["linear"];
+        if(!linear_json.isNull()) {
+            ROS_MQTT_LOG_DEBUG("[RosMessageConverter] linear parsing completed");
+            twist_message.linear = convert_json_to_vector(linear_json);
+        } else {
+            std::cerr << "[RosMessageConverter] parsing twist linear json is null " << '\n';
+        }
+
+        const Json::Value& angular_json = twist_json["angular"];
+        if(!angular_json.isNull()) {
+            ROS_MQTT_LOG_DEBUG("[RosMessageConverter] angular parsing completed");
+            twist_message.angular = convert_json_to_vector(angular_json);
         } else {
-            std::cerr << "[RosMessageConverter] parsing twist json err : "  << json_reader.getFormatedErrorMessages() << '\n';
+            std::cerr << "[RosMessageConverter] parsing twist angular json is null " << '\n';
         }
     } catch(const Json::Exception& json_expn) {
         std::cerr << "[RosMessageConverter] parsing twist json err : " << json_expn.what() << '\n';
     }
+
     return twist_message;
 }
 
@@ -380,7 +866,7 @@ geometry_msgs::msg::Quaternion ros_message_converter::ros_geometry_msgs::Geometr
 */
 std::array<double, 36UL> ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_json_to_pose_covariance(Json::Value raw_pose_data) {
     Json::Value pose_covariance_from_json = raw_pose_data["covariance"];
-    std::array<double, 36UL> pose_covariance_array;
+    std::array<double, 36UL> pose_covariance_array{};
 
     try {
         if(pose_covariance_from_json.isArray() && pose_covariance_from_json.size() == 36) {
@@ -403,58 +889,66 @@ std::array<double, 36UL> ros_message_converter::ros_geometry_msgs::GeometryMessa
  * @date 23.05.12
  * @param raw_pose_with_covariance_stamped_data std::string&
  * @return geometry_msgs::msg::PoseWithCovarianceStamped
+ * @see PoseWithCovarianceStampedJsonHandler
 */
 geometry_msgs::msg::PoseWithCovarianceStamped ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_json_to_pose_with_covariance_stamped(std::string& raw_pose_with_covariance_stamped_data) {
-    std::cout << "[RosMessageConverter] pose with covaraince stamped raw data : " << raw_pose_with_covariance_stamped_data << '\n';
+    geometry_msgs::msg::PoseWithCovarianceStamped pose_with_covariance_stamped_message = geometry_msgs::msg::PoseWithCovarianceStamped();
+    PoseWithCovarianceStampedJsonHandler pose_with_covariance_stamped_json_handler(pose_with_covariance_stamped_message);
 
-    Json::Value pose_with_covariance_stamped_json;
-    Json::Reader json_reader;
+    bool is_pose_with_covariance_stamped_parsing_success = json_reader_.parse(raw_pose_with_covariance_stamped_data, pose_with_covariance_stamped_json_handler);
+    is_parse_failed_ = !is_pose_with_covariance_stamped_parsing_success;
+    if(!is_pose_with_covariance_stamped_parsing_success) {
+        std::cerr << "[RosMessageConverter] parsing pose with covariance stamped json err at offset : " << json_reader_.error_offset() << '\n';
+        return geometry_msgs::msg::PoseWithCovarianceStamped();
+    }
+
+    return pose_with_covariance_stamped_message;
+}
+/**
+ * @brief Function for convert decoded Json::Value into ros message geometry_msgs::msg::PoseWithCovarianceStamped
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param pose_with_covariance_stamped_json const Json::Value&
+ * @return geometry_msgs::msg::PoseWithCovarianceStamped
+*/
+geometry_msgs::msg::PoseWithCovarianceStamped ros_message_converter::ros_geometry_msgs::GeometryMessageConverter::convert_json_to_pose_with_covariance_stamped(const Json::Value& pose_with_covariance_stamped_json) {
     geometry_msgs::msg::PoseWithCovarianceStamped pose_with_covariance_stamped_message = geometry_msgs::msg::PoseWithCovarianceStamped();
+    is_parse_failed_ = false;
 
     try {
-        bool is_pose_with_covariance_stamped_parsing_success = json_reader.parse(raw_pose_with_covariance_stamped_data, pose_with_covariance_stamped_json);
-        if(is_pose_with_covariance_stamped_parsing_success) {
-            std::cout << "[RosMessageConverter] pose with covariance stamped parsing completed : " << pose_with_covariance_stamped_json << '\n';
-            if(is_pose_with_covariance_stamped_parsing_success) {
-                Json::Value header_json = pose_with_covariance_stamped_json.get("header", Json::Value::null);
-                if(!header_json.isNull()) {
-                    pose_with_covariance_stamped_message.header = std_message_converter_->convert_json_to_header(header_json);
+        const Json::Value& header_json = pose_with_covariance_stamped_json["header"];
+        if(!header_json.isNull()) {
+            pose_with_covariance_stamped_message.header = std_message_converter_->convert_json_to_header(header_json);
+        } else {
+            std::cerr << "[RosMessageConverter] parsing pose with covariance stamped header json is null " << '\n';
+        }
+        const Json::Value& pose_json = pose_with_covariance_stamped_json["pose"];
+        if(!pose_json.isNull()) {
+            const Json::Value& pose_pose_json = pose_json["pose"];
+            if(!pose_pose_json.isNull()) {
+                const Json::Value& pose_pose_position_json = pose_pose_json["position"];
+                if(!pose_pose_position_json.isNull()) {
+                    pose_with_covariance_stamped_message.pose.pose.position = convert_json_to_point(pose_pose_position_json);
                 } else {
-                    std::cerr << "[RosMessageConverter] parsing pose with covariance stamped header json is null " << '\n';
+                    std::cerr << "[RosMessageConverter] parsing with covariance stamped pose.pose.position json is null " << '\n';
                 }
-                Json::Value pose_json = pose_with_covariance_stamped_json.get("pose", Json::Value::null);
-                if(!pose_json.isNull()) {
-                    Json::Value pose_pose_json = pose_json.get("pose", Json::Value::null);
-                    if(!pose_pose_json.isNull()) {
-                        Json::Value pose_pose_position_json = pose_pose_json.get("position", Json::Value::null);
-                        if(!pose_pose_position_json.isNull()) {
-                            pose_with_covariance_stamped_message.pose.pose.position = convert_json_to_point(pose_pose_position_json);
-                        } else {
-                            std::cerr << "[RosMessageConverter] parsing with covariance stamped pose.pose.position json is null " << '\n';
-                        }
-                        Json::Value pose_pose_orientation_json = pose_pose_json.get("orientation", Json::Value::null);
-                        if(!pose_pose_orientation_json.isNull()) {
-                            pose_with_covariance_stamped_message.pose.pose.orientation = convert_json_to_quaternion(pose_pose_orientation_json);
-                        } else {
-                            std::cerr << "[RosMessageConverter] parsing with covariance stamped pose.pose.orientation json is null " << '\n';
-                        }
-                    } else {
-                        std::cerr << "[RosMessageConverter] parsing with covariance stamped pose.position json is null " << '\n';
-                    }
-                    pose_with_covariance_stamped_message.pose.covariance = convert_json_to_pose_covariance(pose_json);
+                const Json::Value& pose_pose_orientation_json = pose_pose_json["orientation"];
+                if(!pose_pose_orientation_json.isNull()) {
+                    pose_with_covariance_stamped_message.pose.pose.orientation = convert_json_to_quaternion(pose_pose_orientation_json);
                 } else {
-                    std::cerr << "[RosMessageConverter] parsing pose with covariance stamped pose json is null " << '\n';
+                    std::cerr << "[RosMessageConverter] parsing with covariance stamped pose.pose.orientation json is null " << '\n';
                 }
             } else {
-                std::cerr << "[RosMessageConverter] parsing pose with covariance stamped json err : "  << json_reader.getFormatedErrorMessages() << '\n';
+                std::cerr << "[RosMessageConverter] parsing with covariance stamped pose.position json is null " << '\n';
             }
+            pose_with_covariance_stamped_message.pose.covariance = convert_json_to_pose_covariance(pose_json);
         } else {
-            std::cerr << "[RosMessageConverter] parsing twist json err : "  << json_reader.getFormatedErrorMessages() << '\n';
+            std::cerr << "[RosMessageConverter] parsing pose with covariance stamped pose json is null " << '\n';
         }
     } catch(const Json::Exception& json_expn) {
         std::cerr << "[RosMessageConverter] parsing pose with covariance stamped json err : " << json_expn.what() << '\n';
     }
-    
+
     return pose_with_covariance_stamped_message;
 }
 
@@ -463,8 +957,22 @@ geometry_msgs::msg::PoseWithCovarianceStamped ros_message_converter::ros_geometr
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.12
 */
-ros_message_converter::ros_sensor_msgs::SensorMessageConverter::SensorMessageConverter() {
-    std_message_converter_ = new ros_message_converter::ros_std_msgs::StdMessageConverter();
+ros_message_converter::ros_sensor_msgs::SensorMessageConverter::SensorMessageConverter()
+: std_message_converter_(new ros_message_converter::ros_std_msgs::StdMessageConverter()),
+is_converter_owned_(true) {
+
+}
+
+/**
+ * @brief Constructor for initialize this class instance with std converter shared by the bridge
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param std_message_converter ros_message_converter::ros_std_msgs::StdMessageConverter& not owned, must outlive this instance
+*/
+ros_message_converter::ros_sensor_msgs::SensorMessageConverter::SensorMessageConverter(ros_message_converter::ros_std_msgs::StdMessageConverter& std_message_converter)
+: std_message_converter_(&std_message_converter),
+is_converter_owned_(false) {
+
 }
 
 /**
@@ -473,39 +981,82 @@ ros_message_converter::ros_sensor_msgs::SensorMessageConverter::SensorMessageCon
  * @date 23.05.12
 */
 ros_message_converter::ros_sensor_msgs::SensorMessageConverter::~SensorMessageConverter() {
-    delete std_message_converter_;
+    if(is_converter_owned_) {
+        delete std_message_converter_;
+    }
 }
 
 /**
- * @brief Function for convert ros message sensor_msgs::msg::LaserScan data into std::string(JSON style)
+ * @brief Function for convert ros message sensor_msgs::msg::LaserScan data into message encoder
  * @author reidlo(naru5135@wavem.net)
- * @date 23.05.12
- * @param scan_msgs_ptr const sensor_msgs::msg::LaserScan::SharedPtr
- * @return std::string
+ * @date 26.10.19
+ * @param scan_msgs const sensor_msgs::msg::LaserScan&
+ * @param message_encoder ros_message_encoder::MessageEncoder& time_increment, scan_time & intensities are left out when its output options omit them,
+ * beams are cropped, pooled & clamped by its scan reduction
+ * @return void
 */
-std::string ros_message_converter::ros_sensor_msgs::SensorMessageConverter::convert_scan_to_json(const sensor_msgs::msg::LaserScan::SharedPtr scan_msgs_ptr) {
-    Json::Value scan_json;
-
-    scan_json["header"] = std_message_converter_->convert_header_to_json(scan_msgs_ptr->header);
-    scan_json["angle_min"] = scan_msgs_ptr->angle_min;
-    scan_json["angle_max"] = scan_msgs_ptr->angle_max;
-    scan_json["angle_increment"] = scan_msgs_ptr->angle_increment;
-    scan_json["time_increment"] = scan_msgs_ptr->time_increment;
-    scan_json["scan_time"] = scan_msgs_ptr->scan_time;
+void ros_message_converter::ros_sensor_msgs::SensorMessageConverter::convert_scan(const sensor_msgs::msg::LaserScan& scan_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    const ros_message_encoder::OutputOptions& output_options = message_encoder.output_options();
+    std::size_t scan_object_size = 10;
+    if(output_options.is_time_increment_omitted) {
+        scan_object_size--;
+    }
+    if(output_options.is_scan_time_omitted) {
+        scan_object_size--;
+    }
+    if(output_options.is_intensities_omitted) {
+        scan_object_size--;
+    }
 
-    scan_json["range_min"] = scan_msgs_ptr->range_min;
-    scan_json["range_max"] = scan_msgs_ptr->range_max;
-    
-    for (const float& range : scan_msgs_ptr->ranges) {
-        scan_json["ranges"].append(range);
+    const ros_mqtt_scan::ScanView scan_view{
+        scan_msgs.angle_min, scan_msgs.angle_max, scan_msgs.angle_increment, scan_msgs.time_increment, scan_msgs.range_min, scan_msgs.range_max,
+        scan_msgs.ranges.data(), scan_msgs.ranges.size(), scan_msgs.intensities.data(), scan_msgs.intensities.size()
+    };
+    const ros_mqtt_scan::ScanView reduced_view = scan_reducer_.reduce(scan_view, output_options.scan_reduction);
+
+    message_encoder.begin_object(scan_object_size);
+    message_encoder.write_key("header");
+    std_message_converter_->convert_header(scan_msgs.header, message_encoder);
+    message_encoder.write_key("angle_min");
+    message_encoder.write_float(reduced_view.angle_min);
+    message_encoder.write_key("angle_max");
+    message_encoder.write_float(reduced_view.angle_max);
+    message_encoder.write_key("angle_increment");
+    message_encoder.write_float(reduced_view.angle_increment);
+    if(!output_options.is_time_increment_omitted) {
+        message_encoder.write_key("time_increment");
+        message_encoder.write_float(reduced_view.time_increment);
+    }
+    if(!output_options.is_scan_time_omitted) {
+        message_encoder.write_key("scan_time");
+        message_encoder.write_float(scan_msgs.scan_time);
     }
+    message_encoder.write_key("range_min");
+    message_encoder.write_float(reduced_view.range_min);
+    message_encoder.write_key("range_max");
+    message_encoder.write_float(reduced_view.range_max);
 
-    for (const float& intense : scan_msgs_ptr->intensities) {
-        scan_json["intensities"].append(intense);
+    message_encoder.write_key("ranges");
+    message_encoder.write_float_array(reduced_view.ranges, reduced_view.range_count);
+
+    if(!output_options.is_intensities_omitted) {
+        message_encoder.write_key("intensities");
+        message_encoder.write_float_array(reduced_view.intensities, reduced_view.intensity_count);
     }
+    message_encoder.end_object();
+}
 
-    std::string scan_json_str = Json::StyledWriter().write(scan_json);
-    return scan_json_str;
+/**
+ * @brief Function for convert ros message sensor_msgs::msg::LaserScan data into std::string(JSON style)
+ * @author reidlo(naru5135@wavem.net)
+ * @date 23.05.12
+ * @param scan_msgs_ptr const sensor_msgs::msg::LaserScan::SharedPtr
+ * @return std::string
+*/
+std::string ros_message_converter::ros_sensor_msgs::SensorMessageConverter::convert_scan_to_json(const sensor_msgs::msg::LaserScan::SharedPtr scan_msgs_ptr) {
+    ros_message_encoder::JsonEncoder json_encoder;
+    this->convert_scan(*scan_msgs_ptr, json_encoder);
+    return json_encoder.release();
 }
 
 /**
@@ -513,9 +1064,25 @@ std::string ros_message_converter::ros_sensor_msgs::SensorMessageConverter::conv
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.12
 */
-ros_message_converter::ros_nav_msgs::NavMessageConverter::NavMessageConverter() {
-    std_message_converter_ = new ros_message_converter::ros_std_msgs::StdMessageConverter();
-    geometry_message_converter_ = new ros_message_converter::ros_geometry_msgs::GeometryMessageConverter();
+ros_message_converter::ros_nav_msgs::NavMessageConverter::NavMessageConverter()
+: std_message_converter_(new ros_message_converter::ros_std_msgs::StdMessageConverter()),
+geometry_message_converter_(new ros_message_converter::ros_geometry_msgs::GeometryMessageConverter(*std_message_converter_)),
+is_converter_owned_(true) {
+
+}
+
+/**
+ * @brief Constructor for initialize this class instance with std & geometry converters shared by the bridge
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param std_message_converter ros_message_converter::ros_std_msgs::StdMessageConverter& not owned, must outlive this instance
+ * @param geometry_message_converter ros_message_converter::ros_geometry_msgs::GeometryMessageConverter& not owned, must outlive this instance
+*/
+ros_message_converter::ros_nav_msgs::NavMessageConverter::NavMessageConverter(ros_message_converter::ros_std_msgs::StdMessageConverter& std_message_converter, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter& geometry_message_converter)
+: std_message_converter_(&std_message_converter),
+geometry_message_converter_(&geometry_message_converter),
+is_converter_owned_(false) {
+
 }
 
 /**
@@ -524,8 +1091,53 @@ ros_message_converter::ros_nav_msgs::NavMessageConverter::NavMessageConverter()
  * @date 23.05.12
 */
 ros_message_converter::ros_nav_msgs::NavMessageConverter::~NavMessageConverter() {
-    delete std_message_converter_;
-    delete geometry_message_converter_;
+    if(is_converter_owned_) {
+        delete geometry_message_converter_;
+        delete std_message_converter_;
+    }
+}
+
+/**
+ * @brief Function for convert ros message nav_msgs::msg::Odometry data into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param odom_msgs const nav_msgs::msg::Odometry&
+ * @param message_encoder ros_message_encoder::MessageEncoder& all zero covariances are left out when its output options omit them
+ * @return void
+*/
+void ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_odom(const nav_msgs::msg::Odometry& odom_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    const bool is_zero_covariance_omitted = message_encoder.output_options().is_zero_covariance_omitted;
+    const bool is_pose_covariance_written = !is_zero_covariance_omitted
+        || !ros_message_encoder::is_zero_array(odom_msgs.pose.covariance.data(), odom_msgs.pose.covariance.size());
+    const bool is_twist_covariance_written = !is_zero_covariance_omitted
+        || !ros_message_encoder::is_zero_array(odom_msgs.twist.covariance.data(), odom_msgs.twist.covariance.size());
+
+    message_encoder.begin_object(4);
+    message_encoder.write_key("header");
+    std_message_converter_->convert_header(odom_msgs.header, message_encoder);
+    message_encoder.write_key("child_frame_id");
+    message_encoder.write_string(odom_msgs.child_frame_id);
+
+    message_encoder.write_key("pose");
+    message_encoder.begin_object(is_pose_covariance_written ? 2 : 1);
+    message_encoder.write_key("pose");
+    geometry_message_converter_->convert_pose(odom_msgs.pose.pose, message_encoder);
+    if(is_pose_covariance_written) {
+        message_encoder.write_key("covariance");
+        message_encoder.write_double_array(odom_msgs.pose.covariance.data(), odom_msgs.pose.covariance.size());
+    }
+    message_encoder.end_object();
+
+    message_encoder.write_key("twist");
+    message_encoder.begin_object(is_twist_covariance_written ? 2 : 1);
+    message_encoder.write_key("twist");
+    geometry_message_converter_->convert_twist(odom_msgs.twist.twist, message_encoder);
+    if(is_twist_covariance_written) {
+        message_encoder.write_key("covariance");
+        message_encoder.write_double_array(odom_msgs.twist.covariance.data(), odom_msgs.twist.covariance.size());
+    }
+    message_encoder.end_object();
+    message_encoder.end_object();
 }
 
 /**
@@ -536,30 +1148,100 @@ ros_message_converter::ros_nav_msgs::NavMessageConverter::~NavMessageConverter()
  * @return std::string
 */
 std::string ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_odom_to_json(const nav_msgs::msg::Odometry::SharedPtr odom_msgs_ptr) {
-    Json::Value odom_json;
-
-    try {
-        odom_json["header"] = std_message_converter_->convert_header_to_json(odom_msgs_ptr->header);
-        odom_json["child_frame_id"] = odom_msgs_ptr->child_frame_id;
-        odom_json["pose"]["pose"]["position"] = geometry_message_converter_->convert_point_to_json(odom_msgs_ptr->pose.pose.position);
-        odom_json["pose"]["pose"]["orientation"] = geometry_message_converter_->convert_quaternion_to_json(odom_msgs_ptr->pose.pose.orientation);
-        odom_json["pose"]["covariance"] = Json::arrayValue;
-        for (const double& cov : odom_msgs_ptr->pose.covariance) {
-            odom_json["pose"]["covariance"].append(cov);
-        }
+    ros_message_encoder::JsonEncoder json_encoder;
+    this->convert_odom(*odom_msgs_ptr, json_encoder);
+    return json_encoder.release();
+}
 
-        odom_json["twist"]["twist"]["linear"] = geometry_message_converter_->convert_vector_to_json(odom_msgs_ptr->twist.twist.linear);
-        odom_json["twist"]["twist"]["angular"] = geometry_message_converter_->convert_vector_to_json(odom_msgs_ptr->twist.twist.angular);
-        odom_json["twist"]["covariance"] = Json::arrayValue;
-        for (const double& cov : odom_msgs_ptr->twist.covariance) {
-            odom_json["twist"]["covariance"].append(cov);
-        }
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing odom to json err : " << json_expn.what() << '\n';
+/**
+ * @brief Function for simplify poses of path into flat pose values, x, y, z, qx, qy, qz, qw per pose(PATH_POSE_STRIDE)
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_msgs const nav_msgs::msg::Path&
+ * @param output_options const ros_message_encoder::OutputOptions& path simplification, tolerance & max poses
+ * @return const std::vector<double>& valid until next call
+*/
+const std::vector<double>& ros_message_converter::ros_nav_msgs::NavMessageConverter::simplify_path(const nav_msgs::msg::Path& path_msgs, const ros_message_encoder::OutputOptions& output_options) {
+    path_points_.resize(path_msgs.poses.size());
+    for(std::size_t i = 0; i < path_msgs.poses.size(); i++) {
+        const geometry_msgs::msg::Point& position = path_msgs.poses[i].pose.position;
+        path_points_[i] = ros_mqtt_path::PathPoint{position.x, position.y, position.z};
+    }
+    const std::vector<std::size_t>& kept_indices = path_simplifier_.simplify(path_points_, output_options.path_simplification, output_options.path_tolerance, output_options.path_max_poses);
+
+    path_values_.resize(kept_indices.size() * PATH_POSE_STRIDE);
+    double * path_value = path_values_.data();
+    for(const std::size_t kept_index : kept_indices) {
+        const geometry_msgs::msg::Pose& pose = path_msgs.poses[kept_index].pose;
+        path_value[0] = pose.position.x;
+        path_value[1] = pose.position.y;
+        path_value[2] = pose.position.z;
+        path_value[3] = pose.orientation.x;
+        path_value[4] = pose.orientation.y;
+        path_value[5] = pose.orientation.z;
+        path_value[6] = pose.orientation.w;
+        path_value += PATH_POSE_STRIDE;
     }
+    return path_values_;
+}
 
-    std::string odom_json_str = Json::StyledWriter().write(odom_json);
-    return odom_json_str;
+/**
+ * @brief Function for convert ros message nav_msgs::msg::Path data into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_msgs const nav_msgs::msg::Path&
+ * @param message_encoder ros_message_encoder::MessageEncoder& path is simplified & limited by its output options
+ * @return void
+ * @details poses are written as one flat array of PATH_POSE_STRIDE values per pose, their headers are left out since they repeat the path header.
+ * pose_count is the count of poses before simplification
+*/
+void ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_path(const nav_msgs::msg::Path& path_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    const std::vector<double>& pose_values = this->simplify_path(path_msgs, message_encoder.output_options());
+
+    message_encoder.begin_object(3);
+    message_encoder.write_key("header");
+    std_message_converter_->convert_header(path_msgs.header, message_encoder);
+    message_encoder.write_key("pose_count");
+    message_encoder.write_uint(path_msgs.poses.size());
+    message_encoder.write_key("poses");
+    message_encoder.write_double_array(pose_values.data(), pose_values.size());
+    message_encoder.end_object();
+}
+
+/**
+ * @brief Function for convert ros message nav_msgs::msg::Path data into message encoder as keyframe or splice against path published before it
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_msgs const nav_msgs::msg::Path&
+ * @param path_delta ros_mqtt_path::PathDelta& last poses of the topic, updated with poses of path_msgs
+ * @param message_encoder ros_message_encoder::MessageEncoder& path is simplified & limited by its output options
+ * @return void
+ * @details keyframes carry every kept pose, deltas carry "splice" [start, deleted count] & the inserted poses only.
+ * receivers apply a delta to the poses of sequence - 1 & wait for next keyframe when a sequence is missing
+*/
+void ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_path_delta(const nav_msgs::msg::Path& path_msgs, ros_mqtt_path::PathDelta& path_delta, ros_message_encoder::MessageEncoder& message_encoder) {
+    const std::vector<double>& pose_values = this->simplify_path(path_msgs, message_encoder.output_options());
+    const ros_mqtt_path::PathSplice path_splice = path_delta.next(path_msgs.header.frame_id, pose_values);
+
+    message_encoder.begin_object(path_splice.is_keyframe ? 5 : 6);
+    message_encoder.write_key("header");
+    std_message_converter_->convert_header(path_msgs.header, message_encoder);
+    message_encoder.write_key("pose_count");
+    message_encoder.write_uint(path_msgs.poses.size());
+    message_encoder.write_key("sequence");
+    message_encoder.write_uint(path_splice.sequence);
+    message_encoder.write_key("keyframe");
+    message_encoder.write_bool(path_splice.is_keyframe);
+    if(!path_splice.is_keyframe) {
+        message_encoder.write_key("splice");
+        message_encoder.begin_array(2);
+        message_encoder.write_uint(path_splice.start);
+        message_encoder.write_uint(path_splice.deleted_count);
+        message_encoder.end_array();
+    }
+    message_encoder.write_key("poses");
+    message_encoder.write_double_array(pose_values.data() + path_splice.start * PATH_POSE_STRIDE, path_splice.inserted_count * PATH_POSE_STRIDE);
+    message_encoder.end_object();
 }
 
 /**
@@ -570,46 +1252,61 @@ std::string ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_od
  * @return std::string
 */
 std::string ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_path_to_json(const nav_msgs::msg::Path::SharedPtr path_msgs_ptr) {
-    Json::Value path_json;
-
-    try {
-        path_json["header"] = std_message_converter_->convert_header_to_json(path_msgs_ptr->header);
-
-        for(const geometry_msgs::msg::PoseStamped& pose : path_msgs_ptr->poses) {
-            path_json["pose"]["header"] = std_message_converter_->convert_header_to_json(pose.header);
-            path_json["pose"]["pose"]["position"] = geometry_message_converter_->convert_point_to_json(pose.pose.position);
-            path_json["pose"]["pose"]["orientation"] = geometry_message_converter_->convert_quaternion_to_json(pose.pose.orientation);
-        }
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing path to json err : " << json_expn.what() << '\n';
-    }
-
-    std::string path_json_str = Json::StyledWriter().write(path_json);
-    return path_json_str;
+    ros_message_encoder::JsonEncoder json_encoder;
+    this->convert_path(*path_msgs_ptr, json_encoder);
+    return json_encoder.release();
 }
 
 /**
- * @brief Function for convert ros message nav_msgs::msg::MapMetaData data into Json::Value
+ * @brief Function for convert ros message nav_msgs::msg::MapMetaData data into message encoder
  * @author reidlo(naru5135@wavem.net)
- * @date 23.05.12
- * @param map_meta_data_msgs const nav_msgs::msg::MapMetaData
- * @return Json::Value
+ * @date 26.10.19
+ * @param map_meta_data_msgs const nav_msgs::msg::MapMetaData&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
 */
-Json::Value ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_meta_data_to_json(const nav_msgs::msg::MapMetaData map_meta_data_msgs) {
-    Json::Value map_meta_data_json;
+void ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_meta_data(const nav_msgs::msg::MapMetaData& map_meta_data_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(5);
+    message_encoder.write_key("width");
+    message_encoder.write_uint(map_meta_data_msgs.width);
+    message_encoder.write_key("height");
+    message_encoder.write_uint(map_meta_data_msgs.height);
+    message_encoder.write_key("origin");
+    geometry_message_converter_->convert_pose(map_meta_data_msgs.origin, message_encoder);
+    message_encoder.write_key("resolution");
+    message_encoder.write_float(map_meta_data_msgs.resolution);
+    message_encoder.write_key("map_load_time");
+    message_encoder.begin_object(2);
+    message_encoder.write_key("sec");
+    message_encoder.write_int(map_meta_data_msgs.map_load_time.sec);
+    message_encoder.write_key("nanosec");
+    message_encoder.write_uint(map_meta_data_msgs.map_load_time.nanosec);
+    message_encoder.end_object();
+    message_encoder.end_object();
+}
 
-    try {
-        map_meta_data_json["width"] = map_meta_data_msgs.width;
-        map_meta_data_json["height"] = map_meta_data_msgs.height;
-        map_meta_data_json["origin"] = geometry_message_converter_->convert_pose_to_json(map_meta_data_msgs.origin);
-        map_meta_data_json["resolution"] = map_meta_data_msgs.resolution;
-        map_meta_data_json["map_load_time"]["sec"] = map_meta_data_msgs.map_load_time.sec;
-        map_meta_data_json["map_load_time"]["nanosec"] = map_meta_data_msgs.map_load_time.nanosec;
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing occupancy grid to json err : " << json_expn.what() << '\n';
+/**
+ * @brief Function for convert ros message nav_msgs::srv::GetMap_Response data into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param map_response_msgs const nav_msgs::srv::GetMap_Response&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+*/
+void ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_map_response(const nav_msgs::srv::GetMap_Response& map_response_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(3);
+    message_encoder.write_key("header");
+    std_message_converter_->convert_header(map_response_msgs.map.header, message_encoder);
+    message_encoder.write_key("info");
+    this->convert_meta_data(map_response_msgs.map.info, message_encoder);
+
+    message_encoder.write_key("data");
+    message_encoder.begin_array(map_response_msgs.map.data.size());
+    for (const int8_t& cell : map_response_msgs.map.data) {
+        message_encoder.write_int(cell);
     }
-
-    return map_meta_data_json;
+    message_encoder.end_array();
+    message_encoder.end_object();
 }
 
 /**
@@ -620,19 +1317,9 @@ Json::Value ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_me
  * @return std::string
 */
 std::string ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_map_response_to_json(const nav_msgs::srv::GetMap_Response::SharedPtr map_response_msgs_ptr) {
-    Json::Value map_response_json;
-
-    try {
-        map_response_json["header"] = std_message_converter_->convert_header_to_json(map_response_msgs_ptr->map.header);
-        map_response_json["info"] = convert_meta_data_to_json(map_response_msgs_ptr->map.info);
-        
-        std::vector<int8_t> map_data_vec = map_response_msgs_ptr->map.data;
-        int8_t map_data_arr[map_data_vec.size()];
-        std::copy(map_data_vec.begin(), map_data_vec.end(), map_data_arr);
-        map_response_json["data"] = map_data_arr;
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing map response to json err : " << json_expn.what() << '\n';
-    }
+    ros_message_encoder::JsonEncoder json_encoder;
+    this->convert_map_response(*map_response_msgs_ptr, json_encoder);
+    return json_encoder.release();
 }
 
 /**
@@ -640,9 +1327,25 @@ std::string ros_message_converter::ros_nav_msgs::NavMessageConverter::convert_ma
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.12
 */
-ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::Tf2MessageConverter() {
-    std_message_converter_ = new ros_message_converter::ros_std_msgs::StdMessageConverter();
-    geometry_message_converter_ = new ros_message_converter::ros_geometry_msgs::GeometryMessageConverter();
+ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::Tf2MessageConverter()
+: std_message_converter_(new ros_message_converter::ros_std_msgs::StdMessageConverter()),
+geometry_message_converter_(new ros_message_converter::ros_geometry_msgs::GeometryMessageConverter(*std_message_converter_)),
+is_converter_owned_(true) {
+
+}
+
+/**
+ * @brief Constructor for initialize this class instance with std & geometry converters shared by the bridge
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param std_message_converter ros_message_converter::ros_std_msgs::StdMessageConverter& not owned, must outlive this instance
+ * @param geometry_message_converter ros_message_converter::ros_geometry_msgs::GeometryMessageConverter& not owned, must outlive this instance
+*/
+ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::Tf2MessageConverter(ros_message_converter::ros_std_msgs::StdMessageConverter& std_message_converter, ros_message_converter::ros_geometry_msgs::GeometryMessageConverter& geometry_message_converter)
+: std_message_converter_(&std_message_converter),
+geometry_message_converter_(&geometry_message_converter),
+is_converter_owned_(false) {
+
 }
 
 /**
@@ -651,8 +1354,73 @@ ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::Tf2MessageConverter()
  * @date 23.05.12
 */
 ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::~Tf2MessageConverter() {
-    delete std_message_converter_;
-    delete geometry_message_converter_;
+    if(is_converter_owned_) {
+        delete geometry_message_converter_;
+        delete std_message_converter_;
+    }
+}
+
+/**
+ * @brief Function for convert ros message tf2_msgs::msg::TFMessage data into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param tf_msgs const tf2_msgs::msg::TFMessage&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+ * @details keeps the flat JSON layout of one transform, which holds the last transform of message
+*/
+void ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::convert_tf(const tf2_msgs::msg::TFMessage& tf_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    if(tf_msgs.transforms.empty()) {
+        message_encoder.begin_object(0);
+        message_encoder.end_object();
+        return;
+    }
+
+    this->convert_transform_stamped(tf_msgs.transforms.back(), message_encoder);
+}
+
+/**
+ * @brief Function for convert ros message geometry_msgs::msg::TransformStamped data into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param transform_stamped_msgs const geometry_msgs::msg::TransformStamped&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+*/
+void ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::convert_transform_stamped(const geometry_msgs::msg::TransformStamped& transform_stamped_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(3);
+    message_encoder.write_key("header");
+    std_message_converter_->convert_header(transform_stamped_msgs.header, message_encoder);
+    message_encoder.write_key("child_frame_id");
+    message_encoder.write_string(transform_stamped_msgs.child_frame_id);
+    message_encoder.write_key("transform");
+    message_encoder.begin_object(2);
+    message_encoder.write_key("translation");
+    geometry_message_converter_->convert_vector(transform_stamped_msgs.transform.translation, message_encoder);
+    message_encoder.write_key("rotation");
+    geometry_message_converter_->convert_quaternion(transform_stamped_msgs.transform.rotation, message_encoder);
+    message_encoder.end_object();
+    message_encoder.end_object();
+}
+
+/**
+ * @brief Function for convert every transform of ros message tf2_msgs::msg::TFMessage into message encoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param tf_msgs const tf2_msgs::msg::TFMessage&
+ * @param message_encoder ros_message_encoder::MessageEncoder&
+ * @return void
+ * @details { transforms : [ { header, child_frame_id, transform }, ... ] } like tf2_msgs::msg::TFMessage, used for composed frame pairs
+*/
+void ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::convert_transforms(const tf2_msgs::msg::TFMessage& tf_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    message_encoder.begin_object(1);
+    message_encoder.write_key("transforms");
+    message_encoder.begin_array(tf_msgs.transforms.size());
+    for(const geometry_msgs::msg::TransformStamped& transform_stamped : tf_msgs.transforms) {
+        this->convert_transform_stamped(transform_stamped, message_encoder);
+    }
+    message_encoder.end_array();
+    message_encoder.end_object();
 }
 
 /**
@@ -663,19 +1431,7 @@ ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::~Tf2MessageConverter()
  * @return std::string
 */
 std::string ros_message_converter::ros_tf2_msgs::Tf2MessageConverter::convert_tf_to_json(const tf2_msgs::msg::TFMessage::SharedPtr tf_msgs_ptr) {
-    Json::Value tf_json;
-
-    try {
-        for(const geometry_msgs::msg::TransformStamped& transform : tf_msgs_ptr->transforms) {
-            tf_json["header"] = std_message_converter_->convert_header_to_json(transform.header);
-            tf_json["child_frame_id"] = transform.child_frame_id;
-            tf_json["transform"]["translation"] = geometry_message_converter_->convert_vector_to_json(transform.transform.translation);
-            tf_json["transform"]["rotation"] = geometry_message_converter_->convert_quaternion_to_json(transform.transform.rotation);
-        }   
-    } catch(const Json::Exception& json_expn) {
-        std::cerr << "[RosMessageConverter] parsing tf to json err : " << json_expn.what() << '\n';
-    }
-    
-    std::string tf2_json_str = Json::StyledWriter().write(tf_json);
-    return tf2_json_str;
-}
\ No newline at end of file
+    ros_message_encoder::JsonEncoder json_encoder;
+    this->convert_tf(*tf_msgs_ptr, json_encoder);
+    return json_encoder.release();
+}
@@ -0,0 +1,1178 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_message_encoder.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#define ROS_MESSAGE_DECODER_MAX_DEPTH 64
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::MessageEncoder::MessageEncoder()
+: output_options_(ros_message_encoder::default_output_options()) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class, gives encoded buffer back into payload pool
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details short lived encoders of convert_*_to_json then do not drain the pool which their release() took from
+*/
+ros_message_encoder::MessageEncoder::~MessageEncoder() {
+    ros_mqtt_buffer_pool::BufferPool::instance().recycle(buffer_);
+}
+
+/**
+ * @brief Function for clear encoded buffer while keeping its capacity for next message
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_message_encoder::MessageEncoder::clear() {
+    buffer_.clear();
+}
+
+/**
+ * @brief Function for set output options of following messages, kept over clear() until set again
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param output_options const OutputOptions&
+ * @return void
+*/
+void ros_message_encoder::MessageEncoder::set_output_options(const OutputOptions& output_options) {
+    output_options_ = output_options;
+}
+
+/**
+ * @brief Function for get output options which converters check before writing omittable fields
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return const OutputOptions&
+*/
+const ros_message_encoder::OutputOptions& ros_message_encoder::MessageEncoder::output_options() const {
+    return output_options_;
+}
+
+/**
+ * @brief Function for get encoded buffer
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::string&
+*/
+std::string& ros_message_encoder::MessageEncoder::buffer() {
+    return buffer_;
+}
+
+/**
+ * @brief Function for move encoded buffer out of this encoder, next buffer is taken from payload pool
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::string
+ * @see ros_mqtt_buffer_pool::BufferPool
+*/
+std::string ros_message_encoder::MessageEncoder::release() {
+    std::string released_buffer = ros_mqtt_buffer_pool::BufferPool::instance().acquire();
+    released_buffer.swap(buffer_);
+    this->clear();
+    return released_buffer;
+}
+
+/**
+ * @brief Function for write float array, encoders override it when they can write the elements in one pass
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param float_values const float *
+ * @param float_count std::size_t
+ * @return void
+*/
+void ros_message_encoder::MessageEncoder::write_float_array(const float * float_values, std::size_t float_count) {
+    this->begin_array(float_count);
+    for(std::size_t i = 0; i < float_count; i++) {
+        this->write_float(float_values[i]);
+    }
+    this->end_array();
+}
+
+/**
+ * @brief Function for write double array, encoders override it when they can write the elements in one pass
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param double_values const double *
+ * @param double_count std::size_t
+ * @return void
+*/
+void ros_message_encoder::MessageEncoder::write_double_array(const double * double_values, std::size_t double_count) {
+    this->begin_array(double_count);
+    for(std::size_t i = 0; i < double_count; i++) {
+        this->write_double(double_values[i]);
+    }
+    this->end_array();
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::JsonEncoder::JsonEncoder() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::JsonEncoder::~JsonEncoder() {
+
+}
+
+ros_message_encoder::Encoding ros_message_encoder::JsonEncoder::encoding() const {
+    return Encoding::JSON;
+}
+
+/**
+ * @brief Function for write ',' between array elements, object members are separated in write_key
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_message_encoder::JsonEncoder::write_separator() {
+    if(is_array_stack_.empty() || !is_array_stack_.back()) {
+        return;
+    }
+    if(!is_first_element_stack_.back()) {
+        buffer_ += ',';
+    }
+    is_first_element_stack_.back() = false;
+}
+
+/**
+ * @brief Function for write JSON string literal with escaped quotes, backslashes & control characters
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param raw_string const char *
+ * @param raw_string_size std::size_t
+ * @return void
+*/
+void ros_message_encoder::JsonEncoder::write_escaped(const char * raw_string, std::size_t raw_string_size) {
+    static const char hex_digits[] = "0123456789abcdef";
+
+    buffer_ += '"';
+    for(std::size_t i = 0; i < raw_string_size; i++) {
+        const unsigned char raw_char = static_cast<unsigned char>(raw_string[i]);
+        switch(raw_char) {
+            case '"' : buffer_ += "\\\""; break;
+            case '\\' : buffer_ += "\\\\"; break;
+            case '\b' : buffer_ += "\\b"; break;
+            case '\f' : buffer_ += "\\f"; break;
+            case '\n' : buffer_ += "\\n"; break;
+            case '\r' : buffer_ += "\\r"; break;
+            case '\t' : buffer_ += "\\t"; break;
+            default :
+                if(raw_char < 0x20) {
+                    buffer_ += "\\u00";
+                    buffer_ += hex_digits[raw_char >> 4];
+                    buffer_ += hex_digits[raw_char & 0x0F];
+                } else {
+                    buffer_ += static_cast<char>(raw_char);
+                }
+        }
+    }
+    buffer_ += '"';
+}
+
+void ros_message_encoder::JsonEncoder::begin_object(std::size_t object_size) {
+    (void)object_size;
+    this->write_separator();
+    buffer_ += '{';
+    is_array_stack_.push_back(false);
+    is_first_element_stack_.push_back(true);
+}
+
+void ros_message_encoder::JsonEncoder::end_object() {
+    buffer_ += '}';
+    is_array_stack_.pop_back();
+    is_first_element_stack_.pop_back();
+}
+
+void ros_message_encoder::JsonEncoder::begin_array(std::size_t array_size) {
+    (void)array_size;
+    this->write_separator();
+    buffer_ += '[';
+    is_array_stack_.push_back(true);
+    is_first_element_stack_.push_back(true);
+}
+
+void ros_message_encoder::JsonEncoder::end_array() {
+    buffer_ += ']';
+    is_array_stack_.pop_back();
+    is_first_element_stack_.pop_back();
+}
+
+void ros_message_encoder::JsonEncoder::write_key(const char * key) {
+    if(!is_first_element_stack_.back()) {
+        buffer_ += ',';
+    }
+    is_first_element_stack_.back() = false;
+    this->write_escaped(key, std::strlen(key));
+    buffer_ += ':';
+}
+
+void ros_message_encoder::JsonEncoder::write_null() {
+    this->write_separator();
+    buffer_ += "null";
+}
+
+void ros_message_encoder::JsonEncoder::write_bool(bool bool_value) {
+    this->write_separator();
+    buffer_ += bool_value ? "true" : "false";
+}
+
+void ros_message_encoder::JsonEncoder::write_int(int64_t int_value) {
+    this->write_separator();
+    char int_buffer[24];
+    const int int_size = std::snprintf(int_buffer, sizeof(int_buffer), "%" PRId64, int_value);
+    buffer_.append(int_buffer, static_cast<std::size_t>(int_size));
+}
+
+void ros_message_encoder::JsonEncoder::write_uint(uint64_t uint_value) {
+    this->write_separator();
+    char uint_buffer[24];
+    const int uint_size = std::snprintf(uint_buffer, sizeof(uint_buffer), "%" PRIu64, uint_value);
+    buffer_.append(uint_buffer, static_cast<std::size_t>(uint_size));
+}
+
+/**
+ * @brief Function for write double as shortest round trip decimal, non-finite as null/1e+9999 like Json::StyledWriter
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param double_value double
+ * @return void
+ * @see ros_number_format::format_double
+*/
+void ros_message_encoder::JsonEncoder::write_double(double double_value) {
+    this->write_separator();
+    char number_buffer[NUMBER_FORMAT_BUFFER_SIZE];
+    buffer_.append(number_buffer, this->format_number(double_value, number_buffer));
+}
+
+/**
+ * @brief Function for write float as shortest decimal which reads back into the same float32
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param float_value float
+ * @return void
+ * @see ros_number_format::format_float
+*/
+void ros_message_encoder::JsonEncoder::write_float(float float_value) {
+    this->write_separator();
+    char number_buffer[NUMBER_FORMAT_BUFFER_SIZE];
+    buffer_.append(number_buffer, this->format_number(float_value, number_buffer));
+}
+
+/**
+ * @brief Function for write float array in one pass, elements are formatted straight into buffer without per-element separator state
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param float_values const float *
+ * @param float_count std::size_t
+ * @return void
+*/
+void ros_message_encoder::JsonEncoder::write_float_array(const float * float_values, std::size_t float_count) {
+    this->begin_array(float_count);
+    if(float_count > 0) {
+        char number_buffer[NUMBER_FORMAT_BUFFER_SIZE];
+        buffer_.reserve(buffer_.size() + float_count * JSON_FLOAT_ARRAY_ELEMENT_SIZE);
+        buffer_.append(number_buffer, this->format_number(float_values[0], number_buffer));
+        for(std::size_t i = 1; i < float_count; i++) {
+            buffer_ += ',';
+            buffer_.append(number_buffer, this->format_number(float_values[i], number_buffer));
+        }
+        is_first_element_stack_.back() = false;
+    }
+    this->end_array();
+}
+
+/**
+ * @brief Function for write double array in one pass, e.g. covariances
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param double_values const double *
+ * @param double_count std::size_t
+ * @return void
+*/
+void ros_message_encoder::JsonEncoder::write_double_array(const double * double_values, std::size_t double_count) {
+    this->begin_array(double_count);
+    if(double_count > 0) {
+        char number_buffer[NUMBER_FORMAT_BUFFER_SIZE];
+        buffer_.reserve(buffer_.size() + double_count * JSON_DOUBLE_ARRAY_ELEMENT_SIZE);
+        buffer_.append(number_buffer, this->format_number(double_values[0], number_buffer));
+        for(std::size_t i = 1; i < double_count; i++) {
+            buffer_ += ',';
+            buffer_.append(number_buffer, this->format_number(double_values[i], number_buffer));
+        }
+        is_first_element_stack_.back() = false;
+    }
+    this->end_array();
+}
+
+/**
+ * @brief Function for format double into number buffer, non-finite values get JSON stand-ins
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param double_value double
+ * @param number_buffer char * of NUMBER_FORMAT_BUFFER_SIZE
+ * @return std::size_t written characters
+*/
+std::size_t ros_message_encoder::JsonEncoder::format_number(double double_value, char * number_buffer) {
+    if(std::isnan(double_value)) {
+        std::memcpy(number_buffer, "null", 4);
+        return 4;
+    } else if(std::isinf(double_value) && double_value < 0) {
+        std::memcpy(number_buffer, "-1e+9999", 8);
+        return 8;
+    } else if(std::isinf(double_value)) {
+        std::memcpy(number_buffer, "1e+9999", 7);
+        return 7;
+    }
+    if(output_options_.decimals != JSON_SHORTEST_DECIMALS) {
+        return ros_number_format::format_fixed(double_value, output_options_.decimals, number_buffer);
+    }
+    return ros_number_format::format_double(double_value, number_buffer);
+}
+
+/**
+ * @brief Function for format float into number buffer, non-finite values get JSON stand-ins
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param float_value float
+ * @param number_buffer char * of NUMBER_FORMAT_BUFFER_SIZE
+ * @return std::size_t written characters
+*/
+std::size_t ros_message_encoder::JsonEncoder::format_number(float float_value, char * number_buffer) {
+    if(!std::isfinite(float_value)) {
+        return this->format_number(static_cast<double>(float_value), number_buffer);
+    }
+    if(output_options_.decimals != JSON_SHORTEST_DECIMALS) {
+        return ros_number_format::format_fixed(static_cast<double>(float_value), output_options_.decimals, number_buffer);
+    }
+    return ros_number_format::format_float(float_value, number_buffer);
+}
+
+void ros_message_encoder::JsonEncoder::write_string(const std::string& string_value) {
+    this->write_separator();
+    this->write_escaped(string_value.data(), string_value.size());
+}
+
+void ros_message_encoder::JsonEncoder::clear() {
+    buffer_.clear();
+    is_array_stack_.clear();
+    is_first_element_stack_.clear();
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::MessagePackEncoder::MessagePackEncoder() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::MessagePackEncoder::~MessagePackEncoder() {
+
+}
+
+ros_message_encoder::Encoding ros_message_encoder::MessagePackEncoder::encoding() const {
+    return Encoding::MSGPACK;
+}
+
+/**
+ * @brief Function for append value in network byte order
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param value uint64_t
+ * @param value_size std::size_t count of bytes to write
+ * @return void
+*/
+void ros_message_encoder::MessagePackEncoder::write_big_endian(uint64_t value, std::size_t value_size) {
+    for(std::size_t i = value_size; i > 0; i--) {
+        buffer_ += static_cast<char>((value >> ((i - 1) * 8)) & 0xFF);
+    }
+}
+
+void ros_message_encoder::MessagePackEncoder::write_string_header(std::size_t string_size) {
+    if(string_size < 32) {
+        buffer_ += static_cast<char>(0xA0 | string_size);
+    } else if(string_size <= 0xFF) {
+        buffer_ += static_cast<char>(0xD9);
+        this->write_big_endian(string_size, 1);
+    } else if(string_size <= 0xFFFF) {
+        buffer_ += static_cast<char>(0xDA);
+        this->write_big_endian(string_size, 2);
+    } else {
+        buffer_ += static_cast<char>(0xDB);
+        this->write_big_endian(string_size, 4);
+    }
+}
+
+void ros_message_encoder::MessagePackEncoder::begin_object(std::size_t object_size) {
+    if(object_size < 16) {
+        buffer_ += static_cast<char>(0x80 | object_size);
+    } else if(object_size <= 0xFFFF) {
+        buffer_ += static_cast<char>(0xDE);
+        this->write_big_endian(object_size, 2);
+    } else {
+        buffer_ += static_cast<char>(0xDF);
+        this->write_big_endian(object_size, 4);
+    }
+}
+
+void ros_message_encoder::MessagePackEncoder::end_object() {
+
+}
+
+void ros_message_encoder::MessagePackEncoder::begin_array(std::size_t array_size) {
+    if(array_size < 16) {
+        buffer_ += static_cast<char>(0x90 | array_size);
+    } else if(array_size <= 0xFFFF) {
+        buffer_ += static_cast<char>(0xDC);
+        this->write_big_endian(array_size, 2);
+    } else {
+        buffer_ += static_cast<char>(0xDD);
+        this->write_big_endian(array_size, 4);
+    }
+}
+
+void ros_message_encoder::MessagePackEncoder::end_array() {
+
+}
+
+void ros_message_encoder::MessagePackEncoder::write_key(const char * key) {
+    const std::size_t key_size = std::strlen(key);
+    this->write_string_header(key_size);
+    buffer_.append(key, key_size);
+}
+
+void ros_message_encoder::MessagePackEncoder::write_null() {
+    buffer_ += static_cast<char>(0xC0);
+}
+
+void ros_message_encoder::MessagePackEncoder::write_bool(bool bool_value) {
+    buffer_ += static_cast<char>(bool_value ? 0xC3 : 0xC2);
+}
+
+void ros_message_encoder::MessagePackEncoder::write_int(int64_t int_value) {
+    if(int_value >= 0) {
+        this->write_uint(static_cast<uint64_t>(int_value));
+    } else if(int_value >= -32) {
+        buffer_ += static_cast<char>(int_value);
+    } else if(int_value >= INT8_MIN) {
+        buffer_ += static_cast<char>(0xD0);
+        this->write_big_endian(static_cast<uint64_t>(int_value), 1);
+    } else if(int_value >= INT16_MIN) {
+        buffer_ += static_cast<char>(0xD1);
+        this->write_big_endian(static_cast<uint64_t>(int_value), 2);
+    } else if(int_value >= INT32_MIN) {
+        buffer_ += static_cast<char>(0xD2);
+        this->write_big_endian(static_cast<uint64_t>(int_value), 4);
+    } else {
+        buffer_ += static_cast<char>(0xD3);
+        this->write_big_endian(static_cast<uint64_t>(int_value), 8);
+    }
+}
+
+void ros_message_encoder::MessagePackEncoder::write_uint(uint64_t uint_value) {
+    if(uint_value < 128) {
+        buffer_ += static_cast<char>(uint_value);
+    } else if(uint_value <= 0xFF) {
+        buffer_ += static_cast<char>(0xCC);
+        this->write_big_endian(uint_value, 1);
+    } else if(uint_value <= 0xFFFF) {
+        buffer_ += static_cast<char>(0xCD);
+        this->write_big_endian(uint_value, 2);
+    } else if(uint_value <= 0xFFFFFFFF) {
+        buffer_ += static_cast<char>(0xCE);
+        this->write_big_endian(uint_value, 4);
+    } else {
+        buffer_ += static_cast<char>(0xCF);
+        this->write_big_endian(uint_value, 8);
+    }
+}
+
+void ros_message_encoder::MessagePackEncoder::write_double(double double_value) {
+    uint64_t double_bits;
+    std::memcpy(&double_bits, &double_value, sizeof(double_bits));
+    buffer_ += static_cast<char>(0xCB);
+    this->write_big_endian(double_bits, 8);
+}
+
+void ros_message_encoder::MessagePackEncoder::write_float(float float_value) {
+    uint32_t float_bits;
+    std::memcpy(&float_bits, &float_value, sizeof(float_bits));
+    buffer_ += static_cast<char>(0xCA);
+    this->write_big_endian(float_bits, 4);
+}
+
+void ros_message_encoder::MessagePackEncoder::write_string(const std::string& string_value) {
+    this->write_string_header(string_value.size());
+    buffer_ += string_value;
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::CborEncoder::CborEncoder() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::CborEncoder::~CborEncoder() {
+
+}
+
+ros_message_encoder::Encoding ros_message_encoder::CborEncoder::encoding() const {
+    return Encoding::CBOR;
+}
+
+/**
+ * @brief Function for write CBOR initial byte & shortest argument of major type
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param major_type uint8_t
+ * @param argument uint64_t
+ * @return void
+*/
+void ros_message_encoder::CborEncoder::write_head(uint8_t major_type, uint64_t argument) {
+    const uint8_t major_type_bits = static_cast<uint8_t>(major_type << 5);
+    std::size_t argument_size = 0;
+
+    if(argument < 24) {
+        buffer_ += static_cast<char>(major_type_bits | argument);
+        return;
+    } else if(argument <= 0xFF) {
+        buffer_ += static_cast<char>(major_type_bits | 24);
+        argument_size = 1;
+    } else if(argument <= 0xFFFF) {
+        buffer_ += static_cast<char>(major_type_bits | 25);
+        argument_size = 2;
+    } else if(argument <= 0xFFFFFFFF) {
+        buffer_ += static_cast<char>(major_type_bits | 26);
+        argument_size = 4;
+    } else {
+        buffer_ += static_cast<char>(major_type_bits | 27);
+        argument_size = 8;
+    }
+
+    for(std::size_t i = argument_size; i > 0; i--) {
+        buffer_ += static_cast<char>((argument >> ((i - 1) * 8)) & 0xFF);
+    }
+}
+
+void ros_message_encoder::CborEncoder::begin_object(std::size_t object_size) {
+    this->write_head(5, object_size);
+}
+
+void ros_message_encoder::CborEncoder::end_object() {
+
+}
+
+void ros_message_encoder::CborEncoder::begin_array(std::size_t array_size) {
+    this->write_head(4, array_size);
+}
+
+void ros_message_encoder::CborEncoder::end_array() {
+
+}
+
+void ros_message_encoder::CborEncoder::write_key(const char * key) {
+    const std::size_t key_size = std::strlen(key);
+    this->write_head(3, key_size);
+    buffer_.append(key, key_size);
+}
+
+void ros_message_encoder::CborEncoder::write_null() {
+    buffer_ += static_cast<char>(0xF6);
+}
+
+void ros_message_encoder::CborEncoder::write_bool(bool bool_value) {
+    buffer_ += static_cast<char>(bool_value ? 0xF5 : 0xF4);
+}
+
+void ros_message_encoder::CborEncoder::write_int(int64_t int_value) {
+    if(int_value >= 0) {
+        this->write_head(0, static_cast<uint64_t>(int_value));
+    } else {
+        this->write_head(1, static_cast<uint64_t>(-(int_value + 1)));
+    }
+}
+
+void ros_message_encoder::CborEncoder::write_uint(uint64_t uint_value) {
+    this->write_head(0, uint_value);
+}
+
+void ros_message_encoder::CborEncoder::write_double(double double_value) {
+    uint64_t double_bits;
+    std::memcpy(&double_bits, &double_value, sizeof(double_bits));
+    buffer_ += static_cast<char>(0xFB);
+    for(int i = 7; i >= 0; i--) {
+        buffer_ += static_cast<char>((double_bits >> (i * 8)) & 0xFF);
+    }
+}
+
+void ros_message_encoder::CborEncoder::write_float(float float_value) {
+    uint32_t float_bits;
+    std::memcpy(&float_bits, &float_value, sizeof(float_bits));
+    buffer_ += static_cast<char>(0xFA);
+    for(int i = 3; i >= 0; i--) {
+        buffer_ += static_cast<char>((float_bits >> (i * 8)) & 0xFF);
+    }
+}
+
+void ros_message_encoder::CborEncoder::write_string(const std::string& string_value) {
+    this->write_head(3, string_value.size());
+    buffer_ += string_value;
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::MessageDecoder::MessageDecoder() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_message_encoder::MessageDecoder::~MessageDecoder() {
+
+}
+
+ros_message_encoder::JsonDecoder::JsonDecoder() {
+
+}
+
+ros_message_encoder::JsonDecoder::~JsonDecoder() {
+
+}
+
+ros_message_encoder::Encoding ros_message_encoder::JsonDecoder::encoding() const {
+    return Encoding::JSON;
+}
+
+/**
+ * @brief Function for decode JSON payload into Json::Value
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param raw_payload const std::string&
+ * @param decoded_json Json::Value&
+ * @return bool
+*/
+bool ros_message_encoder::JsonDecoder::decode(const std::string& raw_payload, Json::Value& decoded_json) {
+    Json::CharReaderBuilder json_reader_builder;
+    std::unique_ptr<Json::CharReader> json_reader(json_reader_builder.newCharReader());
+    std::string json_errors;
+
+    bool is_parsing_success = json_reader->parse(raw_payload.data(), raw_payload.data() + raw_payload.size(), &decoded_json, &json_errors);
+    if(!is_parsing_success) {
+        std::cerr << LOG_ROS_MESSAGE_ENCODER << " decoding JSON payload err : " << json_errors << '\n';
+    }
+    return is_parsing_success;
+}
+
+ros_message_encoder::MessagePackDecoder::MessagePackDecoder() {
+
+}
+
+ros_message_encoder::MessagePackDecoder::~MessagePackDecoder() {
+
+}
+
+ros_message_encoder::Encoding ros_message_encoder::MessagePackDecoder::encoding() const {
+    return Encoding::MSGPACK;
+}
+
+/**
+ * @brief Function for decode MessagePack payload into Json::Value
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param raw_payload const std::string&
+ * @param decoded_json Json::Value&
+ * @return bool
+*/
+bool ros_message_encoder::MessagePackDecoder::decode(const std::string& raw_payload, Json::Value& decoded_json) {
+    const uint8_t * cursor = reinterpret_cast<const uint8_t *>(raw_payload.data());
+    const uint8_t * end = cursor + raw_payload.size();
+
+    bool is_decoding_success = this->decode_value(cursor, end, decoded_json, 0) && cursor == end;
+    if(!is_decoding_success) {
+        std::cerr << LOG_ROS_MESSAGE_ENCODER << " decoding MessagePack payload err" << '\n';
+    }
+    return is_decoding_success;
+}
+
+/**
+ * @brief Function for recursively decode one MessagePack value
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param cursor const uint8_t *& advanced past decoded value
+ * @param end const uint8_t *
+ * @param decoded_json Json::Value&
+ * @param depth int
+ * @return bool
+*/
+bool ros_message_encoder::MessagePackDecoder::decode_value(const uint8_t *& cursor, const uint8_t * end, Json::Value& decoded_json, int depth) {
+    if(cursor >= end || depth > ROS_MESSAGE_DECODER_MAX_DEPTH) {
+        return false;
+    }
+
+    auto read_big_endian = [&cursor, end](std::size_t value_size, uint64_t& value) -> bool {
+        if(static_cast<std::size_t>(end - cursor) < value_size) {
+            return false;
+        }
+        value = 0;
+        for(std::size_t i = 0; i < value_size; i++) {
+            value = (value << 8) | *cursor++;
+        }
+        return true;
+    };
+
+    const uint8_t type_byte = *cursor++;
+    uint64_t value = 0;
+    std::size_t container_size = 0;
+    bool is_map = false;
+
+    if(type_byte <= 0x7F) {
+        decoded_json = Json::Value(static_cast<Json::UInt64>(type_byte));
+        return true;
+    } else if(type_byte >= 0xE0) {
+        decoded_json = Json::Value(static_cast<Json::Int64>(static_cast<int8_t>(type_byte)));
+        return true;
+    } else if((type_byte & 0xF0) == 0x80) {
+        is_map = true;
+        container_size = type_byte & 0x0F;
+    } else if((type_byte & 0xF0) == 0x90) {
+        container_size = type_byte & 0x0F;
+    } else if((type_byte & 0xE0) == 0xA0 || type_byte == 0xD9 || type_byte == 0xDA || type_byte == 0xDB) {
+        std::size_t string_size = type_byte & 0x1F;
+        if(type_byte == 0xD9 || type_byte == 0xDA || type_byte == 0xDB) {
+            if(!read_big_endian(std::size_t(1) << (type_byte - 0xD9), value)) return false;
+            string_size = static_cast<std::size_t>(value);
+        }
+        if(static_cast<std::size_t>(end - cursor) < string_size) return false;
+        decoded_json = Json::Value(reinterpret_cast<const char *>(cursor), reinterpret_cast<const char *>(cursor) + string_size);
+        cursor += string_size;
+        return true;
+    } else {
+        switch(type_byte) {
+            case 0xC0 : decoded_json = Json::Value(Json::nullValue); return true;
+            case 0xC2 : decoded_json = Json::Value(false); return true;
+            case 0xC3 : decoded_json = Json::Value(true); return true;
+            case 0xCA : {
+                if(!read_big_endian(4, value)) return false;
+                const uint32_t float_bits = static_cast<uint32_t>(value);
+                float float_value;
+                std::memcpy(&float_value, &float_bits, sizeof(float_value));
+                decoded_json = Json::Value(static_cast<double>(float_value));
+                return true;
+            }
+            case 0xCB : {
+                if(!read_big_endian(8, value)) return false;
+                double double_value;
+                std::memcpy(&double_value, &value, sizeof(double_value));
+                decoded_json = Json::Value(double_value);
+                return true;
+            }
+            case 0xCC : case 0xCD : case 0xCE : case 0xCF :
+                if(!read_big_endian(std::size_t(1) << (type_byte - 0xCC), value)) return false;
+                decoded_json = Json::Value(static_cast<Json::UInt64>(value));
+                return true;
+            case 0xD0 :
+                if(!read_big_endian(1, value)) return false;
+                decoded_json = Json::Value(static_cast<Json::Int64>(static_cast<int8_t>(value)));
+                return true;
+            case 0xD1 :
+                if(!read_big_endian(2, value)) return false;
+                decoded_json = Json::Value(static_cast<Json::Int64>(static_cast<int16_t>(value)));
+                return true;
+            case 0xD2 :
+                if(!read_big_endian(4, value)) return false;
+                decoded_json = Json::Value(static_cast<Json::Int64>(static_cast<int32_t>(value)));
+                return true;
+            case 0xD3 :
+                if(!read_big_endian(8, value)) return false;
+                decoded_json = Json::Value(static_cast<Json::Int64>(value));
+                return true;
+            case 0xDC : case 0xDD :
+                if(!read_big_endian(type_byte == 0xDC ? 2 : 4, value)) return false;
+                container_size = static_cast<std::size_t>(value);
+                break;
+            case 0xDE : case 0xDF :
+                if(!read_big_endian(type_byte == 0xDE ? 2 : 4, value)) return false;
+                container_size = static_cast<std::size_t>(value);
+                is_map = true;
+                break;
+            default :
+                return false;
+        }
+    }
+
+    if(is_map) {
+        decoded_json = Json::Value(Json::objectValue);
+        for(std::size_t i = 0; i < container_size; i++) {
+            Json::Value key_json;
+            if(!this->decode_value(cursor, end, key_json, depth + 1) || !key_json.isString()) return false;
+            if(!this->decode_value(cursor, end, decoded_json[key_json.asString()], depth + 1)) return false;
+        }
+    } else {
+        decoded_json = Json::Value(Json::arrayValue);
+        for(std::size_t i = 0; i < container_size; i++) {
+            if(!this->decode_value(cursor, end, decoded_json[static_cast<Json::ArrayIndex>(i)], depth + 1)) return false;
+        }
+    }
+    return true;
+}
+
+ros_message_encoder::CborDecoder::CborDecoder() {
+
+}
+
+ros_message_encoder::CborDecoder::~CborDecoder() {
+
+}
+
+ros_message_encoder::Encoding ros_message_encoder::CborDecoder::encoding() const {
+    return Encoding::CBOR;
+}
+
+/**
+ * @brief Function for decode CBOR payload into Json::Value
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param raw_payload const std::string&
+ * @param decoded_json Json::Value&
+ * @return bool
+*/
+bool ros_message_encoder::CborDecoder::decode(const std::string& raw_payload, Json::Value& decoded_json) {
+    const uint8_t * cursor = reinterpret_cast<const uint8_t *>(raw_payload.data());
+    const uint8_t * end = cursor + raw_payload.size();
+
+    bool is_decoding_success = this->decode_value(cursor, end, decoded_json, 0) && cursor == end;
+    if(!is_decoding_success) {
+        std::cerr << LOG_ROS_MESSAGE_ENCODER << " decoding CBOR payload err" << '\n';
+    }
+    return is_decoding_success;
+}
+
+/**
+ * @brief Function for recursively decode one CBOR data item, including indefinite length arrays & maps
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param cursor const uint8_t *& advanced past decoded data item
+ * @param end const uint8_t *
+ * @param decoded_json Json::Value&
+ * @param depth int
+ * @return bool
+ * @details negative integers below INT64_MIN(argument above INT64_MAX) are decoded as double, as JSON numbers beyond int64 would be
+*/
+bool ros_message_encoder::CborDecoder::decode_value(const uint8_t *& cursor, const uint8_t * end, Json::Value& decoded_json, int depth) {
+    if(cursor >= end || depth > ROS_MESSAGE_DECODER_MAX_DEPTH) {
+        return false;
+    }
+
+    const uint8_t initial_byte = *cursor++;
+    const uint8_t major_type = initial_byte >> 5;
+    const uint8_t additional_info = initial_byte & 0x1F;
+    const bool is_indefinite = additional_info == 31;
+    uint64_t argument = additional_info;
+
+    if(additional_info >= 24 && additional_info <= 27) {
+        const std::size_t argument_size = std::size_t(1) << (additional_info - 24);
+        if(static_cast<std::size_t>(end - cursor) < argument_size) return false;
+        argument = 0;
+        for(std::size_t i = 0; i < argument_size; i++) {
+            argument = (argument << 8) | *cursor++;
+        }
+    } else if(additional_info > 27 && !(is_indefinite && (major_type == 4 || major_type == 5))) {
+        return false;
+    }
+
+    switch(major_type) {
+        case 0 :
+            decoded_json = Json::Value(static_cast<Json::UInt64>(argument));
+            return true;
+        case 1 :
+            if(argument > static_cast<uint64_t>(INT64_MAX)) {
+                decoded_json = Json::Value(-1.0 - static_cast<double>(argument));
+            } else {
+                decoded_json = Json::Value(-1 - static_cast<Json::Int64>(argument));
+            }
+            return true;
+        case 2 :
+        case 3 :
+            if(static_cast<uint64_t>(end - cursor) < argument) return false;
+            decoded_json = Json::Value(reinterpret_cast<const char *>(cursor), reinterpret_cast<const char *>(cursor) + argument);
+            cursor += argument;
+            return true;
+        case 4 :
+            decoded_json = Json::Value(Json::arrayValue);
+            for(uint64_t i = 0; is_indefinite || i < argument; i++) {
+                if(is_indefinite && cursor < end && *cursor == 0xFF) {
+                    cursor++;
+                    break;
+                }
+                if(!this->decode_value(cursor, end, decoded_json[static_cast<Json::ArrayIndex>(i)], depth + 1)) return false;
+            }
+            return true;
+        case 5 :
+            decoded_json = Json::Value(Json::objectValue);
+            for(uint64_t i = 0; is_indefinite || i < argument; i++) {
+                if(is_indefinite && cursor < end && *cursor == 0xFF) {
+                    cursor++;
+                    break;
+                }
+                Json::Value key_json;
+                if(!this->decode_value(cursor, end, key_json, depth + 1) || !key_json.isString()) return false;
+                if(!this->decode_value(cursor, end, decoded_json[key_json.asString()], depth + 1)) return false;
+            }
+            return true;
+        case 6 :
+            return this->decode_value(cursor, end, decoded_json, depth + 1);
+        default :
+            break;
+    }
+
+    switch(additional_info) {
+        case 20 : decoded_json = Json::Value(false); return true;
+        case 21 : decoded_json = Json::Value(true); return true;
+        case 22 :
+        case 23 : decoded_json = Json::Value(Json::nullValue); return true;
+        case 25 : {
+            const uint16_t half_bits = static_cast<uint16_t>(argument);
+            const int half_exponent = (half_bits >> 10) & 0x1F;
+            const int half_mantissa = half_bits & 0x3FF;
+            double half_value;
+            if(half_exponent == 0) {
+                half_value = std::ldexp(half_mantissa, -24);
+            } else if(half_exponent != 31) {
+                half_value = std::ldexp(half_mantissa + 1024, half_exponent - 25);
+            } else {
+                half_value = half_mantissa == 0 ? INFINITY : NAN;
+            }
+            decoded_json = Json::Value((half_bits & 0x8000) ? -half_value : half_value);
+            return true;
+        }
+        case 26 : {
+            const uint32_t float_bits = static_cast<uint32_t>(argument);
+            float float_value;
+            std::memcpy(&float_value, &float_bits, sizeof(float_value));
+            decoded_json = Json::Value(static_cast<double>(float_value));
+            return true;
+        }
+        case 27 : {
+            double double_value;
+            std::memcpy(&double_value, &argument, sizeof(double_value));
+            decoded_json = Json::Value(double_value);
+            return true;
+        }
+        default :
+            return false;
+    }
+}
+
+/**
+ * @brief Function for get output options which write every field with shortest round trip numbers
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return OutputOptions
+*/
+ros_message_encoder::OutputOptions ros_message_encoder::default_output_options() {
+    const OutputOptions output_options{JSON_SHORTEST_DECIMALS, false, false, false, false, ros_mqtt_path::PathSimplification::NONE, 0.0, 0, ros_mqtt_scan::ScanReduction{0, false, 0.0f, 0.0f, 0.0f}};
+    return output_options;
+}
+
+/**
+ * @brief Function for check whether every element of double array is 0, e.g. covariance which is not estimated
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param double_values const double *
+ * @param double_count std::size_t
+ * @return bool true when array is empty or all zero
+*/
+bool ros_message_encoder::is_zero_array(const double * double_values, std::size_t double_count) {
+    for(std::size_t i = 0; i < double_count; i++) {
+        if(double_values[i] != 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Function for create encoder instance of encoding
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param encoding Encoding
+ * @return MessageEncoder * owned by caller
+*/
+ros_message_encoder::MessageEncoder * ros_message_encoder::create_encoder(Encoding encoding) {
+    switch(encoding) {
+        case Encoding::MSGPACK : return new MessagePackEncoder();
+        case Encoding::CBOR : return new CborEncoder();
+        case Encoding::JSON :
+        default : return new JsonEncoder();
+    }
+}
+
+/**
+ * @brief Function for create decoder instance of encoding
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param encoding Encoding
+ * @return MessageDecoder * owned by caller
+*/
+ros_message_encoder::MessageDecoder * ros_message_encoder::create_decoder(Encoding encoding) {
+    switch(encoding) {
+        case Encoding::MSGPACK : return new MessagePackDecoder();
+        case Encoding::CBOR : return new CborDecoder();
+        case Encoding::JSON :
+        default : return new JsonDecoder();
+    }
+}
+
+/**
+ * @brief Function for read member count & header size of encoded top-level object
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param encoding Encoding
+ * @param encoded_object const std::string&
+ * @param object_size std::size_t& member count, always 0 for JSON since JSON objects carry no count
+ * @param header_size std::size_t& bytes before the first member
+ * @return bool false when encoded_object is not an object
+*/
+bool ros_message_encoder::read_object_header(Encoding encoding, const std::string& encoded_object, std::size_t& object_size, std::size_t& header_size) {
+    if(encoded_object.empty()) {
+        return false;
+    }
+
+    const uint8_t * object_bytes = reinterpret_cast<const uint8_t *>(encoded_object.data());
+    std::size_t size_bytes = 0;
+    object_size = 0;
+
+    if(encoding == Encoding::JSON) {
+        header_size = 1;
+        return object_bytes[0] == '{' && encoded_object.back() == '}';
+    } else if(encoding == Encoding::MSGPACK) {
+        if((object_bytes[0] & 0xF0) == 0x80) {
+            object_size = object_bytes[0] & 0x0F;
+        } else if(object_bytes[0] == 0xDE) {
+            size_bytes = 2;
+        } else if(object_bytes[0] == 0xDF) {
+            size_bytes = 4;
+        } else {
+            return false;
+        }
+    } else {
+        if((object_bytes[0] >> 5) != 5) {
+            return false;
+        }
+        const uint8_t additional_info = object_bytes[0] & 0x1F;
+        if(additional_info < 24) {
+            object_size = additional_info;
+        } else if(additional_info <= 27) {
+            size_bytes = static_cast<std::size_t>(1) << (additional_info - 24);
+        } else {
+            return false;
+        }
+    }
+
+    header_size = 1 + size_bytes;
+    if(encoded_object.size() < header_size) {
+        return false;
+    }
+    for(std::size_t i = 1; i <= size_bytes; i++) {
+        object_size = (object_size << 8) | object_bytes[i];
+    }
+    return true;
+}
+
+/**
+ * @brief Function for append members of encoded object into another encoded object of same encoding
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details MessagePack & CBOR object header is rewritten with merged member count, so it may grow by a few bytes
+ * @param encoding Encoding
+ * @param encoded_object std::string& object to append into
+ * @param encoded_members const std::string& object whose members are appended
+ * @return bool false when either is not an object, encoded_object is then left untouched
+*/
+bool ros_message_encoder::merge_objects(Encoding encoding, std::string& encoded_object, const std::string& encoded_members) {
+    std::size_t object_size = 0;
+    std::size_t object_header_size = 0;
+    std::size_t members_size = 0;
+    std::size_t members_header_size = 0;
+
+    if(!read_object_header(encoding, encoded_object, object_size, object_header_size)
+        || !read_object_header(encoding, encoded_members, members_size, members_header_size)) {
+        return false;
+    }
+
+    if(encoding == Encoding::JSON) {
+        if(encoded_members.size() <= 2) {
+            return true;
+        }
+        encoded_object.pop_back();
+        if(encoded_object.size() > 1) {
+            encoded_object += ',';
+        }
+        encoded_object.append(encoded_members, members_header_size, std::string::npos);
+        return true;
+    }
+
+    MessageEncoder * header_encoder = create_encoder(encoding);
+    header_encoder->begin_object(object_size + members_size);
+    std::string merged_object = header_encoder->release();
+    delete header_encoder;
+
+    merged_object.reserve(merged_object.size() + encoded_object.size() - object_header_size + encoded_members.size() - members_header_size);
+    merged_object.append(encoded_object, object_header_size, std::string::npos);
+    merged_object.append(encoded_members, members_header_size, std::string::npos);
+    encoded_object.swap(merged_object);
+    ros_mqtt_buffer_pool::BufferPool::instance().recycle(merged_object);
+    return true;
+}
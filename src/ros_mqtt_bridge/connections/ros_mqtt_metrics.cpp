@@ -0,0 +1,674 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_metrics.hpp"
+
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+
+/**
+ * @brief Function for get snake_case name of latency stage, used as Prometheus label & diagnostics key
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param latency_stage LatencyStage
+ * @return const char *
+*/
+const char * ros_mqtt_metrics::stage_name(LatencyStage latency_stage) {
+    switch(latency_stage) {
+        case LatencyStage::RECEIVE_TO_CONVERTED :
+            return "receive_to_converted";
+        case LatencyStage::CONVERTED_TO_ACCEPTED :
+            return "converted_to_accepted";
+        case LatencyStage::ACCEPTED_TO_ACKED :
+            return "accepted_to_acked";
+        case LatencyStage::RECEIVE_TO_ACKED :
+            return "receive_to_acked";
+        case LatencyStage::RECEIVE_TO_PUBLISHED :
+            return "receive_to_published";
+        default :
+            return "unknown";
+    }
+}
+
+/**
+ * @brief Function for start latency trace of message which is received now
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return LatencyTrace
+*/
+ros_mqtt_metrics::LatencyTrace ros_mqtt_metrics::start_trace() {
+    LatencyTrace latency_trace;
+    latency_trace.received = std::chrono::steady_clock::now();
+    return latency_trace;
+}
+
+/**
+ * @brief Function for convert ros header stamp into integer nanoseconds without going through double
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param stamp_sec int32_t
+ * @param stamp_nanosec uint32_t
+ * @return int64_t
+*/
+int64_t ros_mqtt_metrics::stamp_nanoseconds(int32_t stamp_sec, uint32_t stamp_nanosec) {
+    return static_cast<int64_t>(stamp_sec) * 1000000000LL + static_cast<int64_t>(stamp_nanosec);
+}
+
+/**
+ * @brief Function for convert steady clock time point into wall clock nanoseconds since epoch, so it compares with ros header stamps
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param steady_time std::chrono::steady_clock::time_point
+ * @return int64_t 0 when steady_time is unknown
+*/
+int64_t ros_mqtt_metrics::wall_nanoseconds(std::chrono::steady_clock::time_point steady_time) {
+    if(steady_time == std::chrono::steady_clock::time_point()) {
+        return 0;
+    }
+    const std::chrono::nanoseconds steady_age = std::chrono::steady_clock::now() - steady_time;
+    const std::chrono::nanoseconds wall_now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+    return (wall_now - steady_age).count();
+}
+
+/**
+ * @brief Function for check whether message is older than deadline of its topic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param latency_trace const LatencyTrace&
+ * @param deadline const Deadline&
+ * @param now std::chrono::steady_clock::time_point
+ * @return bool false for messages with unknown received time, e.g. batch envelopes
+*/
+bool ros_mqtt_metrics::is_expired(const LatencyTrace& latency_trace, const Deadline& deadline, std::chrono::steady_clock::time_point now) {
+    if(deadline.max_age.count() <= 0 || latency_trace.received == std::chrono::steady_clock::time_point()) {
+        return false;
+    }
+
+    std::chrono::nanoseconds message_age = now - latency_trace.received;
+    if(deadline.source == DeadlineSource::SOURCE_STAMP && latency_trace.source_stamp_ns != 0) {
+        message_age = std::chrono::nanoseconds(wall_nanoseconds(now) - latency_trace.source_stamp_ns);
+    }
+    return message_age > deadline.max_age;
+}
+
+/**
+ * @brief Constructor for initialize this class instance with empty buckets
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_metrics::LatencyHistogram::LatencyHistogram()
+: count_(0),
+sum_(0),
+max_(0) {
+    for(std::size_t index = 0; index < bucket_count_; index++) {
+        buckets_[index].store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_metrics::LatencyHistogram::~LatencyHistogram() {
+
+}
+
+/**
+ * @brief Function for get bucket index of value, linear below 2^sub bucket bits & log-linear above
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param value uint64_t
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_metrics::LatencyHistogram::bucket_index(uint64_t value) {
+    const uint64_t max_value = (static_cast<uint64_t>(1) << METRICS_HISTOGRAM_MAX_EXPONENT) - 1;
+    if(value > max_value) {
+        value = max_value;
+    }
+    if(value < sub_bucket_count_) {
+        return static_cast<std::size_t>(value);
+    }
+
+    const int most_significant_bit = 63 - __builtin_clzll(value);
+    const int shift = most_significant_bit - METRICS_HISTOGRAM_SUB_BUCKET_BITS;
+    const std::size_t exponent = static_cast<std::size_t>(shift + 1);
+    const std::size_t sub_bucket = static_cast<std::size_t>((value >> shift) & (sub_bucket_count_ - 1));
+    return exponent * sub_bucket_count_ + sub_bucket;
+}
+
+/**
+ * @brief Function for get highest value which falls into bucket
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param index std::size_t
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_metrics::LatencyHistogram::bucket_upper_bound(std::size_t index) {
+    const std::size_t exponent = index / sub_bucket_count_;
+    const uint64_t sub_bucket = index % sub_bucket_count_;
+    if(exponent == 0) {
+        return sub_bucket;
+    }
+    const uint64_t bucket_width = static_cast<uint64_t>(1) << (exponent - 1);
+    return ((sub_bucket_count_ + sub_bucket) << (exponent - 1)) + bucket_width - 1;
+}
+
+/**
+ * @brief Function for record one latency in nanoseconds
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param value uint64_t
+ * @return void
+*/
+void ros_mqtt_metrics::LatencyHistogram::record(uint64_t value) {
+    buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current_max = max_.load(std::memory_order_relaxed);
+    while(value > current_max && !max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Function for record latency between two time points, skipped when either point is unknown
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param from std::chrono::steady_clock::time_point
+ * @param to std::chrono::steady_clock::time_point
+ * @return void
+*/
+void ros_mqtt_metrics::LatencyHistogram::record(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    const std::chrono::steady_clock::time_point unknown_time = std::chrono::steady_clock::time_point();
+    if(from == unknown_time || to == unknown_time || to < from) {
+        return;
+    }
+    this->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count()));
+}
+
+/**
+ * @brief Function for get number of recorded latencies
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_metrics::LatencyHistogram::count() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for get sum of recorded latencies in nanoseconds
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_metrics::LatencyHistogram::sum() const {
+    return sum_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for get maximum recorded latency in nanoseconds
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_metrics::LatencyHistogram::max() const {
+    return max_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for get latency at quantile in nanoseconds, 0 when nothing is recorded
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param quantile double in [0, 1]
+ * @return uint64_t highest value of the bucket the quantile falls into, capped at recorded maximum
+*/
+uint64_t ros_mqtt_metrics::LatencyHistogram::percentile(double quantile) const {
+    uint64_t total_count = 0;
+    for(std::size_t index = 0; index < bucket_count_; index++) {
+        total_count += buckets_[index].load(std::memory_order_relaxed);
+    }
+    if(total_count == 0) {
+        return 0;
+    }
+
+    uint64_t target_count = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(total_count)));
+    if(target_count == 0) {
+        target_count = 1;
+    }
+
+    uint64_t cumulative_count = 0;
+    const uint64_t recorded_max = this->max();
+    for(std::size_t index = 0; index < bucket_count_; index++) {
+        cumulative_count += buckets_[index].load(std::memory_order_relaxed);
+        if(cumulative_count >= target_count) {
+            const uint64_t upper_bound = bucket_upper_bound(index);
+            return upper_bound < recorded_max ? upper_bound : recorded_max;
+        }
+    }
+    return recorded_max;
+}
+
+/**
+ * @brief Constructor for initialize this struct instance with zero counters
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param metrics_direction const std::string& egress(ros to mqtt) or ingress(mqtt to ros)
+*/
+ros_mqtt_metrics::TopicMetrics::TopicMetrics(const std::string& metrics_direction)
+: direction(metrics_direction),
+messages_in(0),
+messages_out(0),
+bytes_in(0),
+bytes_out(0),
+drops(0),
+conversion_errors(0),
+stale_drops(0) {
+
+}
+
+/**
+ * @brief Function for get latency histogram of stage
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param latency_stage LatencyStage
+ * @return LatencyHistogram&
+*/
+ros_mqtt_metrics::LatencyHistogram& ros_mqtt_metrics::TopicMetrics::latency(LatencyStage latency_stage) {
+    return latencies[static_cast<std::size_t>(latency_stage)];
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_metrics::MetricsRegistry::MetricsRegistry() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class & delete per-topic metrics
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_metrics::MetricsRegistry::~MetricsRegistry() {
+    for(std::pair<const std::string, TopicMetrics *>& topic_metrics : topic_metrics_) {
+        delete topic_metrics.second;
+    }
+}
+
+/**
+ * @brief Function for register topic, returns already registered metrics when topic is registered twice
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param topic const std::string&
+ * @param direction const std::string&
+ * @return TopicMetrics *
+*/
+ros_mqtt_metrics::TopicMetrics * ros_mqtt_metrics::MetricsRegistry::register_topic(const std::string& topic, const std::string& direction) {
+    std::map<std::string, TopicMetrics *, std::less<>>::iterator topic_metrics = topic_metrics_.find(topic);
+    if(topic_metrics != topic_metrics_.end()) {
+        return topic_metrics->second;
+    }
+
+    TopicMetrics * registered_topic_metrics = new TopicMetrics(direction);
+    topic_metrics_[topic] = registered_topic_metrics;
+    return registered_topic_metrics;
+}
+
+/**
+ * @brief Function for register gauge which is sampled on every export, e.g. queue depths
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param gauge_name const std::string& Prometheus metric name without prefix
+ * @param gauge_function std::function<double()>
+ * @return void
+*/
+void ros_mqtt_metrics::MetricsRegistry::register_gauge(const std::string& gauge_name, std::function<double()> gauge_function) {
+    gauges_.push_back(std::make_pair(gauge_name, gauge_function));
+}
+
+/**
+ * @brief Function for find metrics of topic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param topic const std::string&
+ * @return TopicMetrics * nullptr when topic is not registered
+*/
+ros_mqtt_metrics::TopicMetrics * ros_mqtt_metrics::MetricsRegistry::find(const std::string& topic) const {
+    std::map<std::string, TopicMetrics *, std::less<>>::const_iterator topic_metrics = topic_metrics_.find(topic);
+    if(topic_metrics == topic_metrics_.end()) {
+        return nullptr;
+    }
+    return topic_metrics->second;
+}
+
+/**
+ * @brief Function for find metrics of topic, compares against registered topics without building std::string of it
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param topic const char *
+ * @return TopicMetrics * nullptr when topic is not registered
+*/
+ros_mqtt_metrics::TopicMetrics * ros_mqtt_metrics::MetricsRegistry::find(const char * topic) const {
+    std::map<std::string, TopicMetrics *, std::less<>>::const_iterator topic_metrics = topic_metrics_.find(topic);
+    if(topic_metrics == topic_metrics_.end()) {
+        return nullptr;
+    }
+    return topic_metrics->second;
+}
+
+/**
+ * @brief Function for get registered per-topic metrics
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return const std::map<std::string, TopicMetrics *, std::less<>>&
+*/
+const std::map<std::string, ros_mqtt_metrics::TopicMetrics *, std::less<>>& ros_mqtt_metrics::MetricsRegistry::topics() const {
+    return topic_metrics_;
+}
+
+/**
+ * @brief Function for get registered gauges
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return const std::vector<std::pair<std::string, std::function<double()>>>&
+*/
+const std::vector<std::pair<std::string, std::function<double()>>>& ros_mqtt_metrics::MetricsRegistry::gauges() const {
+    return gauges_;
+}
+
+/**
+ * @brief Function for escape Prometheus label value
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param label_value const std::string&
+ * @return std::string
+*/
+std::string ros_mqtt_metrics::escape_label(const std::string& label_value) {
+    std::string escaped_label;
+    escaped_label.reserve(label_value.size());
+    for(const char label_char : label_value) {
+        if(label_char == '\\' || label_char == '"') {
+            escaped_label.push_back('\\');
+            escaped_label.push_back(label_char);
+        } else if(label_char == '\n') {
+            escaped_label.append("\\n");
+        } else {
+            escaped_label.push_back(label_char);
+        }
+    }
+    return escaped_label;
+}
+
+/**
+ * @brief Function for format number with up to 9 significant digits, independent of stream state
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param value double
+ * @return std::string
+*/
+std::string ros_mqtt_metrics::format_number(double value) {
+    char number_buffer[32];
+    std::snprintf(number_buffer, sizeof(number_buffer), "%.9g", value);
+    return std::string(number_buffer);
+}
+
+/**
+ * @brief Function for append one counter family over all topics into Prometheus text
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param prometheus_text std::string&
+ * @param metric_name const std::string&
+ * @param metric_help const char *
+ * @param counter std::atomic<uint64_t> TopicMetrics::*
+ * @return void
+*/
+void ros_mqtt_metrics::MetricsRegistry::append_counter(std::string& prometheus_text, const std::string& metric_name, const char * metric_help, std::atomic<uint64_t> TopicMetrics::* counter) const {
+    prometheus_text += "# HELP " + metric_name + " " + metric_help + "\n";
+    prometheus_text += "# TYPE " + metric_name + " counter\n";
+    for(const std::pair<const std::string, TopicMetrics *>& topic_metric : topic_metrics_) {
+        prometheus_text += metric_name + "{topic=\"" + escape_label(topic_metric.first) + "\",direction=\"" + topic_metric.second->direction + "\"} "
+            + std::to_string((topic_metric.second->*counter).load(std::memory_order_relaxed)) + "\n";
+    }
+}
+
+/**
+ * @brief Function for serialize all metrics into Prometheus text exposition format
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param metrics_prefix const std::string& prefix of every metric name, e.g. ros_mqtt_bridge
+ * @return std::string
+ * @details latencies are exposed as summaries in seconds with p50, p90, p99 & p999 quantiles
+*/
+std::string ros_mqtt_metrics::MetricsRegistry::to_prometheus(const std::string& metrics_prefix) const {
+    std::string prometheus_text;
+
+    this->append_counter(prometheus_text, metrics_prefix + "_messages_in_total", "Messages received per topic", &TopicMetrics::messages_in);
+    this->append_counter(prometheus_text, metrics_prefix + "_messages_out_total", "Messages forwarded per topic", &TopicMetrics::messages_out);
+    this->append_counter(prometheus_text, metrics_prefix + "_bytes_in_total", "Payload bytes received per topic", &TopicMetrics::bytes_in);
+    this->append_counter(prometheus_text, metrics_prefix + "_bytes_out_total", "Payload bytes forwarded per topic", &TopicMetrics::bytes_out);
+    this->append_counter(prometheus_text, metrics_prefix + "_drops_total", "Messages dropped per topic", &TopicMetrics::drops);
+    this->append_counter(prometheus_text, metrics_prefix + "_conversion_errors_total", "Messages which could not be converted per topic", &TopicMetrics::conversion_errors);
+    this->append_counter(prometheus_text, metrics_prefix + "_stale_drops_total", "Messages dropped past their deadline per topic", &TopicMetrics::stale_drops);
+
+    const std::string latency_name = metrics_prefix + "_latency_seconds";
+    const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    prometheus_text += "# HELP " + latency_name + " Per-stage latency per topic\n";
+    prometheus_text += "# TYPE " + latency_name + " summary\n";
+    for(const std::pair<const std::string, TopicMetrics *>& topic_metric : topic_metrics_) {
+        for(std::size_t stage_index = 0; stage_index < static_cast<std::size_t>(LatencyStage::COUNT); stage_index++) {
+            const LatencyHistogram& latency_histogram = topic_metric.second->latencies[stage_index];
+            if(latency_histogram.count() == 0) {
+                continue;
+            }
+            const std::string latency_labels = "topic=\"" + escape_label(topic_metric.first) + "\",direction=\"" + topic_metric.second->direction
+                + "\",stage=\"" + stage_name(static_cast<LatencyStage>(stage_index)) + "\"";
+            for(const double quantile : quantiles) {
+                prometheus_text += latency_name + "{" + latency_labels + ",quantile=\"" + format_number(quantile) + "\"} "
+                    + format_number(static_cast<double>(latency_histogram.percentile(quantile)) / 1e9) + "\n";
+            }
+            prometheus_text += latency_name + "_sum{" + latency_labels + "} " + format_number(static_cast<double>(latency_histogram.sum()) / 1e9) + "\n";
+            prometheus_text += latency_name + "_count{" + latency_labels + "} " + std::to_string(latency_histogram.count()) + "\n";
+        }
+    }
+
+    for(const std::pair<std::string, std::function<double()>>& gauge : gauges_) {
+        const std::string gauge_name = metrics_prefix + "_" + gauge.first;
+        prometheus_text += "# TYPE " + gauge_name + " gauge\n";
+        prometheus_text += gauge_name + " " + format_number(gauge.second()) + "\n";
+    }
+
+    return prometheus_text;
+}
+
+/**
+ * @brief Function for write Prometheus text into file through temporary file & rename
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param metrics_prefix const std::string&
+ * @param prometheus_file_path const std::string&
+ * @return bool
+*/
+bool ros_mqtt_metrics::MetricsRegistry::write_prometheus_file(const std::string& metrics_prefix, const std::string& prometheus_file_path) const {
+    const std::string temporary_file_path = prometheus_file_path + ".tmp";
+    {
+        std::ofstream prometheus_file(temporary_file_path, std::ios::out | std::ios::trunc);
+        if(!prometheus_file) {
+            std::cerr << LOG_ROS_MQTT_METRICS << " open prometheus file err : " << temporary_file_path << '\n';
+            return false;
+        }
+        prometheus_file << this->to_prometheus(metrics_prefix);
+        if(!prometheus_file) {
+            std::cerr << LOG_ROS_MQTT_METRICS << " write prometheus file err : " << temporary_file_path << '\n';
+            return false;
+        }
+    }
+
+    if(std::rename(temporary_file_path.c_str(), prometheus_file_path.c_str()) != 0) {
+        std::cerr << LOG_ROS_MQTT_METRICS << " rename prometheus file err : " << prometheus_file_path << '\n';
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Constructor for initialize this class instance & create diagnostics publisher with export timer
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param ros_node_ptr std::shared_ptr<rclcpp::Node>
+ * @param metrics_registry const MetricsRegistry&
+ * @param metrics_prefix const std::string&
+ * @param diagnostics_topic const std::string&
+ * @param prometheus_file_path const std::string& Prometheus file is not written when empty
+ * @param publish_period std::chrono::milliseconds
+*/
+ros_mqtt_metrics::MetricsExporter::MetricsExporter(std::shared_ptr<rclcpp::Node> ros_node_ptr, const MetricsRegistry& metrics_registry, const std::string& metrics_prefix, const std::string& diagnostics_topic, const std::string& prometheus_file_path, std::chrono::milliseconds publish_period)
+: ros_node_ptr_(ros_node_ptr),
+metrics_registry_(metrics_registry),
+metrics_prefix_(metrics_prefix),
+prometheus_file_path_(prometheus_file_path) {
+    try {
+        ros_diagnostics_publisher_ptr_ = ros_node_ptr_->create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+            diagnostics_topic,
+            rclcpp::QoS(rclcpp::KeepLast(1))
+        );
+        metrics_timer_ptr_ = ros_node_ptr_->create_wall_timer(
+            publish_period,
+            [this]() {
+                export_metrics();
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << LOG_ROS_MQTT_METRICS << " exporter err : " << rcl_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_metrics::MetricsExporter::~MetricsExporter() {
+
+}
+
+/**
+ * @brief Function for build one DiagnosticStatus per topic & one for gauges
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return diagnostic_msgs::msg::DiagnosticArray
+ * @details topic level is WARN when it dropped or failed to convert messages since last export
+*/
+diagnostic_msgs::msg::DiagnosticArray ros_mqtt_metrics::MetricsExporter::build_diagnostics() {
+    diagnostic_msgs::msg::DiagnosticArray diagnostic_array;
+    diagnostic_array.header.stamp = ros_node_ptr_->now();
+
+    for(const std::pair<const std::string, TopicMetrics *>& topic_metric : metrics_registry_.topics()) {
+        TopicMetrics& topic_metrics = *topic_metric.second;
+        diagnostic_msgs::msg::DiagnosticStatus diagnostic_status;
+        diagnostic_status.name = metrics_prefix_ + ": " + topic_metric.first;
+        diagnostic_status.hardware_id = metrics_prefix_;
+
+        const uint64_t topic_faults = topic_metrics.drops.load(std::memory_order_relaxed)
+            + topic_metrics.conversion_errors.load(std::memory_order_relaxed)
+            + topic_metrics.stale_drops.load(std::memory_order_relaxed);
+        uint64_t& last_topic_faults = last_faults_[topic_metric.first];
+        if(topic_faults > last_topic_faults) {
+            diagnostic_status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+            diagnostic_status.message = std::to_string(topic_faults - last_topic_faults) + " drops, stale drops or conversion errors";
+        } else {
+            diagnostic_status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+            diagnostic_status.message = "OK";
+        }
+        last_topic_faults = topic_faults;
+
+        const std::pair<const char *, uint64_t> topic_counters[] = {
+            {"messages_in", topic_metrics.messages_in.load(std::memory_order_relaxed)},
+            {"messages_out", topic_metrics.messages_out.load(std::memory_order_relaxed)},
+            {"bytes_in", topic_metrics.bytes_in.load(std::memory_order_relaxed)},
+            {"bytes_out", topic_metrics.bytes_out.load(std::memory_order_relaxed)},
+            {"drops", topic_metrics.drops.load(std::memory_order_relaxed)},
+            {"conversion_errors", topic_metrics.conversion_errors.load(std::memory_order_relaxed)},
+            {"stale_drops", topic_metrics.stale_drops.load(std::memory_order_relaxed)}
+        };
+        for(const std::pair<const char *, uint64_t>& topic_counter : topic_counters) {
+            diagnostic_msgs::msg::KeyValue counter_key_value;
+            counter_key_value.key = topic_counter.first;
+            counter_key_value.value = std::to_string(topic_counter.second);
+            diagnostic_status.values.push_back(counter_key_value);
+        }
+
+        for(std::size_t stage_index = 0; stage_index < static_cast<std::size_t>(LatencyStage::COUNT); stage_index++) {
+            const LatencyHistogram& latency_histogram = topic_metrics.latencies[stage_index];
+            if(latency_histogram.count() == 0) {
+                continue;
+            }
+            const std::string latency_key = stage_name(static_cast<LatencyStage>(stage_index));
+            const std::pair<std::string, uint64_t> latency_values[] = {
+                {latency_key + "_p50_us", latency_histogram.percentile(0.5) / 1000},
+                {latency_key + "_p99_us", latency_histogram.percentile(0.99) / 1000},
+                {latency_key + "_max_us", latency_histogram.max() / 1000}
+            };
+            for(const std::pair<std::string, uint64_t>& latency_value : latency_values) {
+                diagnostic_msgs::msg::KeyValue latency_key_value;
+                latency_key_value.key = latency_value.first;
+                latency_key_value.value = std::to_string(latency_value.second);
+                diagnostic_status.values.push_back(latency_key_value);
+            }
+        }
+
+        diagnostic_array.status.push_back(diagnostic_status);
+    }
+
+    if(!metrics_registry_.gauges().empty()) {
+        diagnostic_msgs::msg::DiagnosticStatus gauge_status;
+        gauge_status.name = metrics_prefix_ + ": queues";
+        gauge_status.hardware_id = metrics_prefix_;
+        gauge_status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+        gauge_status.message = "OK";
+        for(const std::pair<std::string, std::function<double()>>& gauge : metrics_registry_.gauges()) {
+            diagnostic_msgs::msg::KeyValue gauge_key_value;
+            gauge_key_value.key = gauge.first;
+            gauge_key_value.value = format_number(gauge.second());
+            gauge_status.values.push_back(gauge_key_value);
+        }
+        diagnostic_array.status.push_back(gauge_status);
+    }
+
+    return diagnostic_array;
+}
+
+/**
+ * @brief Function for publish diagnostics & write Prometheus file once
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_metrics::MetricsExporter::export_metrics() {
+    if(ros_diagnostics_publisher_ptr_ != nullptr) {
+        try {
+            ros_diagnostics_publisher_ptr_->publish(this->build_diagnostics());
+        } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+            std::cerr << LOG_ROS_MQTT_METRICS << " publish diagnostics err : " << rcl_expn.what() << '\n';
+        }
+    }
+
+    if(!prometheus_file_path_.empty()) {
+        metrics_registry_.write_prometheus_file(metrics_prefix_, prometheus_file_path_);
+    }
+}
@@ -0,0 +1,134 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_path_delta.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param keyframe_interval std::size_t a keyframe every keyframe_interval messages, 0 sends keyframes only when they are needed
+ * @param pose_stride std::size_t count of values per pose
+*/
+ros_mqtt_path::PathDelta::PathDelta(std::size_t keyframe_interval, std::size_t pose_stride)
+: keyframe_interval_(keyframe_interval),
+pose_stride_(pose_stride),
+sequence_(0),
+deltas_since_keyframe_(0),
+is_keyframe_requested_(true),
+keyframe_count_(0),
+delta_count_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_path::PathDelta::~PathDelta() {
+
+}
+
+/**
+ * @brief Function for compute splice of next poses against last poses & keep next poses as last poses
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param frame_id const std::string& frame of next poses
+ * @param pose_values const std::vector<double>& pose_stride values per pose
+ * @return PathSplice sequence starts from 1 & grows by 1 per call, so receivers detect a missed message
+*/
+ros_mqtt_path::PathSplice ros_mqtt_path::PathDelta::next(const std::string& frame_id, const std::vector<double>& pose_values) {
+    const std::size_t pose_count = pose_values.size() / pose_stride_;
+    const std::size_t last_pose_count = last_values_.size() / pose_stride_;
+    const std::size_t common_limit = std::min(pose_count, last_pose_count);
+
+    std::size_t prefix_count = 0;
+    while(prefix_count < common_limit && is_pose_equal(&pose_values[prefix_count * pose_stride_], &last_values_[prefix_count * pose_stride_])) {
+        prefix_count++;
+    }
+    std::size_t suffix_count = 0;
+    while(suffix_count < common_limit - prefix_count
+        && is_pose_equal(&pose_values[(pose_count - 1 - suffix_count) * pose_stride_], &last_values_[(last_pose_count - 1 - suffix_count) * pose_stride_])) {
+        suffix_count++;
+    }
+
+    const bool is_requested = is_keyframe_requested_.exchange(false, std::memory_order_acq_rel);
+    sequence_++;
+    PathSplice path_splice{false, sequence_, prefix_count, last_pose_count - prefix_count - suffix_count, pose_count - prefix_count - suffix_count};
+    const bool is_keyframe = is_requested
+        || frame_id != last_frame_id_
+        || (keyframe_interval_ != 0 && deltas_since_keyframe_ + 1 >= keyframe_interval_)
+        || path_splice.inserted_count * 2 > pose_count;
+
+    if(is_keyframe) {
+        path_splice = PathSplice{true, sequence_, 0, last_pose_count, pose_count};
+        deltas_since_keyframe_ = 0;
+        keyframe_count_++;
+    } else {
+        deltas_since_keyframe_++;
+        delta_count_++;
+    }
+
+    last_values_.assign(pose_values.begin(), pose_values.end());
+    if(frame_id != last_frame_id_) {
+        last_frame_id_ = frame_id;
+    }
+    return path_splice;
+}
+
+/**
+ * @brief Function for make next message a keyframe, e.g. after receivers lost their state, callable from any thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_path::PathDelta::request_keyframe() {
+    is_keyframe_requested_.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Function for get count of keyframes
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_path::PathDelta::keyframe_count() const {
+    return keyframe_count_;
+}
+
+/**
+ * @brief Function for get count of deltas
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_path::PathDelta::delta_count() const {
+    return delta_count_;
+}
+
+/**
+ * @brief Function for compare two poses bitwise
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param first_pose const double *
+ * @param second_pose const double *
+ * @return bool
+*/
+bool ros_mqtt_path::PathDelta::is_pose_equal(const double * first_pose, const double * second_pose) const {
+    return std::memcmp(first_pose, second_pose, pose_stride_ * sizeof(double)) == 0;
+}
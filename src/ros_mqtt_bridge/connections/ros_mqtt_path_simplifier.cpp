@@ -0,0 +1,278 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_path_simplifier.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+/**
+ * @brief Function for compare area entries, so std heap functions keep smallest area on top
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param first_entry const ros_mqtt_path::AreaEntry&
+ * @param second_entry const ros_mqtt_path::AreaEntry&
+ * @return bool
+*/
+bool ros_mqtt_path::is_larger_area(const ros_mqtt_path::AreaEntry& first_entry, const ros_mqtt_path::AreaEntry& second_entry) {
+    if(first_entry.area != second_entry.area) {
+        return first_entry.area > second_entry.area;
+    }
+    return first_entry.index > second_entry.index;
+}
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_path::PathSimplifier::PathSimplifier() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_path::PathSimplifier::~PathSimplifier() {
+
+}
+
+/**
+ * @brief Function for simplify path & limit count of its points
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_points const std::vector<PathPoint>&
+ * @param path_simplification PathSimplification
+ * @param tolerance double meters
+ * @param max_points std::size_t 0 keeps every point which simplification kept, limits below 2 keep first & last point
+ * @return const std::vector<std::size_t>& ascending indices of kept points, valid until next call
+ * @details Visvalingam-Whyatt keeps removing smallest triangles until max_points is reached, other simplifications are thinned evenly afterwards
+*/
+const std::vector<std::size_t>& ros_mqtt_path::PathSimplifier::simplify(const std::vector<PathPoint>& path_points, PathSimplification path_simplification, double tolerance, std::size_t max_points) {
+    kept_indices_.clear();
+    if(max_points != 0 && max_points < 2) {
+        max_points = 2;
+    }
+
+    if(path_points.size() <= 2 || path_simplification == PathSimplification::NONE) {
+        for(std::size_t i = 0; i < path_points.size(); i++) {
+            kept_indices_.push_back(i);
+        }
+    } else if(path_simplification == PathSimplification::DOUGLAS_PEUCKER) {
+        this->simplify_douglas_peucker(path_points, tolerance);
+    } else {
+        this->simplify_visvalingam(path_points, tolerance, max_points);
+    }
+
+    this->limit_points(max_points);
+    return kept_indices_;
+}
+
+/**
+ * @brief Function for simplify path with Douglas-Peucker algorithm
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_points const std::vector<PathPoint>& more than 2 points
+ * @param tolerance double
+ * @return void
+ * @details segments are split on an explicit stack, so paths of thousands of points do not recurse deeply
+*/
+void ros_mqtt_path::PathSimplifier::simplify_douglas_peucker(const std::vector<PathPoint>& path_points, double tolerance) {
+    const std::size_t point_count = path_points.size();
+    is_kept_.assign(point_count, false);
+    is_kept_[0] = true;
+    is_kept_[point_count - 1] = true;
+
+    segment_stack_.clear();
+    segment_stack_.push_back(std::make_pair(static_cast<std::size_t>(0), point_count - 1));
+    while(!segment_stack_.empty()) {
+        const std::pair<std::size_t, std::size_t> segment = segment_stack_.back();
+        segment_stack_.pop_back();
+
+        double farthest_distance = -1.0;
+        std::size_t farthest_index = segment.first;
+        for(std::size_t i = segment.first + 1; i < segment.second; i++) {
+            const double distance = segment_distance(path_points[i], path_points[segment.first], path_points[segment.second]);
+            if(distance > farthest_distance) {
+                farthest_distance = distance;
+                farthest_index = i;
+            }
+        }
+
+        if(farthest_index != segment.first && farthest_distance > tolerance) {
+            is_kept_[farthest_index] = true;
+            segment_stack_.push_back(std::make_pair(segment.first, farthest_index));
+            segment_stack_.push_back(std::make_pair(farthest_index, segment.second));
+        }
+    }
+
+    for(std::size_t i = 0; i < point_count; i++) {
+        if(is_kept_[i]) {
+            kept_indices_.push_back(i);
+        }
+    }
+}
+
+/**
+ * @brief Function for simplify path with Visvalingam-Whyatt algorithm
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_points const std::vector<PathPoint>& more than 2 points
+ * @param tolerance double points with smaller area than tolerance squared are removed
+ * @param max_points std::size_t 0 or at least 2
+ * @return void
+*/
+void ros_mqtt_path::PathSimplifier::simplify_visvalingam(const std::vector<PathPoint>& path_points, double tolerance, std::size_t max_points) {
+    const std::size_t point_count = path_points.size();
+    const double area_threshold = tolerance * tolerance;
+    is_kept_.assign(point_count, true);
+    previous_indices_.resize(point_count);
+    next_indices_.resize(point_count);
+    areas_.assign(point_count, 0.0);
+    area_heap_.clear();
+
+    for(std::size_t i = 0; i < point_count; i++) {
+        previous_indices_[i] = i - 1;
+        next_indices_[i] = i + 1;
+    }
+    for(std::size_t i = 1; i + 1 < point_count; i++) {
+        this->update_area(path_points, i, 0.0);
+    }
+
+    std::size_t remaining_count = point_count;
+    while(!area_heap_.empty()) {
+        std::pop_heap(area_heap_.begin(), area_heap_.end(), is_larger_area);
+        const AreaEntry area_entry = area_heap_.back();
+        area_heap_.pop_back();
+        if(!is_kept_[area_entry.index] || area_entry.area != areas_[area_entry.index]) {
+            continue;
+        }
+        if(area_entry.area >= area_threshold && (max_points == 0 || remaining_count <= max_points)) {
+            break;
+        }
+
+        const std::size_t previous_index = previous_indices_[area_entry.index];
+        const std::size_t next_index = next_indices_[area_entry.index];
+        is_kept_[area_entry.index] = false;
+        next_indices_[previous_index] = next_index;
+        previous_indices_[next_index] = previous_index;
+        remaining_count--;
+
+        if(previous_index != 0) {
+            this->update_area(path_points, previous_index, area_entry.area);
+        }
+        if(next_index != point_count - 1) {
+            this->update_area(path_points, next_index, area_entry.area);
+        }
+    }
+
+    for(std::size_t i = 0; i < point_count; i++) {
+        if(is_kept_[i]) {
+            kept_indices_.push_back(i);
+        }
+    }
+}
+
+/**
+ * @brief Function for compute effective area of point with its current neighbours & push it into heap
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_points const std::vector<PathPoint>&
+ * @param index std::size_t neither first nor last point
+ * @param removed_area double area of neighbour which was removed, a point is never given a smaller area than it
+ * @return void
+*/
+void ros_mqtt_path::PathSimplifier::update_area(const std::vector<PathPoint>& path_points, std::size_t index, double removed_area) {
+    double area = triangle_area(path_points[previous_indices_[index]], path_points[index], path_points[next_indices_[index]]);
+    if(area < removed_area) {
+        area = removed_area;
+    }
+    areas_[index] = area;
+    area_heap_.push_back(AreaEntry{area, index});
+    std::push_heap(area_heap_.begin(), area_heap_.end(), is_larger_area);
+}
+
+/**
+ * @brief Function for thin kept points evenly down to max points, first & last point stay
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param max_points std::size_t 0 or at least 2
+ * @return void
+*/
+void ros_mqtt_path::PathSimplifier::limit_points(std::size_t max_points) {
+    const std::size_t kept_count = kept_indices_.size();
+    if(max_points == 0 || kept_count <= max_points) {
+        return;
+    }
+
+    for(std::size_t i = 0; i < max_points; i++) {
+        kept_indices_[i] = kept_indices_[(i * (kept_count - 1)) / (max_points - 1)];
+    }
+    kept_indices_.resize(max_points);
+}
+
+/**
+ * @brief Function for get distance between point & line segment
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param point const PathPoint&
+ * @param segment_begin const PathPoint&
+ * @param segment_end const PathPoint&
+ * @return double distance to nearest point of segment, distance to segment_begin when segment has no length
+*/
+double ros_mqtt_path::segment_distance(const PathPoint& point, const PathPoint& segment_begin, const PathPoint& segment_end) {
+    const double segment_x = segment_end.x - segment_begin.x;
+    const double segment_y = segment_end.y - segment_begin.y;
+    const double segment_z = segment_end.z - segment_begin.z;
+    const double point_x = point.x - segment_begin.x;
+    const double point_y = point.y - segment_begin.y;
+    const double point_z = point.z - segment_begin.z;
+
+    const double segment_length_squared = segment_x * segment_x + segment_y * segment_y + segment_z * segment_z;
+    double projection = 0.0;
+    if(segment_length_squared > 0.0) {
+        projection = (point_x * segment_x + point_y * segment_y + point_z * segment_z) / segment_length_squared;
+        projection = std::min(1.0, std::max(0.0, projection));
+    }
+
+    const double offset_x = point_x - projection * segment_x;
+    const double offset_y = point_y - projection * segment_y;
+    const double offset_z = point_z - projection * segment_z;
+    return std::sqrt(offset_x * offset_x + offset_y * offset_y + offset_z * offset_z);
+}
+
+/**
+ * @brief Function for get area of triangle of three points
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param first_point const PathPoint&
+ * @param second_point const PathPoint&
+ * @param third_point const PathPoint&
+ * @return double
+*/
+double ros_mqtt_path::triangle_area(const PathPoint& first_point, const PathPoint& second_point, const PathPoint& third_point) {
+    const double first_x = second_point.x - first_point.x;
+    const double first_y = second_point.y - first_point.y;
+    const double first_z = second_point.z - first_point.z;
+    const double second_x = third_point.x - first_point.x;
+    const double second_y = third_point.y - first_point.y;
+    const double second_z = third_point.z - first_point.z;
+
+    const double cross_x = first_y * second_z - first_z * second_y;
+    const double cross_y = first_z * second_x - first_x * second_z;
+    const double cross_z = first_x * second_y - first_y * second_x;
+    return 0.5 * std::sqrt(cross_x * cross_x + cross_y * cross_y + cross_z * cross_z);
+}
@@ -0,0 +1,144 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_scan_reducer.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#define SCAN_CROP_EPSILON_BEAMS 1e-4
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_scan::ScanReducer::ScanReducer() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_scan::ScanReducer::~ScanReducer() {
+
+}
+
+/**
+ * @brief Function for crop, decimate & clamp scan
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param scan_view const ScanView&
+ * @param scan_reduction const ScanReduction&
+ * @return ScanView scan_view itself when nothing is reduced, otherwise ranges & intensities point into this reducer & are valid until next call.
+ * pooled beams are spread evenly over the cropped beams, so angle_min & angle_increment are of the group centres & time_increment grows with the group size
+ * & intensities are left out when scan has not one per range
+*/
+ros_mqtt_scan::ScanView ros_mqtt_scan::ScanReducer::reduce(const ScanView& scan_view, const ScanReduction& scan_reduction) {
+    if(!is_reduced(scan_reduction)) {
+        return scan_view;
+    }
+
+    std::size_t first_beam = 0;
+    std::size_t cropped_count = scan_view.range_count;
+    if(scan_reduction.is_cropped && scan_view.angle_increment != 0.0f) {
+        const double window_shifts[] = {0.0, 2.0 * M_PI, -2.0 * M_PI};
+        cropped_count = 0;
+        for(const double window_shift : window_shifts) {
+            double lower_beam = (scan_reduction.crop_angle_min + window_shift - scan_view.angle_min) / scan_view.angle_increment;
+            double upper_beam = (scan_reduction.crop_angle_max + window_shift - scan_view.angle_min) / scan_view.angle_increment;
+            if(scan_view.angle_increment < 0.0f) {
+                std::swap(lower_beam, upper_beam);
+            }
+            const double window_begin = std::max(0.0, std::ceil(lower_beam - SCAN_CROP_EPSILON_BEAMS));
+            const double window_end = std::min(static_cast<double>(scan_view.range_count), std::floor(upper_beam + SCAN_CROP_EPSILON_BEAMS) + 1.0);
+            if(window_end > window_begin && static_cast<std::size_t>(window_end - window_begin) > cropped_count) {
+                first_beam = static_cast<std::size_t>(window_begin);
+                cropped_count = static_cast<std::size_t>(window_end - window_begin);
+            }
+        }
+    }
+
+    std::size_t pooled_count = cropped_count;
+    if(scan_reduction.beam_count != 0 && cropped_count > scan_reduction.beam_count) {
+        pooled_count = scan_reduction.beam_count;
+    }
+    const float group_size = pooled_count == 0 ? 1.0f : static_cast<float>(cropped_count) / pooled_count;
+    const bool is_intensity_pooled = scan_view.intensity_count != 0 && scan_view.intensity_count == scan_view.range_count;
+
+    ranges_.resize(pooled_count);
+    intensities_.resize(is_intensity_pooled ? pooled_count : 0);
+    for(std::size_t pooled_beam = 0; pooled_beam < pooled_count; pooled_beam++) {
+        const std::size_t group_begin = first_beam + (pooled_beam * cropped_count) / pooled_count;
+        const std::size_t group_end = first_beam + ((pooled_beam + 1) * cropped_count) / pooled_count;
+        std::size_t nearest_beam = group_begin;
+        bool is_valid_found = false;
+        for(std::size_t beam = group_begin; beam < group_end; beam++) {
+            const float range = scan_view.ranges[beam];
+            if(is_valid_range(range, scan_view.range_min, scan_view.range_max) && (!is_valid_found || range < scan_view.ranges[nearest_beam])) {
+                nearest_beam = beam;
+                is_valid_found = true;
+            }
+        }
+
+        float pooled_range = scan_view.ranges[nearest_beam];
+        if(scan_reduction.range_clamp > 0.0f && (!std::isfinite(pooled_range) || pooled_range > scan_reduction.range_clamp)) {
+            pooled_range = scan_reduction.range_clamp;
+        }
+        ranges_[pooled_beam] = pooled_range;
+        if(is_intensity_pooled) {
+            intensities_[pooled_beam] = scan_view.intensities[nearest_beam];
+        }
+    }
+
+    ScanView reduced_view = scan_view;
+    reduced_view.angle_increment = scan_view.angle_increment * group_size;
+    reduced_view.angle_min = scan_view.angle_min + (first_beam + (group_size - 1.0f) * 0.5f) * scan_view.angle_increment;
+    reduced_view.angle_max = reduced_view.angle_min + (pooled_count == 0 ? 0.0f : (pooled_count - 1) * reduced_view.angle_increment);
+    reduced_view.time_increment = scan_view.time_increment * group_size;
+    if(scan_reduction.range_clamp > 0.0f && scan_reduction.range_clamp < scan_view.range_max) {
+        reduced_view.range_max = scan_reduction.range_clamp;
+    }
+    reduced_view.ranges = ranges_.data();
+    reduced_view.range_count = ranges_.size();
+    reduced_view.intensities = intensities_.data();
+    reduced_view.intensity_count = intensities_.size();
+    return reduced_view;
+}
+
+/**
+ * @brief Function for check whether scan reduction changes scans
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param scan_reduction const ScanReduction&
+ * @return bool
+*/
+bool ros_mqtt_scan::is_reduced(const ScanReduction& scan_reduction) {
+    return scan_reduction.beam_count != 0 || scan_reduction.is_cropped || scan_reduction.range_clamp > 0.0f;
+}
+
+/**
+ * @brief Function for check whether range is a return of scan
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param range float
+ * @param range_min float
+ * @param range_max float
+ * @return bool false for nan, inf & ranges outside of range_min & range_max
+*/
+bool ros_mqtt_scan::is_valid_range(float range, float range_min, float range_max) {
+    return std::isfinite(range) && range >= range_min && range <= range_max;
+}
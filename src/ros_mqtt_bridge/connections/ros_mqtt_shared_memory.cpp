@@ -0,0 +1,312 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_shared_memory.hpp"
+
+#include <cstring>
+#include <cerrno>
+#include <new>
+
+/**
+ * @brief Constructor for create shared memory ring, a stale ring of the same name is unlinked first
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param shm_name const std::string& posix shared memory name starting with '/'
+ * @param slot_count std::size_t
+ * @param slot_size std::size_t payload capacity of one slot
+*/
+ros_mqtt_shm::SharedMemoryRing::SharedMemoryRing(const std::string& shm_name, std::size_t slot_count, std::size_t slot_size)
+: shm_name_(shm_name),
+mapped_size_(0),
+mapped_ptr_(nullptr),
+ring_header_ptr_(nullptr) {
+    const std::size_t header_size = align_to_cache_line(sizeof(RingHeader));
+    const std::size_t slot_stride = align_to_cache_line(sizeof(SlotHeader) + slot_size);
+    const std::size_t ring_size = header_size + slot_count * slot_stride;
+
+    shm_unlink(shm_name_.c_str());
+    const int shm_fd = shm_open(shm_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if(shm_fd < 0) {
+        std::cerr << LOG_ROS_MQTT_SHARED_MEMORY << " shm_open " << shm_name_ << " err : " << std::strerror(errno) << '\n';
+        return;
+    }
+    if(ftruncate(shm_fd, static_cast<off_t>(ring_size)) != 0) {
+        std::cerr << LOG_ROS_MQTT_SHARED_MEMORY << " ftruncate " << shm_name_ << " err : " << std::strerror(errno) << '\n';
+        close(shm_fd);
+        shm_unlink(shm_name_.c_str());
+        return;
+    }
+    void * mapped_ptr = mmap(nullptr, ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+    if(mapped_ptr == MAP_FAILED) {
+        std::cerr << LOG_ROS_MQTT_SHARED_MEMORY << " mmap " << shm_name_ << " err : " << std::strerror(errno) << '\n';
+        shm_unlink(shm_name_.c_str());
+        return;
+    }
+
+    mapped_size_ = ring_size;
+    mapped_ptr_ = static_cast<char *>(mapped_ptr);
+    ring_header_ptr_ = new (mapped_ptr_) RingHeader();
+    ring_header_ptr_->version = SHM_RING_VERSION;
+    ring_header_ptr_->slot_count = slot_count;
+    ring_header_ptr_->slot_size = slot_stride;
+    for(std::size_t index = 0; index < slot_count; index++) {
+        new (mapped_ptr_ + header_size + index * slot_stride) SlotHeader();
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    ring_header_ptr_->magic = SHM_RING_MAGIC;
+}
+
+/**
+ * @brief Virtual Destructor for this class & unmap & unlink ring, mapped readers keep their mapping
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_shm::SharedMemoryRing::~SharedMemoryRing() {
+    if(mapped_ptr_ != nullptr) {
+        munmap(mapped_ptr_, mapped_size_);
+        shm_unlink(shm_name_.c_str());
+    }
+}
+
+/**
+ * @brief Function for check ring was created & mapped
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool
+*/
+bool ros_mqtt_shm::SharedMemoryRing::is_open() const {
+    return ring_header_ptr_ != nullptr;
+}
+
+/**
+ * @brief Function for get largest payload one slot holds
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_shm::SharedMemoryRing::payload_capacity() const {
+    return ring_header_ptr_ == nullptr ? 0 : ring_header_ptr_->slot_size - sizeof(SlotHeader);
+}
+
+/**
+ * @brief Function for write payload into next slot with next sequence
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param payload const std::string&
+ * @param encoding uint8_t
+ * @param publish_ns int64_t
+ * @return bool false when ring is not open or payload is larger than a slot, the latter is counted in oversized_drops
+ * @details slot sequence is 0 while the payload is copied, so readers of the overwritten message see it is gone
+*/
+bool ros_mqtt_shm::SharedMemoryRing::write(const std::string& payload, uint8_t encoding, int64_t publish_ns) {
+    if(ring_header_ptr_ == nullptr) {
+        return false;
+    }
+    if(payload.size() > this->payload_capacity()) {
+        ring_header_ptr_->oversized_drops.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> write_lock(write_mutex_);
+    const uint64_t sequence = ring_header_ptr_->write_sequence.load(std::memory_order_relaxed) + 1;
+    char * slot_ptr = mapped_ptr_ + align_to_cache_line(sizeof(RingHeader)) + ((sequence - 1) % ring_header_ptr_->slot_count) * ring_header_ptr_->slot_size;
+    SlotHeader * slot_header_ptr = reinterpret_cast<SlotHeader *>(slot_ptr);
+
+    slot_header_ptr->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot_header_ptr->publish_ns = publish_ns;
+    slot_header_ptr->payload_size = static_cast<uint32_t>(payload.size());
+    slot_header_ptr->encoding = encoding;
+    std::memcpy(slot_ptr + sizeof(SlotHeader), payload.data(), payload.size());
+    slot_header_ptr->sequence.store(sequence, std::memory_order_release);
+    ring_header_ptr_->write_sequence.store(sequence, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Function for get sequence of last written payload, 0 when none
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_shm::SharedMemoryRing::write_sequence() const {
+    return ring_header_ptr_ == nullptr ? 0 : ring_header_ptr_->write_sequence.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Function for get count of payloads which did not fit into a slot
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_shm::SharedMemoryRing::oversized_drops() const {
+    return ring_header_ptr_ == nullptr ? 0 : ring_header_ptr_->oversized_drops.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Constructor for map existing ring read-only & validate its header
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param shm_name const std::string&
+*/
+ros_mqtt_shm::SharedMemoryReader::SharedMemoryReader(const std::string& shm_name)
+: mapped_size_(0),
+mapped_ptr_(nullptr),
+ring_header_ptr_(nullptr) {
+    const int shm_fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if(shm_fd < 0) {
+        std::cerr << LOG_ROS_MQTT_SHARED_MEMORY << " shm_open " << shm_name << " err : " << std::strerror(errno) << '\n';
+        return;
+    }
+    struct stat shm_stat;
+    if(fstat(shm_fd, &shm_stat) != 0 || static_cast<std::size_t>(shm_stat.st_size) < align_to_cache_line(sizeof(RingHeader))) {
+        std::cerr << LOG_ROS_MQTT_SHARED_MEMORY << " " << shm_name << " is not a ring" << '\n';
+        close(shm_fd);
+        return;
+    }
+    const std::size_t ring_size = static_cast<std::size_t>(shm_stat.st_size);
+    void * mapped_ptr = mmap(nullptr, ring_size, PROT_READ, MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+    if(mapped_ptr == MAP_FAILED) {
+        std::cerr << LOG_ROS_MQTT_SHARED_MEMORY << " mmap " << shm_name << " err : " << std::strerror(errno) << '\n';
+        return;
+    }
+
+    const RingHeader * ring_header_ptr = static_cast<const RingHeader *>(mapped_ptr);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(ring_header_ptr->magic != SHM_RING_MAGIC
+        || ring_header_ptr->version != SHM_RING_VERSION
+        || ring_header_ptr->slot_size <= sizeof(SlotHeader)
+        || align_to_cache_line(sizeof(RingHeader)) + ring_header_ptr->slot_count * ring_header_ptr->slot_size > ring_size) {
+        std::cerr << LOG_ROS_MQTT_SHARED_MEMORY << " " << shm_name << " has unknown layout" << '\n';
+        munmap(mapped_ptr, ring_size);
+        return;
+    }
+
+    mapped_size_ = ring_size;
+    mapped_ptr_ = static_cast<const char *>(mapped_ptr);
+    ring_header_ptr_ = ring_header_ptr;
+}
+
+/**
+ * @brief Virtual Destructor for this class & unmap ring
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_shm::SharedMemoryReader::~SharedMemoryReader() {
+    if(mapped_ptr_ != nullptr) {
+        munmap(const_cast<char *>(mapped_ptr_), mapped_size_);
+    }
+}
+
+/**
+ * @brief Function for check ring was mapped & has known layout
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool
+*/
+bool ros_mqtt_shm::SharedMemoryReader::is_open() const {
+    return ring_header_ptr_ != nullptr;
+}
+
+/**
+ * @brief Function for get slot header which holds sequence
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param sequence uint64_t from 1
+ * @return const SlotHeader *
+*/
+const ros_mqtt_shm::SlotHeader * ros_mqtt_shm::SharedMemoryReader::slot_header(uint64_t sequence) const {
+    return reinterpret_cast<const SlotHeader *>(mapped_ptr_ + align_to_cache_line(sizeof(RingHeader)) + ((sequence - 1) % ring_header_ptr_->slot_count) * ring_header_ptr_->slot_size);
+}
+
+/**
+ * @brief Function for get sequence of last written payload, 0 when none
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_shm::SharedMemoryReader::latest_sequence() const {
+    return ring_header_ptr_ == nullptr ? 0 : ring_header_ptr_->write_sequence.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Function for point shared_payload at payload of sequence in place
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param sequence uint64_t from 1
+ * @param shared_payload SharedPayload&
+ * @return ReadStatus READ when shared_payload points at it, check is_intact after using it
+*/
+ros_mqtt_shm::ReadStatus ros_mqtt_shm::SharedMemoryReader::read(uint64_t sequence, SharedPayload& shared_payload) const {
+    if(ring_header_ptr_ == nullptr || sequence == 0) {
+        return ReadStatus::NOT_YET_WRITTEN;
+    }
+
+    const SlotHeader * slot_header_ptr = this->slot_header(sequence);
+    if(slot_header_ptr->sequence.load(std::memory_order_acquire) != sequence) {
+        return this->latest_sequence() >= sequence ? ReadStatus::OVERWRITTEN : ReadStatus::NOT_YET_WRITTEN;
+    }
+
+    const std::size_t payload_capacity = ring_header_ptr_->slot_size - sizeof(SlotHeader);
+    shared_payload.sequence = sequence;
+    shared_payload.publish_ns = slot_header_ptr->publish_ns;
+    shared_payload.encoding = slot_header_ptr->encoding;
+    shared_payload.data = reinterpret_cast<const char *>(slot_header_ptr) + sizeof(SlotHeader);
+    shared_payload.size = slot_header_ptr->payload_size < payload_capacity ? slot_header_ptr->payload_size : payload_capacity;
+    return ReadStatus::READ;
+}
+
+/**
+ * @brief Function for check payload was not overwritten while it was used
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param shared_payload const SharedPayload&
+ * @return bool
+*/
+bool ros_mqtt_shm::SharedMemoryReader::is_intact(const SharedPayload& shared_payload) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return this->slot_header(shared_payload.sequence)->sequence.load(std::memory_order_relaxed) == shared_payload.sequence;
+}
+
+/**
+ * @brief Function for build posix shared memory name of mqtt topic, '/' of topic become '.'
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param shm_prefix const std::string& starting with '/'
+ * @param mqtt_topic const std::string&
+ * @return std::string e.g. /ros_mqtt_bridge.map_server.map.response
+*/
+std::string ros_mqtt_shm::shm_name_of(const std::string& shm_prefix, const std::string& mqtt_topic) {
+    std::string shm_name = shm_prefix;
+    for(const char topic_character : mqtt_topic) {
+        shm_name += topic_character == '/' ? '.' : topic_character;
+    }
+    if(!mqtt_topic.empty() && mqtt_topic[0] != '/') {
+        shm_name.insert(shm_prefix.size(), 1, '.');
+    }
+    return shm_name;
+}
+
+/**
+ * @brief Function for round size up to multiple of 64 bytes
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param size std::size_t
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_shm::align_to_cache_line(std::size_t size) {
+    return (size + 63) & ~static_cast<std::size_t>(63);
+}
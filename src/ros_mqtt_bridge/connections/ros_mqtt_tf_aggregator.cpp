@@ -0,0 +1,109 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_tf_aggregator.hpp"
+
+/**
+ * @brief Constructor for initialize this class instance
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param frame_pairs const std::vector<FramePair>&
+ * @param cache_time tf2::Duration how long dynamic transforms are kept in tf buffer
+*/
+ros_mqtt_tf::FramePairAggregator::FramePairAggregator(const std::vector<FramePair>& frame_pairs, tf2::Duration cache_time)
+: tf_buffer_core_(cache_time),
+frame_pairs_(frame_pairs),
+looked_up_stamps_(frame_pairs.size(), -1),
+rejected_count_(0) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_tf::FramePairAggregator::~FramePairAggregator() {
+
+}
+
+/**
+ * @brief Function for add every transform of tf message into tf buffer
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param tf_msgs const tf2_msgs::msg::TFMessage&
+ * @param is_static bool true for /tf_static, which stays valid for all time
+ * @return void
+ * @details transforms tf2 rejects(empty or equal frame ids, non-finite values) are counted & the rest of the message is still added
+*/
+void ros_mqtt_tf::FramePairAggregator::add_transforms(const tf2_msgs::msg::TFMessage& tf_msgs, bool is_static) {
+    for(const geometry_msgs::msg::TransformStamped& transform_stamped : tf_msgs.transforms) {
+        if(!tf_buffer_core_.setTransform(transform_stamped, TF_AGGREGATOR_AUTHORITY, is_static)) {
+            rejected_count_++;
+        }
+    }
+}
+
+/**
+ * @brief Function for look up latest composed transform of every frame pair which tf tree connects
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param composed_tf_msgs tf2_msgs::msg::TFMessage& refilled with composed transforms in order of frame pairs, keeps its capacity
+ * @return std::size_t count of frame pairs whose composed stamp moved since last lookup, 0 means nothing new to publish
+*/
+std::size_t ros_mqtt_tf::FramePairAggregator::lookup_transforms(tf2_msgs::msg::TFMessage& composed_tf_msgs) {
+    composed_tf_msgs.transforms.resize(frame_pairs_.size());
+    std::size_t composed_count = 0;
+    std::size_t updated_count = 0;
+
+    for(std::size_t i = 0; i < frame_pairs_.size(); i++) {
+        const FramePair& frame_pair = frame_pairs_[i];
+        try {
+            composed_tf_msgs.transforms[composed_count] = tf_buffer_core_.lookupTransform(frame_pair.target_frame, frame_pair.source_frame, tf2::TimePointZero);
+        } catch(const tf2::TransformException& tf_expn) {
+            continue;
+        }
+
+        const std_msgs::msg::Header& composed_header = composed_tf_msgs.transforms[composed_count].header;
+        const int64_t composed_stamp = static_cast<int64_t>(composed_header.stamp.sec) * 1000000000LL + composed_header.stamp.nanosec;
+        if(composed_stamp != looked_up_stamps_[i]) {
+            looked_up_stamps_[i] = composed_stamp;
+            updated_count++;
+        }
+        composed_count++;
+    }
+
+    composed_tf_msgs.transforms.resize(composed_count);
+    return updated_count;
+}
+
+/**
+ * @brief Function for get count of configured frame pairs
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_tf::FramePairAggregator::frame_pair_count() const {
+    return frame_pairs_.size();
+}
+
+/**
+ * @brief Function for get count of transforms tf buffer rejected
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_tf::FramePairAggregator::rejected_count() const {
+    return rejected_count_;
+}
@@ -0,0 +1,562 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ros_mqtt_bridge/connections/ros_mqtt_transport.hpp"
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_transport::TransportCallback::~TransportCallback() {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_transport::Transport::~Transport() {
+
+}
+
+/**
+ * @brief Constructor for initialize this class instance with paho async client of broker address
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_address const std::string&
+ * @param mqtt_client_id const std::string&
+ * @see mqtt::async_client
+*/
+ros_mqtt_transport::PahoTransport::PahoTransport(const std::string& mqtt_address, const std::string& mqtt_client_id)
+: mqtt_async_client_(mqtt_address, mqtt_client_id),
+transport_callback_ptr_(nullptr) {
+
+}
+
+/**
+ * @brief Virtual Destructor for this class & disconnect from broker
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_transport::PahoTransport::~PahoTransport() {
+    this->disconnect();
+}
+
+/**
+ * @brief Function for set callback which receives events of paho client
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param transport_callback TransportCallback&
+ * @return void
+ * @see mqtt::callback
+*/
+void ros_mqtt_transport::PahoTransport::set_callback(TransportCallback& transport_callback) {
+    transport_callback_ptr_ = &transport_callback;
+    mqtt_async_client_.set_callback(*this);
+}
+
+/**
+ * @brief Function for connect to broker with clean session
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param connect_timeout std::chrono::seconds
+ * @param cancel_function std::function<bool()> polled every MQTT_TRANSPORT_CONNECT_POLL_MS while waiting, may be empty
+ * @return bool connected, false when cancelled
+ * @see mqtt::connect_options
+*/
+bool ros_mqtt_transport::PahoTransport::connect(std::chrono::seconds connect_timeout, std::function<bool()> cancel_function) {
+    try {
+        mqtt::connect_options mqtt_connect_opts;
+        mqtt_connect_opts.set_clean_session(true);
+        const mqtt::token_ptr mqtt_connect_token = mqtt_async_client_.connect(mqtt_connect_opts);
+        const std::chrono::steady_clock::time_point connect_deadline = std::chrono::steady_clock::now() + connect_timeout;
+        while(!mqtt_connect_token->wait_for(std::chrono::milliseconds(MQTT_TRANSPORT_CONNECT_POLL_MS))) {
+            if(cancel_function && cancel_function()) {
+                return false;
+            }
+            if(std::chrono::steady_clock::now() >= connect_deadline) {
+                break;
+            }
+        }
+        return mqtt_async_client_.is_connected();
+    } catch(const mqtt::exception& mqtt_expn) {
+        std::cerr << LOG_ROS_MQTT_TRANSPORT << " connection error : " << mqtt_expn.what() << '\n';
+        return false;
+    }
+}
+
+/**
+ * @brief Function for check paho client is connected
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool
+*/
+bool ros_mqtt_transport::PahoTransport::is_connected() const {
+    return mqtt_async_client_.is_connected();
+}
+
+/**
+ * @brief Function for disconnect from broker when connected
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_transport::PahoTransport::disconnect() {
+    try {
+        if(mqtt_async_client_.is_connected()) {
+            mqtt_async_client_.disconnect()->wait();
+        }
+    } catch(const mqtt::exception& mqtt_expn) {
+        std::cerr << LOG_ROS_MQTT_TRANSPORT << " disconnect error : " << mqtt_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Function for subscribe mqtt topic from broker
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @param mqtt_qos int
+ * @return int MQTT_TRANSPORT_SUCCESS or error code
+ * @see mqtt::exception
+*/
+int ros_mqtt_transport::PahoTransport::subscribe(const std::string& mqtt_topic, int mqtt_qos) {
+    try {
+        mqtt_async_client_.subscribe(mqtt_topic, mqtt_qos);
+        return MQTT_TRANSPORT_SUCCESS;
+    } catch(const mqtt::exception& mqtt_expn) {
+        std::cerr << LOG_ROS_MQTT_TRANSPORT << " subscribe error : " << mqtt_expn.what() << '\n';
+        return MQTT_TRANSPORT_EXCEPTION;
+    }
+}
+
+/**
+ * @brief Function for publish mqtt message & wait for its delivery token
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @param mqtt_payload const std::string&
+ * @param mqtt_qos int
+ * @param is_retained bool broker keeps the message & hands it to clients which subscribe later
+ * @return PublishResult return code of delivery token, accepted when paho returned the token, acked when it completed
+ * @see mqtt::delivery_token
+*/
+ros_mqtt_transport::PublishResult ros_mqtt_transport::PahoTransport::publish(const std::string& mqtt_topic, const std::string& mqtt_payload, int mqtt_qos, bool is_retained) {
+    PublishResult publish_result;
+    try {
+        mqtt::message_ptr mqtt_publish_msg = mqtt::make_message(mqtt_topic, mqtt_payload);
+        mqtt_publish_msg->set_qos(mqtt_qos);
+        mqtt_publish_msg->set_retained(is_retained);
+        mqtt::delivery_token_ptr delivery_token = mqtt_async_client_.publish(mqtt_publish_msg);
+        publish_result.accepted = std::chrono::steady_clock::now();
+        delivery_token->wait();
+        publish_result.acked = std::chrono::steady_clock::now();
+        publish_result.return_code = delivery_token->get_return_code();
+    } catch(const mqtt::exception& mqtt_expn) {
+        std::cerr << LOG_ROS_MQTT_TRANSPORT << " publish error : " << mqtt_expn.what() << '\n';
+        publish_result.accepted = publish_result.acked = std::chrono::steady_clock::now();
+        publish_result.return_code = MQTT_TRANSPORT_EXCEPTION;
+    }
+    return publish_result;
+}
+
+/**
+ * @brief Function for get count of messages which paho has not completed delivery of yet
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t count of pending delivery tokens, each publishing thread waits for its own token, so this counts messages in flight across threads
+*/
+std::size_t ros_mqtt_transport::PahoTransport::pending_count() {
+    try {
+        return mqtt_async_client_.get_pending_delivery_tokens().size();
+    } catch(const mqtt::exception& mqtt_expn) {
+        std::cerr << LOG_ROS_MQTT_TRANSPORT << " pending delivery tokens error : " << mqtt_expn.what() << '\n';
+        return 0;
+    }
+}
+
+/**
+ * @brief Overrided function for forward cause of lost connection
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_connection_lost_cause const std::string&
+ * @return void
+ * @see mqtt::callback
+*/
+void ros_mqtt_transport::PahoTransport::connection_lost(const std::string& mqtt_connection_lost_cause) {
+    if(transport_callback_ptr_ != nullptr) {
+        transport_callback_ptr_->connection_lost(mqtt_connection_lost_cause);
+    }
+}
+
+/**
+ * @brief Overrided function for forward topic & payload of arrived message without copying them
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_message mqtt::const_message_ptr
+ * @return void
+ * @see mqtt::callback
+*/
+void ros_mqtt_transport::PahoTransport::message_arrived(mqtt::const_message_ptr mqtt_message) {
+    if(transport_callback_ptr_ != nullptr && mqtt_message != nullptr) {
+        transport_callback_ptr_->message_arrived(mqtt_message->get_topic(), mqtt_message->get_payload_str());
+    }
+}
+
+/**
+ * @brief Overrided function for forward message id of delivered token
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_delivered_token mqtt::delivery_token_ptr
+ * @return void
+ * @see mqtt::callback
+*/
+void ros_mqtt_transport::PahoTransport::delivery_complete(mqtt::delivery_token_ptr mqtt_delivered_token) {
+    if(transport_callback_ptr_ != nullptr) {
+        transport_callback_ptr_->delivery_complete(mqtt_delivered_token ? mqtt_delivered_token->get_message_id() : -1);
+    }
+}
+
+/**
+ * @brief Constructor for initialize ring of capacity rounded up to power of two
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param capacity std::size_t
+*/
+ros_mqtt_transport::LoopbackTransport::LoopbackTransport(std::size_t capacity)
+: capacity_mask_(round_up_power_of_two(capacity) - 1),
+loopback_slots_(new LoopbackSlot[capacity_mask_ + 1]),
+enqueue_position_(0),
+dequeue_position_(0),
+published_count_(0),
+delivered_count_(0),
+subscriptions_ptr_(new std::set<std::string>()),
+transport_callback_ptr_(nullptr),
+is_running_(false) {
+    for(std::size_t index = 0; index <= capacity_mask_; index++) {
+        loopback_slots_[index].sequence.store(index, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Virtual Destructor for this class & stop delivery thread, delete ring & subscription snapshots
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_transport::LoopbackTransport::~LoopbackTransport() {
+    this->disconnect();
+    delete[] loopback_slots_;
+    delete subscriptions_ptr_.load();
+    for(const std::set<std::string> * retired_subscriptions_ptr : retired_subscriptions_ptrs_) {
+        delete retired_subscriptions_ptr;
+    }
+}
+
+/**
+ * @brief Function for set callback which receives delivered messages
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param transport_callback TransportCallback&
+ * @return void
+*/
+void ros_mqtt_transport::LoopbackTransport::set_callback(TransportCallback& transport_callback) {
+    transport_callback_ptr_.store(&transport_callback, std::memory_order_release);
+}
+
+/**
+ * @brief Function for start delivery thread, there is nothing to wait for
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param connect_timeout std::chrono::seconds unused
+ * @param cancel_function std::function<bool()> unused
+ * @return bool always true
+*/
+bool ros_mqtt_transport::LoopbackTransport::connect(std::chrono::seconds connect_timeout, std::function<bool()> cancel_function) {
+    static_cast<void>(connect_timeout);
+    static_cast<void>(cancel_function);
+    if(!is_running_.exchange(true)) {
+        delivery_thread_ = std::thread(&LoopbackTransport::run, this);
+    }
+    return true;
+}
+
+/**
+ * @brief Function for check delivery thread is running
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return bool
+*/
+bool ros_mqtt_transport::LoopbackTransport::is_connected() const {
+    return is_running_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for stop & join delivery thread, messages left in the ring are not delivered
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_transport::LoopbackTransport::disconnect() {
+    if(is_running_.exchange(false) && delivery_thread_.joinable()) {
+        delivery_thread_.join();
+    }
+}
+
+/**
+ * @brief Function for add topic filter into a new subscription snapshot, + & # wildcards are supported
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @param mqtt_qos int unused, delivery is always exactly once
+ * @return int MQTT_TRANSPORT_SUCCESS
+ * @details the delivery thread may still read the previous snapshot, so it is retired until destruction.
+ * retained messages matching the filter are enqueued again once the new snapshot is visible
+*/
+int ros_mqtt_transport::LoopbackTransport::subscribe(const std::string& mqtt_topic, int mqtt_qos) {
+    std::vector<std::pair<std::string, std::string>> retained_matches;
+    {
+        std::lock_guard<std::mutex> subscription_lock(subscription_mutex_);
+        const std::set<std::string> * current_subscriptions_ptr = subscriptions_ptr_.load(std::memory_order_acquire);
+        std::set<std::string> * next_subscriptions_ptr = new std::set<std::string>(*current_subscriptions_ptr);
+        next_subscriptions_ptr->insert(mqtt_topic);
+        subscriptions_ptr_.store(next_subscriptions_ptr, std::memory_order_release);
+        retired_subscriptions_ptrs_.push_back(current_subscriptions_ptr);
+
+        for(const std::pair<const std::string, std::string>& retained_message : retained_messages_) {
+            if(topic_matches(mqtt_topic, retained_message.first)) {
+                retained_matches.push_back(retained_message);
+            }
+        }
+    }
+
+    for(const std::pair<std::string, std::string>& retained_match : retained_matches) {
+        this->publish(retained_match.first, retained_match.second, mqtt_qos, false);
+    }
+    return MQTT_TRANSPORT_SUCCESS;
+}
+
+/**
+ * @brief Function for enqueue message into the ring, delivered to callback when a subscription matches its topic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @param mqtt_payload const std::string&
+ * @param mqtt_qos int unused
+ * @param is_retained bool message is kept for later subscriptions, empty payload removes kept message
+ * @return PublishResult accepted & acked when the message is in the ring
+ * @details spins while the ring is full. a callback publishing from the delivery thread would wait for itself,
+ * so it gets MQTT_TRANSPORT_QUEUE_FULL instead
+*/
+ros_mqtt_transport::PublishResult ros_mqtt_transport::LoopbackTransport::publish(const std::string& mqtt_topic, const std::string& mqtt_payload, int mqtt_qos, bool is_retained) {
+    static_cast<void>(mqtt_qos);
+    PublishResult publish_result;
+    if(!is_running_.load(std::memory_order_relaxed)) {
+        publish_result.accepted = publish_result.acked = std::chrono::steady_clock::now();
+        publish_result.return_code = MQTT_TRANSPORT_NOT_CONNECTED;
+        return publish_result;
+    }
+
+    if(is_retained) {
+        std::lock_guard<std::mutex> subscription_lock(subscription_mutex_);
+        if(mqtt_payload.empty()) {
+            retained_messages_.erase(mqtt_topic);
+        } else {
+            retained_messages_[mqtt_topic].assign(mqtt_payload);
+        }
+    }
+
+    std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    LoopbackSlot * loopback_slot = nullptr;
+    while(true) {
+        loopback_slot = &loopback_slots_[position & capacity_mask_];
+        const std::size_t sequence = loopback_slot->sequence.load(std::memory_order_acquire);
+        const std::intptr_t sequence_difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if(sequence_difference == 0) {
+            if(enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if(sequence_difference < 0) {
+            if(std::this_thread::get_id() == delivery_thread_.get_id()) {
+                publish_result.accepted = publish_result.acked = std::chrono::steady_clock::now();
+                publish_result.return_code = MQTT_TRANSPORT_QUEUE_FULL;
+                return publish_result;
+            }
+            std::this_thread::yield();
+            position = enqueue_position_.load(std::memory_order_relaxed);
+        } else {
+            position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+
+    loopback_slot->mqtt_topic.assign(mqtt_topic);
+    loopback_slot->mqtt_payload.assign(mqtt_payload);
+    loopback_slot->sequence.store(position + 1, std::memory_order_release);
+    published_count_.fetch_add(1, std::memory_order_relaxed);
+
+    publish_result.accepted = publish_result.acked = std::chrono::steady_clock::now();
+    publish_result.return_code = MQTT_TRANSPORT_SUCCESS;
+    return publish_result;
+}
+
+/**
+ * @brief Function for check topic matches any subscription of current snapshot
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @return bool
+*/
+bool ros_mqtt_transport::LoopbackTransport::is_subscribed(const std::string& mqtt_topic) const {
+    const std::set<std::string> * subscriptions_ptr = subscriptions_ptr_.load(std::memory_order_acquire);
+    if(subscriptions_ptr->count(mqtt_topic) > 0) {
+        return true;
+    }
+    for(const std::string& topic_filter : *subscriptions_ptr) {
+        if(topic_matches(topic_filter, mqtt_topic)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Function for deliver messages of the ring in order on the delivery thread
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details callback reads topic & payload in place, the slot is released after it returned.
+ * an empty ring is polled by spinning, then yielding, then sleeping 50us
+*/
+void ros_mqtt_transport::LoopbackTransport::run() {
+    uint32_t idle_polls = 0;
+    while(is_running_.load(std::memory_order_relaxed)) {
+        LoopbackSlot& loopback_slot = loopback_slots_[dequeue_position_ & capacity_mask_];
+        if(loopback_slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+            idle_polls++;
+            if(idle_polls > 1024) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            } else if(idle_polls > 64) {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        idle_polls = 0;
+
+        TransportCallback * transport_callback_ptr = transport_callback_ptr_.load(std::memory_order_acquire);
+        if(transport_callback_ptr != nullptr) {
+            if(this->is_subscribed(loopback_slot.mqtt_topic)) {
+                transport_callback_ptr->message_arrived(loopback_slot.mqtt_topic, loopback_slot.mqtt_payload);
+                delivered_count_.fetch_add(1, std::memory_order_relaxed);
+            }
+            transport_callback_ptr->delivery_complete(static_cast<int>(dequeue_position_));
+        }
+
+        loopback_slot.sequence.store(dequeue_position_ + capacity_mask_ + 1, std::memory_order_release);
+        dequeue_position_++;
+    }
+}
+
+/**
+ * @brief Function for get count of messages which are not completed yet
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return std::size_t always 0, loopback completes delivery once the message is in the ring
+*/
+std::size_t ros_mqtt_transport::LoopbackTransport::pending_count() {
+    return 0;
+}
+
+/**
+ * @brief Function for get count of messages accepted into the ring
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_transport::LoopbackTransport::published_count() const {
+    return published_count_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for get count of messages delivered to callback
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return uint64_t
+*/
+uint64_t ros_mqtt_transport::LoopbackTransport::delivered_count() const {
+    return delivered_count_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for round value up to power of two, at least 2
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param value std::size_t
+ * @return std::size_t
+*/
+std::size_t ros_mqtt_transport::round_up_power_of_two(std::size_t value) {
+    std::size_t power_of_two = 2;
+    while(power_of_two < value) {
+        power_of_two <<= 1;
+    }
+    return power_of_two;
+}
+
+/**
+ * @brief Function for match mqtt topic against topic filter with + (one level) & # (remaining levels) wildcards
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param topic_filter const std::string&
+ * @param mqtt_topic const std::string&
+ * @return bool
+*/
+bool ros_mqtt_transport::topic_matches(const std::string& topic_filter, const std::string& mqtt_topic) {
+    std::size_t filter_index = 0;
+    std::size_t topic_index = 0;
+    while(filter_index < topic_filter.size()) {
+        if(topic_filter[filter_index] == '#') {
+            return true;
+        }
+        if(topic_filter[filter_index] == '+') {
+            while(topic_index < mqtt_topic.size() && mqtt_topic[topic_index] != '/') {
+                topic_index++;
+            }
+            filter_index++;
+            continue;
+        }
+        if(topic_index >= mqtt_topic.size() || topic_filter[filter_index] != mqtt_topic[topic_index]) {
+            return topic_index == mqtt_topic.size() && topic_filter.compare(filter_index, std::string::npos, "/#") == 0;
+        }
+        filter_index++;
+        topic_index++;
+    }
+    return topic_index == mqtt_topic.size();
+}
+
+/**
+ * @brief Function for create transport instance of kind
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param transport_kind TransportKind
+ * @param mqtt_address const std::string& unused by LOOPBACK
+ * @param mqtt_client_id const std::string& unused by LOOPBACK
+ * @return Transport * owned by caller
+*/
+ros_mqtt_transport::Transport * ros_mqtt_transport::create_transport(TransportKind transport_kind, const std::string& mqtt_address, const std::string& mqtt_client_id) {
+    switch(transport_kind) {
+        case TransportKind::LOOPBACK : return new LoopbackTransport();
+        case TransportKind::PAHO :
+        default : return new PahoTransport(mqtt_address, mqtt_client_id);
+    }
+}
@@ -15,72 +15,298 @@
 #include "ros_mqtt_bridge/ros_mqtt_bridge.hpp"
 
 /**
- * @brief Constructor for initialize this class instance & message coverters
+ * @brief Constructor for initialize this class instance with transport of MQTT_TRANSPORT
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
  * @param ros_node_ptr std::shared_ptr<rclcpp::Node>
- * @param ros_mqtt_connections_publihser_ptr_ ros_mqtt_connections::to_ros::Bridge
- * @see rclcpp
- * @see ros_mqtt_connections::to_ros::Bridge
- * @see mqtt::callback
+ * @see ros_mqtt_transport::create_transport
 */
 ros_mqtt_connections::manager::Bridge::Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr)
+: Bridge(ros_node_ptr, ros_mqtt_transport::create_transport(MQTT_TRANSPORT, MQTT_ADDRESS, MQTT_CLIENT_ID)) {
+
+}
+
+/**
+ * @brief Constructor for initialize this class instance, connect transport & create ros/mqtt bridges
+ * @author reidlo(naru5135@wavem.net)
+ * @date 23.05.11
+ * @param ros_node_ptr std::shared_ptr<rclcpp::Node>
+ * @param mqtt_transport_ptr ros_mqtt_transport::Transport * owned by this instance
+ * @see rclcpp
+ * @see ros_mqtt_transport::Transport
+ * @details converters are created once before transport connects, sensor/nav/tf2 converters share the std & geometry converters of this instance.
+ * transport connects & subscribes in background once ros publishers & subscriptions exist, so construction does not wait for the broker
+*/
+ros_mqtt_connections::manager::Bridge::Bridge(std::shared_ptr<rclcpp::Node> ros_node_ptr, ros_mqtt_transport::Transport * mqtt_transport_ptr)
 : log_ros_mqtt_bridge_(LOG_ROS_MQTT_BRIDGE),
 log_ros_mqtt_connections_to_mqtt_(LOG_ROS_MQTT_CONNECTION_TO_MQTT),
 log_ros_mqtt_connections_to_ros_(LOG_ROS_MQTT_CONNECTION_TO_ROS),
 ros_node_ptr_(ros_node_ptr),
 ros_default_qos_(ROS_DEFAULT_QOS),
-mqtt_async_client_(MQTT_ADDRESS, MQTT_CLIENT_ID),
+mqtt_transport_ptr_(mqtt_transport_ptr),
+mqtt_connector_ptr_(nullptr),
+mqtt_offline_buffer_ptr_(nullptr),
+std_msgs_converter_ptr_(new ros_message_converter::ros_std_msgs::StdMessageConverter()),
+geometry_msgs_converter_ptr_(new ros_message_converter::ros_geometry_msgs::GeometryMessageConverter(*std_msgs_converter_ptr_)),
+sensor_msgs_converter_ptr_(new ros_message_converter::ros_sensor_msgs::SensorMessageConverter(*std_msgs_converter_ptr_)),
+nav_msgs_converter_ptr_(new ros_message_converter::ros_nav_msgs::NavMessageConverter(*std_msgs_converter_ptr_, *geometry_msgs_converter_ptr_)),
+tf2_msgs_converter_ptr_(new ros_message_converter::ros_tf2_msgs::Tf2MessageConverter(*std_msgs_converter_ptr_, *geometry_msgs_converter_ptr_)),
+mqtt_batcher_ptr_(nullptr),
+mqtt_compression_worker_ptr_(nullptr),
+mqtt_metrics_registry_ptr_(nullptr),
+mqtt_metrics_exporter_ptr_(nullptr),
+mqtt_last_value_cache_ptr_(nullptr),
+tf_aggregator_ptr_(nullptr),
+mqtt_cmd_vel_hold_ptr_(nullptr),
+mqtt_egress_governor_ptr_(nullptr),
 mqtt_qos_(MQTT_QOS),
-mqtt_is_success_(mqtt::SUCCESS) {
+mqtt_is_success_(MQTT_TRANSPORT_SUCCESS),
+mqtt_batch_enabled_(MQTT_BATCH_ENABLED),
+is_shut_down_(false),
+drain_deadline_ns_(INT64_MAX) {
+    this->initialize_logger();
     this->mqtt_connect();
-    this->grant_mqtt_subscriptions();
+    this->initialize_mqtt_batch();
+    this->initialize_mqtt_compression();
+    this->initialize_mqtt_encodings();
+    this->initialize_tracing();
+    this->initialize_shm_sinks();
+    this->initialize_last_value_cache();
+    this->initialize_tf_aggregation();
+    this->initialize_path_deltas();
+    this->initialize_deadbands();
+    this->initialize_deadlines();
+    this->initialize_cmd_vel_hold();
+    this->initialize_backpressure();
+    this->initialize_metrics();
     this->bridge_ros_to_mqtt();
     this->bridge_mqtt_to_ros();
-
-    std_msgs_converter_ptr_ = new ros_message_converter::ros_std_msgs::StdMessageConverter();
-    geometry_msgs_converter_ptr_ = new ros_message_converter::ros_geometry_msgs::GeometryMessageConverter();
-    sensor_msgs_converter_ptr_ = new ros_message_converter::ros_sensor_msgs::SensorMessageConverter();
-    nav_msgs_converter_ptr_ = new ros_message_converter::ros_nav_msgs::NavMessageConverter();
-    tf2_msgs_converter_ptr_ = new ros_message_converter::ros_tf2_msgs::Tf2MessageConverter();
+    mqtt_connector_ptr_->start();
 }
 
 /**
  * @brief Virtual Destructor for this class & delete message coverters' pointers' instances
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
+ * @details shuts down with MQTT_SHUTDOWN_DRAIN_MS unless shutdown() was called already
 */
 ros_mqtt_connections::manager::Bridge::~Bridge() {
-    delete std_msgs_converter_ptr_;
-    delete geometry_msgs_converter_ptr_;
-    delete sensor_msgs_converter_ptr_;
-    delete nav_msgs_converter_ptr_;
+    this->shutdown(std::chrono::milliseconds(MQTT_SHUTDOWN_DRAIN_MS));
+    delete mqtt_connector_ptr_;
+    delete mqtt_compression_worker_ptr_;
     delete tf2_msgs_converter_ptr_;
+    delete nav_msgs_converter_ptr_;
+    delete sensor_msgs_converter_ptr_;
+    delete geometry_msgs_converter_ptr_;
+    delete std_msgs_converter_ptr_;
+    for(std::pair<const ros_message_encoder::Encoding, ros_message_encoder::MessageEncoder *>& mqtt_encoder : mqtt_encoder_ptrs_) {
+        delete mqtt_encoder.second;
+    }
+    for(std::pair<const ros_message_encoder::Encoding, ros_message_encoder::MessageDecoder *>& mqtt_decoder : mqtt_decoder_ptrs_) {
+        delete mqtt_decoder.second;
+    }
+    delete mqtt_batcher_ptr_;
+    delete mqtt_metrics_exporter_ptr_;
+    delete mqtt_metrics_registry_ptr_;
+    delete mqtt_last_value_cache_ptr_;
+    delete tf_aggregator_ptr_;
+    for(std::pair<const std::string, ros_mqtt_path::PathDelta *>& mqtt_path_delta : mqtt_path_delta_ptrs_) {
+        delete mqtt_path_delta.second;
+    }
+    for(std::pair<const std::string, ros_mqtt_deadband::DeadbandFilter *>& mqtt_deadband : mqtt_deadband_ptrs_) {
+        delete mqtt_deadband.second;
+    }
+    delete mqtt_cmd_vel_hold_ptr_;
+    delete mqtt_egress_governor_ptr_;
+    for(std::pair<const std::string, ros_mqtt_shm::SharedMemoryRing *>& shm_sink : shm_sink_ptrs_) {
+        delete shm_sink.second;
+    }
+    delete mqtt_offline_buffer_ptr_;
+    delete mqtt_transport_ptr_;
+}
+
+/**
+ * @brief Function for stop ros intake, drain egress within drain_timeout & disconnect transport, only the first call does anything
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param drain_timeout std::chrono::milliseconds shared by flushing queues & waiting for delivery tokens
+ * @return void
+ * @details order is subscriptions & timers, batch, compression queue, connector, offline buffer, delivery tokens & disconnect.
+ * messages left at deadline are dropped & counted in drops of their topic, except undelivered tokens which paho owns.
+ * stopping connector cancels a connect attempt in progress & ends a flush of offline buffer between messages
+*/
+void ros_mqtt_connections::manager::Bridge::shutdown(std::chrono::milliseconds drain_timeout) {
+    if(is_shut_down_) {
+        return;
+    }
+    is_shut_down_ = true;
+    const std::chrono::steady_clock::time_point drain_started = std::chrono::steady_clock::now();
+    const std::chrono::steady_clock::time_point drain_deadline = drain_started + drain_timeout;
+    drain_deadline_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(drain_deadline.time_since_epoch()).count(), std::memory_order_release);
+
+    const rclcpp::TimerBase::SharedPtr ros_timer_ptrs[] = {mqtt_batch_timer_ptr_, tf_aggregation_timer_ptr_, cmd_vel_hold_timer_ptr_, backpressure_timer_ptr_};
+    for(const rclcpp::TimerBase::SharedPtr& ros_timer_ptr : ros_timer_ptrs) {
+        if(ros_timer_ptr != nullptr) {
+            ros_timer_ptr->cancel();
+        }
+    }
+    ros_chatter_subscription_ptr_.reset();
+    ros_robot_pose_subscription_ptr_.reset();
+    ros_scan_subscription_ptr_.reset();
+    ros_tf_subscription_ptr_.reset();
+    ros_tf_static_subscription_ptr_.reset();
+    ros_odom_subscription_ptr_.reset();
+    ros_global_plan_subscription_ptr_.reset();
+    ros_local_plan_subscription_ptr_.reset();
+    ros_cmd_vel_subscription_ptr_.reset();
+    ros_add_two_ints_subscription_ptr_.reset();
+    ros_map_server_map_subscription_ptr_.reset();
+    ros_echo_subscription_ptr_.reset();
+
+    if(mqtt_batch_enabled_) {
+        this->flush_mqtt_batch();
+    }
+    std::size_t compression_dropped = 0;
+    if(mqtt_compression_worker_ptr_ != nullptr) {
+        compression_dropped = mqtt_compression_worker_ptr_->drain(drain_deadline);
+    }
+
+    mqtt_connector_ptr_->stop();
+    const std::deque<ros_mqtt_connector::OfflineMessage> offline_messages = mqtt_offline_buffer_ptr_->close();
+    for(const ros_mqtt_connector::OfflineMessage& offline_message : offline_messages) {
+        this->record_dropped(offline_message.mqtt_topic.c_str());
+    }
+
+    while(mqtt_transport_ptr_->pending_count() > 0 && std::chrono::steady_clock::now() < drain_deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(MQTT_SHUTDOWN_POLL_MS));
+    }
+    const std::size_t undelivered_count = mqtt_transport_ptr_->pending_count();
+    mqtt_transport_ptr_->disconnect();
+
+    uint64_t total_dropped = 0;
+    uint64_t total_stale_dropped = 0;
+    if(mqtt_metrics_registry_ptr_ != nullptr) {
+        for(const std::pair<const std::string, ros_mqtt_metrics::TopicMetrics *>& registered_metrics : mqtt_metrics_registry_ptr_->topics()) {
+            total_dropped += registered_metrics.second->drops.load(std::memory_order_relaxed);
+            total_stale_dropped += registered_metrics.second->stale_drops.load(std::memory_order_relaxed);
+        }
+    }
+    const long long drain_elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - drain_started).count();
+    ROS_MQTT_LOG_INFO(
+        "%s shut down in %lld ms, dropped at shutdown : %zu compression queue, %zu offline buffer, %zu undelivered. dropped since start : %llu, %llu stale",
+        LOG_ROS_MQTT_BRIDGE,
+        drain_elapsed_ms,
+        compression_dropped,
+        offline_messages.size(),
+        undelivered_count,
+        static_cast<unsigned long long>(total_dropped),
+        static_cast<unsigned long long>(total_stale_dropped)
+    );
 }
 
 /**
- * @brief Function for connect to mqtt by mqtt::async_client
+ * @brief Function for prepare connection of transport, offline buffer & status publisher, connector is started once bridges exist
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
  * @return void
- * @see mqtt::async_client
- * @see mqtt::connect_options
- * @see mqtt::exception
+ * @see ros_mqtt_transport::Transport
+ * @see ros_mqtt_connector::Connector
 */
 void ros_mqtt_connections::manager::Bridge::mqtt_connect() {
+    mqtt_transport_ptr_->set_callback(*this);
+    mqtt_offline_buffer_ptr_ = new ros_mqtt_connector::OfflineBuffer(
+        MQTT_OFFLINE_BUFFER_SIZE,
+        [this](const char * mqtt_topic) {
+            this->record_dropped(mqtt_topic);
+        }
+    );
+
+    const ros_mqtt_connector::ConnectorOptions connector_options{
+        std::chrono::seconds(MQTT_CONNECT_TIMEOUT_S),
+        std::chrono::milliseconds(MQTT_CONNECT_RETRY_MIN_MS),
+        std::chrono::milliseconds(MQTT_CONNECT_RETRY_MAX_MS)
+    };
+    mqtt_connector_ptr_ = new ros_mqtt_connector::Connector(
+        *mqtt_transport_ptr_,
+        connector_options,
+        [this]() {
+            this->mqtt_connected();
+        },
+        [this](ros_mqtt_connector::ConnectionState connection_state) {
+            this->report_connection_state(connection_state);
+        }
+    );
+
     try {
-        mqtt::connect_options mqtt_connect_opts;
-        mqtt_connect_opts.set_clean_session(true);
-        mqtt_async_client_.connect(mqtt_connect_opts)->wait_for(std::chrono::seconds(60));
-        if(mqtt_async_client_.is_connected()) {
-            std::cout << log_ros_mqtt_bridge_ << " MQTT connection success" << '\n';
-            mqtt_async_client_.set_callback(*this);
-        } else {
-            std::cout << log_ros_mqtt_bridge_ << " MQTT connection failed... trying to reconnect" << '\n';
-            mqtt_async_client_.connect(mqtt_connect_opts)->wait_for(std::chrono::seconds(30));
+        ros_status_publisher_ptr_ = ros_node_ptr_->create_publisher<std_msgs::msg::String>(
+            ros_topics::to_ros::status,
+            rclcpp::QoS(1).transient_local()
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[MQTT to ROS] /status bridge err : " << rcl_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Function for subscribe again & publish messages which were buffered while not connected, called on connector thread after each connect
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details buffered messages past their deadline are dropped. messages published meanwhile go out directly & may overtake buffered ones.
+ * next plans are keyframes, since receivers may have missed plans while not connected.
+ * once connector is stopped or drain deadline of shutdown passed, the rest is dropped, so shutdown does not wait for the whole buffer
+*/
+void ros_mqtt_connections::manager::Bridge::mqtt_connected() {
+    this->grant_mqtt_subscriptions();
+    this->request_path_keyframes();
+
+    std::deque<ros_mqtt_connector::OfflineMessage> offline_messages = mqtt_offline_buffer_ptr_->close();
+    if(!offline_messages.empty()) {
+        ROS_MQTT_LOG_INFO("%s publishing %zu messages buffered while not connected", LOG_ROS_MQTT_CONNECTION_TO_MQTT, offline_messages.size());
+    }
+    std::size_t offline_index = 0;
+    for(; offline_index < offline_messages.size(); offline_index++) {
+        if(!mqtt_connector_ptr_->is_running() || std::chrono::steady_clock::now().time_since_epoch() >= std::chrono::nanoseconds(drain_deadline_ns_.load(std::memory_order_acquire))) {
+            break;
+        }
+        ros_mqtt_connector::OfflineMessage& offline_message = offline_messages[offline_index];
+        if(this->is_stale(offline_message.mqtt_topic.c_str(), offline_message.latency_trace)) {
+            ros_mqtt_buffer_pool::BufferPool::instance().recycle(offline_message.mqtt_payload);
+            continue;
         }
-    } catch (const mqtt::exception& mqtt_expn) {
-        std::cerr << log_ros_mqtt_bridge_ << " connection error : " << mqtt_expn.what() << '\n';
+        this->mqtt_transmit(offline_message.mqtt_topic.c_str(), offline_message.mqtt_payload, offline_message.latency_trace);
+    }
+    if(offline_index < offline_messages.size()) {
+        ROS_MQTT_LOG_WARN("%s dropped %zu buffered messages, shutting down", LOG_ROS_MQTT_CONNECTION_TO_MQTT, offline_messages.size() - offline_index);
+    }
+    for(; offline_index < offline_messages.size(); offline_index++) {
+        this->record_dropped(offline_messages[offline_index].mqtt_topic.c_str());
+    }
+}
+
+/**
+ * @brief Function for log connection state & publish it on status topic, latched so nodes which start later read readiness too
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param connection_state ros_mqtt_connector::ConnectionState
+ * @return void
+*/
+void ros_mqtt_connections::manager::Bridge::report_connection_state(ros_mqtt_connector::ConnectionState connection_state) {
+    if(connection_state == ros_mqtt_connector::ConnectionState::DISCONNECTED) {
+        ROS_MQTT_LOG_WARN("%s MQTT %s, attempt %llu", LOG_ROS_MQTT_BRIDGE, ros_mqtt_connector::state_name(connection_state), static_cast<unsigned long long>(mqtt_connector_ptr_->attempt_count()));
+    } else {
+        ROS_MQTT_LOG_INFO("%s MQTT %s", LOG_ROS_MQTT_BRIDGE, ros_mqtt_connector::state_name(connection_state));
+    }
+
+    if(ros_status_publisher_ptr_ == nullptr) {
+        return;
+    }
+    std_msgs::msg::String status_message;
+    status_message.data = ros_mqtt_connector::state_name(connection_state);
+    try {
+        ros_status_publisher_ptr_->publish(status_message);
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[MQTT to ROS] publish status error : " << rcl_expn.what() << '\n';
     }
 }
 
@@ -96,7 +322,13 @@ void ros_mqtt_connections::manager::Bridge::grant_mqtt_subscriptions() {
     this->mqtt_subscribe(mqtt_topics::from_rcs::cmd_vel);
     this->mqtt_subscribe(mqtt_topics::from_rcs::initial_pose);
     this->mqtt_subscribe(mqtt_topics::from_rcs::add_two_ints);
+    if(MQTT_ECHO_ENABLED) {
+        this->mqtt_subscribe(mqtt_topics::from_rcs::echo);
+    }
     this->mqtt_subscribe(mqtt_topics::from_rcs::map_server_map);
+    if(mqtt_last_value_cache_ptr_ != nullptr) {
+        this->mqtt_subscribe(mqtt_topics::from_rcs::snapshot);
+    }
     // this->mqtt_subscribe(mqtt_topics::from_rcs::navigate_to_pose);
 }
 
@@ -116,12 +348,11 @@ void ros_mqtt_connections::manager::Bridge::bridge_ros_to_mqtt() {
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const std_msgs::msg::String::SharedPtr callback_chatter_data) {
                 if(callback_chatter_data == nullptr || callback_chatter_data == NULL) throw std::runtime_error("[ROS to MQTT] chatter callback is null");
-                std::string chatter_json_str = std_msgs_converter_ptr_->convert_chatter_to_json(callback_chatter_data);
-                try {
-                    mqtt_publish(mqtt_topics::to_rcs::chatter, chatter_json_str);
-                } catch(const mqtt::exception& mqtt_expn) {
-                    std::cerr << "[ROS to MQTT] /chatter mqtt response err : " << mqtt_expn.what() << '\n';
-                }
+                ros_mqtt_metrics::LatencyTrace chatter_trace = ros_mqtt_metrics::start_trace();
+                ros_message_encoder::MessageEncoder& chatter_encoder = egress_encoder(mqtt_topics::to_rcs::chatter);
+                std_msgs_converter_ptr_->convert_chatter(*callback_chatter_data, chatter_encoder);
+                this->record_converted(mqtt_topics::to_rcs::chatter, chatter_trace, chatter_encoder.buffer().size());
+                mqtt_publish(mqtt_topics::to_rcs::chatter, chatter_encoder.release(), chatter_trace);
             }
         );;
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -134,12 +365,14 @@ void ros_mqtt_connections::manager::Bridge::bridge_ros_to_mqtt() {
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const geometry_msgs::msg::Pose::SharedPtr callback_robot_pose_data) {
                 if(callback_robot_pose_data == nullptr || callback_robot_pose_data == NULL) throw std::runtime_error("[ROS to MQTT] robot_pose callback is null");
-                std::string robot_pose_json_str = geometry_msgs_converter_ptr_->convert_pose_to_json(callback_robot_pose_data);
-                try {
-                    mqtt_publish(mqtt_topics::to_rcs::robot_pose, robot_pose_json_str);   
-                } catch(const mqtt::exception& mqtt_expn) {
-                    std::cerr << "[ROS to MQTT] /robot_pose mqtt response err : " << mqtt_expn.what() << '\n';
+                ros_mqtt_metrics::LatencyTrace robot_pose_trace = ros_mqtt_metrics::start_trace();
+                if(!is_deadband_passed(mqtt_topics::to_rcs::robot_pose, ros_mqtt_deadband::to_sample(*callback_robot_pose_data), robot_pose_trace)) {
+                    return;
                 }
+                ros_message_encoder::MessageEncoder& robot_pose_encoder = egress_encoder(mqtt_topics::to_rcs::robot_pose);
+                geometry_msgs_converter_ptr_->convert_pose(*callback_robot_pose_data, robot_pose_encoder);
+                this->record_converted(mqtt_topics::to_rcs::robot_pose, robot_pose_trace, robot_pose_encoder.buffer().size());
+                mqtt_publish_batched(mqtt_topics::to_rcs::robot_pose, ros_message_types::pose, robot_pose_encoder.release(), robot_pose_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -152,12 +385,17 @@ void ros_mqtt_connections::manager::Bridge::bridge_ros_to_mqtt() {
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const geometry_msgs::msg::Twist::SharedPtr callback_twist_data) {
                 if(callback_twist_data == nullptr || callback_twist_data == NULL) throw std::runtime_error("[ROS to MQTT] twist callback is null");
-                std::string twist_json_str = geometry_msgs_converter_ptr_->convert_twist_to_json(callback_twist_data);
-                try {
-                    mqtt_publish(mqtt_topics::to_rcs::cmd_vel, twist_json_str);
-                } catch(const mqtt::exception& mqtt_expn) {
-                    std::cerr << "[ROS to MQTT] /cmd_vel mqtt response err : "  << '\n';
+                ros_mqtt_metrics::LatencyTrace twist_trace = ros_mqtt_metrics::start_trace();
+                if(this->is_stale(mqtt_topics::to_rcs::cmd_vel, twist_trace)) {
+                    return;
+                }
+                if(!is_deadband_passed(mqtt_topics::to_rcs::cmd_vel, ros_mqtt_deadband::to_sample(*callback_twist_data), twist_trace)) {
+                    return;
                 }
+                ros_message_encoder::MessageEncoder& twist_encoder = egress_encoder(mqtt_topics::to_rcs::cmd_vel);
+                geometry_msgs_converter_ptr_->convert_twist(*callback_twist_data, twist_encoder);
+                this->record_converted(mqtt_topics::to_rcs::cmd_vel, twist_trace, twist_encoder.buffer().size());
+                mqtt_publish(mqtt_topics::to_rcs::cmd_vel, twist_encoder.release(), twist_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -170,11 +408,24 @@ void ros_mqtt_connections::manager::Bridge::bridge_ros_to_mqtt() {
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const sensor_msgs::msg::LaserScan::SharedPtr callback_scan_data) {
                 if(callback_scan_data == nullptr || callback_scan_data == NULL) throw std::runtime_error("[ROS to MQTT] scan callback is null");
-                std::string scan_json_str = sensor_msgs_converter_ptr_->convert_scan_to_json(callback_scan_data);
-                try {
-                    mqtt_publish(mqtt_topics::to_rcs::scan, scan_json_str);
-                } catch(const mqtt::exception& mqtt_expn) {
-                    std::cerr << "[ROS to MQTT] /scan mqtt response err : "  << '\n';
+                ros_mqtt_metrics::LatencyTrace scan_trace = ros_mqtt_metrics::start_trace();
+                scan_trace.source_stamp_ns = ros_mqtt_metrics::stamp_nanoseconds(callback_scan_data->header.stamp.sec, callback_scan_data->header.stamp.nanosec);
+                if(this->is_stale(mqtt_topics::to_rcs::scan, scan_trace)) {
+                    return;
+                }
+                if(this->is_egress_admitted(mqtt_topics::to_rcs::scan, scan_trace)) {
+                    ros_message_encoder::MessageEncoder& scan_encoder = egress_encoder(mqtt_topics::to_rcs::scan);
+                    sensor_msgs_converter_ptr_->convert_scan(*callback_scan_data, scan_encoder);
+                    this->record_converted(mqtt_topics::to_rcs::scan, scan_trace, scan_encoder.buffer().size());
+                    mqtt_publish_compressed(mqtt_topics::to_rcs::scan, scan_encoder.release(), scan_trace);
+                }
+                if(MQTT_REDUCED_SCAN_ENABLED) {
+                    ros_mqtt_metrics::LatencyTrace reduced_scan_trace = ros_mqtt_metrics::start_trace();
+                    reduced_scan_trace.source_stamp_ns = scan_trace.source_stamp_ns;
+                    ros_message_encoder::MessageEncoder& reduced_scan_encoder = egress_encoder(mqtt_topics::to_rcs::reduced_scan);
+                    sensor_msgs_converter_ptr_->convert_scan(*callback_scan_data, reduced_scan_encoder);
+                    this->record_converted(mqtt_topics::to_rcs::reduced_scan, reduced_scan_trace, reduced_scan_encoder.buffer().size());
+                    mqtt_publish_compressed(mqtt_topics::to_rcs::reduced_scan, reduced_scan_encoder.release(), reduced_scan_trace);
                 }
             }
         );
@@ -188,12 +439,18 @@ void ros_mqtt_connections::manager::Bridge::bridge_ros_to_mqtt() {
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const tf2_msgs::msg::TFMessage::SharedPtr callback_tf_data) {
                 if(callback_tf_data == nullptr || callback_tf_data == NULL) throw std::runtime_error("[ROS to MQTT] tf callback is null");
-                std::string tf_json_str = tf2_msgs_converter_ptr_->convert_tf_to_json(callback_tf_data);
-                try {
-                    mqtt_publish(mqtt_topics::to_rcs::tf, tf_json_str);
-                } catch(const mqtt::exception& mqtt_expn) {
-                    std::cerr << "[ROS to MQTT] /tf mqtt response err : "  << '\n';
+                if(tf_aggregator_ptr_ != nullptr) {
+                    tf_aggregator_ptr_->add_transforms(*callback_tf_data, false);
+                    return;
                 }
+                ros_mqtt_metrics::LatencyTrace tf_trace = ros_mqtt_metrics::start_trace();
+                if(!callback_tf_data->transforms.empty()) {
+                    tf_trace.source_stamp_ns = ros_mqtt_metrics::stamp_nanoseconds(callback_tf_data->transforms.back().header.stamp.sec, callback_tf_data->transforms.back().header.stamp.nanosec);
+                }
+                ros_message_encoder::MessageEncoder& tf_encoder = egress_encoder(mqtt_topics::to_rcs::tf);
+                tf2_msgs_converter_ptr_->convert_tf(*callback_tf_data, tf_encoder);
+                this->record_converted(mqtt_topics::to_rcs::tf, tf_trace, tf_encoder.buffer().size());
+                mqtt_publish_batched(mqtt_topics::to_rcs::tf, ros_message_types::tf, tf_encoder.release(), tf_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -203,15 +460,20 @@ void ros_mqtt_connections::manager::Bridge::bridge_ros_to_mqtt() {
     try {
         ros_tf_static_subscription_ptr_ = ros_node_ptr_->create_subscription<tf2_msgs::msg::TFMessage>(
             ros_topics::from_ros::tf_static,
-            rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
+            rclcpp::QoS(ROS_TF_STATIC_QOS_DEPTH).transient_local(),
             [this](const tf2_msgs::msg::TFMessage::SharedPtr callback_tf_static_data) {
                 if(callback_tf_static_data == nullptr || callback_tf_static_data == NULL) throw std::runtime_error("[ROS to MQTT] tf_static callback is null");
-                std::string tf_static_json_str = tf2_msgs_converter_ptr_->convert_tf_to_json(callback_tf_static_data);
-                try {
-                    mqtt_publish(mqtt_topics::to_rcs::tf_static, tf_static_json_str);
-                } catch(const mqtt::exception& mqtt_expn) {
-                    std::cerr << "[ROS to MQTT] /tf_static mqtt response err : "  << '\n';
+                if(tf_aggregator_ptr_ != nullptr) {
+                    tf_aggregator_ptr_->add_transforms(*callback_tf_static_data, true);
                 }
+                ros_mqtt_metrics::LatencyTrace tf_static_trace = ros_mqtt_metrics::start_trace();
+                if(!callback_tf_static_data->transforms.empty()) {
+                    tf_static_trace.source_stamp_ns = ros_mqtt_metrics::stamp_nanoseconds(callback_tf_static_data->transforms.back().header.stamp.sec, callback_tf_static_data->transforms.back().header.stamp.nanosec);
+                }
+                ros_message_encoder::MessageEncoder& tf_static_encoder = egress_encoder(mqtt_topics::to_rcs::tf_static);
+                tf2_msgs_converter_ptr_->convert_tf(*callback_tf_static_data, tf_static_encoder);
+                this->record_converted(mqtt_topics::to_rcs::tf_static, tf_static_trace, tf_static_encoder.buffer().size());
+                mqtt_publish(mqtt_topics::to_rcs::tf_static, tf_static_encoder.release(), tf_static_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -224,30 +486,76 @@ void ros_mqtt_connections::manager::Bridge::bridge_ros_to_mqtt() {
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const nav_msgs::msg::Odometry::SharedPtr callback_odom_data) {
                 if(callback_odom_data == nullptr || callback_odom_data == NULL) throw std::runtime_error("[ROS to MQTT] odom callback is null");
-                std::string odom_json_str = nav_msgs_converter_ptr_->convert_odom_to_json(callback_odom_data);
-                try {
-                    mqtt_publish(mqtt_topics::to_rcs::odom, odom_json_str);
-                } catch(const mqtt::exception& mqtt_expn) {
-                    std::cerr << "[ROS to MQTT] /odom mqtt response err : "  << '\n';
+                ros_mqtt_metrics::LatencyTrace odom_trace = ros_mqtt_metrics::start_trace();
+                odom_trace.source_stamp_ns = ros_mqtt_metrics::stamp_nanoseconds(callback_odom_data->header.stamp.sec, callback_odom_data->header.stamp.nanosec);
+                if(this->is_stale(mqtt_topics::to_rcs::odom, odom_trace)) {
+                    return;
+                }
+                if(!is_deadband_passed(mqtt_topics::to_rcs::odom, ros_mqtt_deadband::to_sample(*callback_odom_data), odom_trace)) {
+                    return;
                 }
+                ros_message_encoder::MessageEncoder& odom_encoder = egress_encoder(mqtt_topics::to_rcs::odom);
+                nav_msgs_converter_ptr_->convert_odom(*callback_odom_data, odom_encoder);
+                this->record_converted(mqtt_topics::to_rcs::odom, odom_trace, odom_encoder.buffer().size());
+                mqtt_publish_batched(mqtt_topics::to_rcs::odom, ros_message_types::odom, odom_encoder.release(), odom_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
         std::cerr << "[ROS to MQTT] /odom bridge err : " << rcl_expn.what() << '\n';
     }
 
+    try {
+        ros_global_plan_subscription_ptr_ = ros_node_ptr_->create_subscription<nav_msgs::msg::Path>(
+            ros_topics::from_ros::global_plan,
+            rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
+            [this](const nav_msgs::msg::Path::SharedPtr callback_global_plan_data) {
+                if(callback_global_plan_data == nullptr || callback_global_plan_data == NULL) throw std::runtime_error("[ROS to MQTT] global_plan callback is null");
+                ros_mqtt_metrics::LatencyTrace global_plan_trace = ros_mqtt_metrics::start_trace();
+                global_plan_trace.source_stamp_ns = ros_mqtt_metrics::stamp_nanoseconds(callback_global_plan_data->header.stamp.sec, callback_global_plan_data->header.stamp.nanosec);
+                if(!this->is_egress_admitted(mqtt_topics::to_rcs::global_plan, global_plan_trace)) {
+                    return;
+                }
+                ros_message_encoder::MessageEncoder& global_plan_encoder = egress_encoder(mqtt_topics::to_rcs::global_plan);
+                this->convert_plan(mqtt_topics::to_rcs::global_plan, *callback_global_plan_data, global_plan_encoder);
+                this->record_converted(mqtt_topics::to_rcs::global_plan, global_plan_trace, global_plan_encoder.buffer().size());
+                mqtt_publish_compressed(mqtt_topics::to_rcs::global_plan, global_plan_encoder.release(), global_plan_trace);
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[ROS to MQTT] /global_plan bridge err : " << rcl_expn.what() << '\n';
+    }
+
+    try {
+        ros_local_plan_subscription_ptr_ = ros_node_ptr_->create_subscription<nav_msgs::msg::Path>(
+            ros_topics::from_ros::local_plan,
+            rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
+            [this](const nav_msgs::msg::Path::SharedPtr callback_local_plan_data) {
+                if(callback_local_plan_data == nullptr || callback_local_plan_data == NULL) throw std::runtime_error("[ROS to MQTT] local_plan callback is null");
+                ros_mqtt_metrics::LatencyTrace local_plan_trace = ros_mqtt_metrics::start_trace();
+                local_plan_trace.source_stamp_ns = ros_mqtt_metrics::stamp_nanoseconds(callback_local_plan_data->header.stamp.sec, callback_local_plan_data->header.stamp.nanosec);
+                if(!this->is_egress_admitted(mqtt_topics::to_rcs::local_plan, local_plan_trace)) {
+                    return;
+                }
+                ros_message_encoder::MessageEncoder& local_plan_encoder = egress_encoder(mqtt_topics::to_rcs::local_plan);
+                this->convert_plan(mqtt_topics::to_rcs::local_plan, *callback_local_plan_data, local_plan_encoder);
+                this->record_converted(mqtt_topics::to_rcs::local_plan, local_plan_trace, local_plan_encoder.buffer().size());
+                mqtt_publish_compressed(mqtt_topics::to_rcs::local_plan, local_plan_encoder.release(), local_plan_trace);
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[ROS to MQTT] /local_plan bridge err : " << rcl_expn.what() << '\n';
+    }
+
     try {
         ros_add_two_ints_subscription_ptr_ = ros_node_ptr_->create_subscription<example_interfaces::srv::AddTwoInts_Response>(
             ros_topics::from_ros::add_two_ints,
             rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
             [this](const example_interfaces::srv::AddTwoInts_Response::SharedPtr callback_add_two_ints_data) {
                 if(callback_add_two_ints_data == nullptr || callback_add_two_ints_data == NULL) throw std::runtime_error("[ROS to MQTT] add two ints callback is null");
+                ros_mqtt_metrics::LatencyTrace add_two_ints_trace = ros_mqtt_metrics::start_trace();
                 std::string add_two_ints_response = std::to_string(callback_add_two_ints_data->sum);
-                try {
-                    mqtt_publish(mqtt_topics::to_rcs::add_two_ints, add_two_ints_response);
-                } catch(const mqtt::exception& mqtt_expn) {
-                    std::cerr << "[ROS to MQTT] /add_two_ints/response mqtt response err : "  << '\n';
-                }
+                this->record_converted(mqtt_topics::to_rcs::add_two_ints, add_two_ints_trace, add_two_ints_response.size());
+                mqtt_publish(mqtt_topics::to_rcs::add_two_ints, add_two_ints_response, add_two_ints_trace);
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
@@ -263,26 +571,40 @@ void ros_mqtt_connections::manager::Bridge::bridge_ros_to_mqtt() {
                     throw std::runtime_error("[ROS to MQTT] map server map callback is null");
                 } else if(callback_map_server_map_data->map.header.frame_id == ros_services::exceptions::map_server_map_timed_out) {
                     std::cerr << "[ROS to MQTT] /map_server/map service timed out"  << '\n';
-                    try {
-                        mqtt_publish(mqtt_topics::to_rcs::map_server_map, ros_services::exceptions::map_server_map_timed_out);
-                    } catch(const mqtt::exception& mqtt_expn) {
-                        std::cerr << "[ROS to MQTT] /map_server/map/response mqtt response err : " << mqtt_expn.what()  << '\n';
-                    }
+                    mqtt_publish(mqtt_topics::to_rcs::map_server_map, ros_services::exceptions::map_server_map_timed_out);
                 } else {
-                    std::cout << "[ROS to MQTT] /map_server/map/response callback : " << callback_map_server_map_data->map.info.width << '\n';
-                    std::string parsed_map_server_map_response = nav_msgs_converter_ptr_->convert_map_response_to_json(callback_map_server_map_data);
-                    std::cout << "[MQTT to ROS] parsed map result : " << parsed_map_server_map_response << '\n';
-                    try {
-                        mqtt_publish(mqtt_topics::to_rcs::map_server_map, parsed_map_server_map_response);
-                    } catch(const mqtt::exception& mqtt_expn) {
-                        std::cerr << "[ROS to MQTT] /map_server/map/response mqtt response err : " << mqtt_expn.what()  << '\n';
-                    }
+                    ros_mqtt_metrics::LatencyTrace map_response_trace = ros_mqtt_metrics::start_trace();
+                    map_response_trace.source_stamp_ns = ros_mqtt_metrics::stamp_nanoseconds(callback_map_server_map_data->map.header.stamp.sec, callback_map_server_map_data->map.header.stamp.nanosec);
+                    ros_message_encoder::MessageEncoder& map_response_encoder = egress_encoder(mqtt_topics::to_rcs::map_server_map);
+                    nav_msgs_converter_ptr_->convert_map_response(*callback_map_server_map_data, map_response_encoder);
+                    this->record_converted(mqtt_topics::to_rcs::map_server_map, map_response_trace, map_response_encoder.buffer().size());
+                    ROS_MQTT_LOG_TOPIC(ros_mqtt_logger::LogLevel::DEBUG, mqtt_topics::to_rcs::map_server_map, "[ROS to MQTT] /map_server/map/response %ux%u converted into %zu bytes", callback_map_server_map_data->map.info.width, callback_map_server_map_data->map.info.height, map_response_encoder.buffer().size());
+                    mqtt_publish_compressed(mqtt_topics::to_rcs::map_server_map, map_response_encoder.release(), map_response_trace);
                 }
             }
         );
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
         std::cerr << "[ROS to MQTT] /map_server_map bridge err : " << rcl_expn.what() << '\n';
     }
+
+    if(!MQTT_ECHO_ENABLED) {
+        return;
+    }
+
+    try {
+        ros_echo_subscription_ptr_ = ros_node_ptr_->create_subscription<std_msgs::msg::String>(
+            ros_topics::from_ros::echo,
+            rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_)),
+            [this](const std_msgs::msg::String::SharedPtr callback_echo_data) {
+                if(callback_echo_data == nullptr || callback_echo_data == NULL) throw std::runtime_error("[ROS to MQTT] echo callback is null");
+                ros_mqtt_metrics::LatencyTrace echo_trace = ros_mqtt_metrics::start_trace();
+                this->record_converted(mqtt_topics::to_rcs::echo, echo_trace, callback_echo_data->data.size());
+                mqtt_publish(mqtt_topics::to_rcs::echo, callback_echo_data->data, echo_trace);
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[ROS to MQTT] /echo bridge err : " << rcl_expn.what() << '\n';
+    }
 }
 
 /**
@@ -342,6 +664,19 @@ void ros_mqtt_connections::manager::Bridge::bridge_mqtt_to_ros() {
     } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
         std::cerr << "[MQTT to ROS] /map_server/map publish bridge err : " << rcl_expn.what() << '\n';
     }
+
+    if(!MQTT_ECHO_ENABLED) {
+        return;
+    }
+
+    try {
+        ros_echo_publisher_ptr_ = ros_node_ptr_->create_publisher<std_msgs::msg::String>(
+            ros_topics::to_ros::echo,
+            rclcpp::QoS(rclcpp::KeepLast(ros_default_qos_))
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[MQTT to ROS] /echo publish bridge err : " << rcl_expn.what() << '\n';
+    }
 }
 
 /**
@@ -350,47 +685,64 @@ void ros_mqtt_connections::manager::Bridge::bridge_mqtt_to_ros() {
  * @date 23.05.11
  * @param mqtt_topic std::string&
  * @param mqtt_payload std::string&
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
  * @return void
 */
-void ros_mqtt_connections::manager::Bridge::bridge_mqtt_to_ros(std::string& mqtt_topic, std::string& mqtt_payload) {
-    std::cout << "[MQTT to ROS] message arrived" << '\n';
-    std::cout << "\ttopic: '" << mqtt_topic << "'" << '\n';
-    std::cout << "\tpayload: '" << mqtt_payload << "'" << '\n';
+void ros_mqtt_connections::manager::Bridge::bridge_mqtt_to_ros(std::string& mqtt_topic, std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    ROS_MQTT_LOG_PAYLOAD(mqtt_topic, mqtt_payload, "[MQTT to ROS] message arrived on '%s' (%zu bytes)", mqtt_topic.c_str(), mqtt_payload.size());
 
     if(mqtt_topic == mqtt_topics::from_rcs::chatter) {
         try {
-            std::cout << "[MQTT to ROS] publish to " << mqtt_topic << '\n';
-            std_msgs::msg::String std_message = std_msgs_converter_ptr_->convert_json_to_chatter(mqtt_payload);
+            std_msgs::msg::String std_message = ingress_encoding(mqtt_topic) == ros_message_encoder::Encoding::JSON
+                ? std_msgs_converter_ptr_->convert_json_to_chatter(mqtt_payload)
+                : std_msgs_converter_ptr_->convert_json_to_chatter(decode_mqtt_payload(mqtt_topic, mqtt_payload));
+            this->record_conversion_error(mqtt_topic, std_msgs_converter_ptr_->is_parse_failed());
             ros_chatter_publisher_ptr_->publish(std_message);
+            this->record_published(mqtt_topic, latency_trace);
         } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
             std::cerr << "[MQTT to ROS] publish chatter error : " << rcl_expn.what() << '\n';
         }
     } else if(mqtt_topic == mqtt_topics::from_rcs::cmd_vel) {
         try {
-            std::cout << "[MQTT to ROS] publish to " << mqtt_topic << '\n';
-            geometry_msgs::msg::Twist twist_message = geometry_msgs_converter_ptr_->convert_json_to_twist(mqtt_payload);
+            geometry_msgs::msg::Twist twist_message = ingress_encoding(mqtt_topic) == ros_message_encoder::Encoding::JSON
+                ? geometry_msgs_converter_ptr_->convert_json_to_twist(mqtt_payload)
+                : geometry_msgs_converter_ptr_->convert_json_to_twist(decode_mqtt_payload(mqtt_topic, mqtt_payload));
+            this->record_conversion_error(mqtt_topic, geometry_msgs_converter_ptr_->is_parse_failed());
+            ros_mqtt_metrics::LatencyTrace cmd_vel_trace = latency_trace;
+            cmd_vel_trace.source_stamp_ns = geometry_msgs_converter_ptr_->sent_ns();
+            if(this->is_stale(mqtt_topics::from_rcs::cmd_vel, cmd_vel_trace)) {
+                return;
+            }
+            if(mqtt_cmd_vel_hold_ptr_ != nullptr) {
+                mqtt_cmd_vel_hold_ptr_->hold(twist_message, cmd_vel_trace);
+                return;
+            }
             ros_cmd_vel_publisher_ptr_->publish(twist_message);
+            this->record_published(mqtt_topic, latency_trace);
         } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
             std::cerr << "[MQTT to ROS] publish cmd_vel error : " << rcl_expn.what() << '\n';
         }
     } else if(mqtt_topic == mqtt_topics::from_rcs::initial_pose) {
         try {
-            std::cout << "[MQTT to ROS] publish to " << mqtt_topic << '\n';
-            geometry_msgs::msg::PoseWithCovarianceStamped pose_with_covariance_stamped_message = geometry_msgs_converter_ptr_->convert_json_to_pose_with_covariance_stamped(mqtt_payload);
+            geometry_msgs::msg::PoseWithCovarianceStamped pose_with_covariance_stamped_message = ingress_encoding(mqtt_topic) == ros_message_encoder::Encoding::JSON
+                ? geometry_msgs_converter_ptr_->convert_json_to_pose_with_covariance_stamped(mqtt_payload)
+                : geometry_msgs_converter_ptr_->convert_json_to_pose_with_covariance_stamped(decode_mqtt_payload(mqtt_topic, mqtt_payload));
+            this->record_conversion_error(mqtt_topic, geometry_msgs_converter_ptr_->is_parse_failed());
             ros_initial_pose_publisher_ptr_->publish(pose_with_covariance_stamped_message);
+            this->record_published(mqtt_topic, latency_trace);
         } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
             std::cerr << "[MQTT to ROS] publish initial_pose error : " << rcl_expn.what() << '\n';
         }
     } else if(mqtt_topic == mqtt_topics::from_rcs::add_two_ints) {
         try {
-            std::cout << "[MQTT to ROS] service call to /add_two_ints_service " << '\n';
+            ROS_MQTT_LOG_INFO("[MQTT to ROS] service call to /add_two_ints_service");
             bool is_add_two_ints_service_ready = ros_add_two_ints_service_client_ptr_->wait_for_service(std::chrono::seconds(1));
             while (!is_add_two_ints_service_ready) {
                 if (!rclcpp::ok()) {
-                    std::cout << "[MQTT to ROS] interrupted while waiting /add_two_ints service..." << '\n';
+                    ROS_MQTT_LOG_WARN("[MQTT to ROS] interrupted while waiting /add_two_ints service...");
                     break;
                 } else if(is_add_two_ints_service_ready) {
-                    std::cout << "[MQTT to ROS] /add_two_ints service is ready!" << '\n';
+                    ROS_MQTT_LOG_INFO("[MQTT to ROS] /add_two_ints service is ready!");
                     break;
                 }
             }
@@ -399,8 +751,9 @@ void ros_mqtt_connections::manager::Bridge::bridge_mqtt_to_ros(std::string& mqtt
             add_two_ints_request->b = 60;
             std::shared_future<std::shared_ptr<example_interfaces::srv::AddTwoInts_Response>> add_two_ints_result_future = ros_add_two_ints_service_client_ptr_->async_send_request(add_two_ints_request);
             const std::shared_ptr<example_interfaces::srv::AddTwoInts_Response> add_two_ints_service_call_result = add_two_ints_result_future.get();
-            std::cout << "[MQTT to ROS] /add_two_ints result of " << add_two_ints_request->a << " + " << add_two_ints_request->b << " = " << add_two_ints_service_call_result->sum << '\n';
+            ROS_MQTT_LOG_INFO("[MQTT to ROS] /add_two_ints result of %lld + %lld = %lld", static_cast<long long>(add_two_ints_request->a), static_cast<long long>(add_two_ints_request->b), static_cast<long long>(add_two_ints_service_call_result->sum));
             ros_add_two_ints_publisher_ptr_->publish(*add_two_ints_service_call_result);
+            this->record_published(mqtt_topic, latency_trace);
         } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
             std::cerr << "[MQTT to ROS] call /add_two_ints error : " << rcl_expn.what() << '\n';
         }
@@ -408,52 +761,77 @@ void ros_mqtt_connections::manager::Bridge::bridge_mqtt_to_ros(std::string& mqtt
         try {
             const std_msgs::msg::String::SharedPtr empty_request = std::make_shared<std_msgs::msg::String>();
             ros_map_server_map_publisher_ptr_->publish(*empty_request);
+            this->record_published(mqtt_topic, latency_trace);
         } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
             std::cerr << "[MQTT to ROS] call /map_server/map error : " << rcl_expn.what() << '\n';
         }
+    } else if(mqtt_topic == mqtt_topics::from_rcs::echo && ros_echo_publisher_ptr_ != nullptr) {
+        this->bridge_echo(mqtt_payload, latency_trace);
+    } else if(mqtt_topic == mqtt_topics::from_rcs::snapshot && mqtt_last_value_cache_ptr_ != nullptr) {
+        this->bridge_snapshot(latency_trace);
     } else {
         return;
     }
 }
 
 /**
- * @brief Overrided function for handle cause when mqtt connection lost
+ * @brief Overrided function for handle cause when mqtt connection lost, egress is buffered until connector connected again
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
  * @param mqtt_connection_lost_cause const std::string&
  * @return void
- * @see mqtt::callback
+ * @see ros_mqtt_transport::TransportCallback
 */
 void ros_mqtt_connections::manager::Bridge::connection_lost(const std::string& mqtt_connection_lost_cause) {
     std::cerr << log_ros_mqtt_bridge_ << " connection lost : " << mqtt_connection_lost_cause << '\n';
+    mqtt_offline_buffer_ptr_->open();
+    mqtt_connector_ptr_->notify_lost();
 }
 
 /**
  * @brief Overrided function for handle message when mqtt subscription get callback mqtt message
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
- * @param mqtt_message mqtt::const_message_ptr
+ * @param arrived_topic const std::string&
+ * @param arrived_payload const std::string&
  * @return void
- * @see mqtt::callback
- * @see mqtt::const_message_ptr
+ * @see ros_mqtt_transport::TransportCallback
  * @see ros_mqtt_connections::publisher::ros_chatter_publisher_ptr
 */
-void ros_mqtt_connections::manager::Bridge::message_arrived(mqtt::const_message_ptr mqtt_message) {
-    std::string mqtt_topic = mqtt_message->get_topic();
-    std::string mqtt_payload = mqtt_message->to_string();
-    this->bridge_mqtt_to_ros(mqtt_topic, mqtt_payload);
+void ros_mqtt_connections::manager::Bridge::message_arrived(const std::string& arrived_topic, const std::string& arrived_payload) {
+    const ros_mqtt_metrics::LatencyTrace arrival_trace = ros_mqtt_metrics::start_trace();
+    std::string mqtt_topic = arrived_topic;
+    std::string mqtt_payload = arrived_payload;
+
+    ros_mqtt_metrics::TopicMetrics * arrival_metrics = this->topic_metrics(mqtt_topic);
+    if(arrival_metrics != nullptr) {
+        arrival_metrics->messages_in.fetch_add(1, std::memory_order_relaxed);
+        arrival_metrics->bytes_in.fetch_add(mqtt_payload.size(), std::memory_order_relaxed);
+    }
+
+    if(ros_mqtt_compression::is_compressed(mqtt_payload)) {
+        std::string decompressed_payload;
+        if(!ros_mqtt_compression::decompress(mqtt_payload, decompressed_payload)) {
+            std::cerr << LOG_ROS_MQTT_CONNECTION_TO_ROS << " dropped undecodable compressed payload of " << mqtt_topic << '\n';
+            this->record_conversion_error(mqtt_topic, true);
+            return;
+        }
+        mqtt_payload.swap(decompressed_payload);
+    }
+
+    this->bridge_mqtt_to_ros(mqtt_topic, mqtt_payload, arrival_trace);
 }
 
 /**
- * @brief Overrided function for handle delivered token
+ * @brief Overrided function for handle delivered message id
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
- * @param mqtt_delivered_token mqtt::delivery_token_ptr
+ * @param delivered_message_id int
  * @return void
- * @see mqtt::callback
+ * @see ros_mqtt_transport::TransportCallback
 */
-void ros_mqtt_connections::manager::Bridge::delivery_complete(mqtt::delivery_token_ptr mqtt_delivered_token) {
-	std::cout << log_ros_mqtt_bridge_ << " delivery complete with [" << mqtt_delivered_token <<  "] \n";
+void ros_mqtt_connections::manager::Bridge::delivery_complete(int delivered_message_id) {
+	ROS_MQTT_LOG_DEBUG("%s delivery complete with [%d]", LOG_ROS_MQTT_BRIDGE, delivered_message_id);
 }
 
 /**
@@ -462,22 +840,62 @@ void ros_mqtt_connections::manager::Bridge::delivery_complete(mqtt::delivery_tok
  * @date 23.05.11
  * @param topic char *
  * @param payload std::string
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace& time points of message, unknown points are not recorded
  * @return void
- * @see mqtt::message_ptr
- * @see mqtt::exception
-*/
-void ros_mqtt_connections::manager::Bridge::mqtt_publish(const char * mqtt_topic, std::string mqtt_payload) {
-	try {
-		mqtt::message_ptr mqtt_publish_msg = mqtt::make_message(mqtt_topic, mqtt_payload);
-		mqtt_publish_msg->set_qos(mqtt_qos_);
-		auto delivery_token = mqtt_async_client_.publish(mqtt_publish_msg);
-        delivery_token->wait();
-        if (delivery_token->get_return_code() != mqtt_is_success_) {
-            std::cerr << log_ros_mqtt_connections_to_mqtt_ << " publishing error : " << delivery_token->get_return_code() << '\n';
-        }
-	} catch (const mqtt::exception& mqtt_expn) {
-		std::cerr << log_ros_mqtt_connections_to_mqtt_ << " publishing error : " << mqtt_expn.what() << '\n';
+ * @see ros_mqtt_transport::Transport
+ * @details accepted is when the transport took the message, acked is when its delivery completed.
+ * trace block is embedded & local shared memory sink is written here unless an earlier stage already did it.
+ * payload is stored into last-value cache before its trace block & latched topics are published retained.
+ * payload is given back into payload pool afterwards, so the next released encoder buffer reuses it.
+ * payload past the deadline of its topic, e.g. after waiting in compression queue, is dropped instead.
+ * while transport is not connected, payload goes into offline buffer after last-value cache, trace block & shared memory sink
+*/
+void ros_mqtt_connections::manager::Bridge::mqtt_publish(const char * mqtt_topic, std::string mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+	if(this->is_stale(mqtt_topic, latency_trace)) {
+		ros_mqtt_buffer_pool::BufferPool::instance().recycle(mqtt_payload);
+		return;
+	}
+	if(!latency_trace.is_cached) {
+		this->cache_last_value(mqtt_topic, mqtt_payload);
+	}
+	this->embed_trace(mqtt_topic, mqtt_payload, latency_trace);
+	this->share_local(mqtt_topic, mqtt_payload, latency_trace);
+	if(mqtt_offline_buffer_ptr_ != nullptr && mqtt_offline_buffer_ptr_->hold(mqtt_topic, mqtt_payload, latency_trace)) {
+		ros_mqtt_buffer_pool::BufferPool::instance().recycle(mqtt_payload);
+		return;
+	}
+	this->mqtt_transmit(mqtt_topic, mqtt_payload, latency_trace);
+}
+
+/**
+ * @brief Function for publish payload through transport & record its metrics, earlier stages of mqtt_publish are done already
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param mqtt_payload std::string& given back into payload pool afterwards
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return void
+ * @see ros_mqtt_transport::Transport
+*/
+void ros_mqtt_connections::manager::Bridge::mqtt_transmit(const char * mqtt_topic, std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+	const std::size_t mqtt_payload_size = mqtt_payload.size();
+	ros_mqtt_metrics::TopicMetrics * publish_metrics = this->topic_metrics(mqtt_topic);
+	const bool is_retained = mqtt_retained_topics_.find(mqtt_topic) != mqtt_retained_topics_.end();
+	const ros_mqtt_transport::PublishResult publish_result = mqtt_transport_ptr_->publish(mqtt_topic, mqtt_payload, mqtt_qos_, is_retained);
+	if (publish_result.return_code != mqtt_is_success_) {
+		std::cerr << LOG_ROS_MQTT_CONNECTION_TO_MQTT << " publishing error : " << publish_result.return_code << '\n';
+		this->record_dropped(mqtt_topic);
+	} else if(publish_metrics != nullptr) {
+		publish_metrics->messages_out.fetch_add(1, std::memory_order_relaxed);
+		publish_metrics->bytes_out.fetch_add(mqtt_payload_size, std::memory_order_relaxed);
+		publish_metrics->latency(ros_mqtt_metrics::LatencyStage::CONVERTED_TO_ACCEPTED).record(latency_trace.converted, publish_result.accepted);
+		publish_metrics->latency(ros_mqtt_metrics::LatencyStage::ACCEPTED_TO_ACKED).record(publish_result.accepted, publish_result.acked);
+		publish_metrics->latency(ros_mqtt_metrics::LatencyStage::RECEIVE_TO_ACKED).record(latency_trace.received, publish_result.acked);
+	}
+	if(mqtt_egress_governor_ptr_ != nullptr && publish_result.return_code == mqtt_is_success_ && latency_trace.received != std::chrono::steady_clock::time_point()) {
+		mqtt_egress_governor_ptr_->record_latency(publish_result.acked - latency_trace.received);
 	}
+	ros_mqtt_buffer_pool::BufferPool::instance().recycle(mqtt_payload);
 }
 
 /**
@@ -485,17 +903,1112 @@ void ros_mqtt_connections::manager::Bridge::mqtt_publish(const char * mqtt_topic
  * @author reidlo(naru5135@wavem.net)
  * @date 23.05.11
  * @param topic char *
- * @see mqtt::exception
+ * @see ros_mqtt_transport::Transport
 */
 void ros_mqtt_connections::manager::Bridge::mqtt_subscribe(const char * mqtt_topic) {
-	try {
-		std::cout << log_ros_mqtt_connections_to_ros_ << " grant subscription with '" << mqtt_topic << "' " << '\n';
-		mqtt_async_client_.subscribe(mqtt_topic, mqtt_qos_);
-	} catch (const mqtt::exception& mqtt_expn) {
-		std::cerr << log_ros_mqtt_connections_to_ros_ << " grant subscription error : " << mqtt_expn.what() << '\n';
+	ROS_MQTT_LOG_INFO("%s grant subscription with '%s'", LOG_ROS_MQTT_CONNECTION_TO_ROS, mqtt_topic);
+	const int subscribe_result = mqtt_transport_ptr_->subscribe(mqtt_topic, mqtt_qos_);
+	if (subscribe_result != mqtt_is_success_) {
+		std::cerr << LOG_ROS_MQTT_CONNECTION_TO_ROS << " grant subscription error : " << subscribe_result << '\n';
 	}
 }
 
+/**
+ * @brief Function for initialize log level, payload dumping & per-topic sampling of high rate topics
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_logger::Logger
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_logger() {
+    ros_mqtt_logger::Logger& ros_mqtt_logger = ros_mqtt_logger::Logger::instance();
+    ros_mqtt_logger.set_level(LOG_LEVEL);
+    ros_mqtt_logger.set_payload_enabled(LOG_PAYLOAD_ENABLED);
+    ros_mqtt_logger.set_topic_sample_rate(mqtt_topics::from_rcs::cmd_vel, LOG_HIGH_RATE_SAMPLE_RATE);
+    ros_mqtt_logger.set_topic_sample_rate(mqtt_topics::from_rcs::initial_pose, LOG_HIGH_RATE_SAMPLE_RATE);
+    ros_mqtt_logger.set_topic_sample_rate(mqtt_topics::to_rcs::map_server_map, 1);
+}
+
+/**
+ * @brief Function for initialize batching stage & its flush timer when batching is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_batch::MessageBatcher
+ * @details timer ticks MQTT_BATCH_FLUSH_TICKS times per max delay, so an envelope is flushed at most max delay / ticks late
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_mqtt_batch() {
+    if(!mqtt_batch_enabled_) {
+        return;
+    }
+
+    mqtt_batcher_ptr_ = new ros_mqtt_batch::MessageBatcher(MQTT_BATCH_MAX_MESSAGES, std::chrono::milliseconds(MQTT_BATCH_MAX_DELAY_MS));
+
+    try {
+        mqtt_batch_timer_ptr_ = ros_node_ptr_->create_wall_timer(
+            std::chrono::milliseconds(std::max(1, MQTT_BATCH_MAX_DELAY_MS / MQTT_BATCH_FLUSH_TICKS)),
+            [this]() {
+                if(mqtt_batcher_ptr_->is_expired()) {
+                    flush_mqtt_batch();
+                }
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[ROS to MQTT] batch timer err : " << rcl_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Function for append payload into batch envelope or mqtt publish directly when batching is disabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details batch envelope splices JSON payloads, so topics with binary encoding always bypass it
+ * @param mqtt_topic const char *
+ * @param ros_message_type const char *
+ * @param mqtt_payload std::string
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace& dropped when payload goes into envelope, batch topic is measured on its own.
+ * trace block is embedded before the payload goes into envelope, so its publish_ns is the time of batching
+ * @return void
+ * @see mqtt_publish
+ * @see flush_mqtt_batch
+*/
+void ros_mqtt_connections::manager::Bridge::mqtt_publish_batched(const char * mqtt_topic, const char * ros_message_type, std::string mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    if(mqtt_batcher_ptr_ == nullptr || egress_encoding(mqtt_topic) != ros_message_encoder::Encoding::JSON) {
+        this->mqtt_publish_compressed(mqtt_topic, std::move(mqtt_payload), latency_trace);
+        return;
+    }
+    if(this->is_stale(mqtt_topic, latency_trace)) {
+        ros_mqtt_buffer_pool::BufferPool::instance().recycle(mqtt_payload);
+        return;
+    }
+
+    this->cache_last_value(mqtt_topic, mqtt_payload);
+    this->embed_trace(mqtt_topic, mqtt_payload, latency_trace);
+    this->share_local(mqtt_topic, mqtt_payload, latency_trace);
+    bool is_batch_full = mqtt_batcher_ptr_->add(mqtt_topic, ros_message_type, ros_mqtt_metrics::wall_nanoseconds(latency_trace.received), std::move(mqtt_payload));
+    if(is_batch_full) {
+        this->flush_mqtt_batch();
+    }
+}
+
+/**
+ * @brief Function for mqtt publish current batch envelope once
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_batch::MessageBatcher
+*/
+void ros_mqtt_connections::manager::Bridge::flush_mqtt_batch() {
+    std::string batch_envelope = mqtt_batcher_ptr_->flush();
+    if(batch_envelope.empty()) {
+        return;
+    }
+    this->mqtt_publish_compressed(mqtt_topics::to_rcs::batch, std::move(batch_envelope));
+}
+
+/**
+ * @brief Function for initialize per-topic compression options & compression worker when any topic is compressed
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details bulk topics(scan, plans, snapshot & map with a higher level) trade cpu for size, high rate small topics(reduced scan, odom & batch) use a fast level
+ * @see ros_mqtt_compression::CompressionWorker
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_mqtt_compression() {
+    const ros_mqtt_compression::CompressionOptions bulk_compression_options{MQTT_COMPRESSION_CODEC, MQTT_COMPRESSION_LEVEL, MQTT_COMPRESSION_THRESHOLD};
+    const ros_mqtt_compression::CompressionOptions map_compression_options{MQTT_COMPRESSION_CODEC, MQTT_MAP_COMPRESSION_LEVEL, MQTT_COMPRESSION_THRESHOLD};
+    const ros_mqtt_compression::CompressionOptions stream_compression_options{MQTT_STREAM_COMPRESSION_CODEC, MQTT_STREAM_COMPRESSION_LEVEL, MQTT_STREAM_COMPRESSION_THRESHOLD};
+
+    mqtt_compression_options_[mqtt_topics::to_rcs::scan] = bulk_compression_options;
+    mqtt_compression_options_[mqtt_topics::to_rcs::global_plan] = bulk_compression_options;
+    mqtt_compression_options_[mqtt_topics::to_rcs::local_plan] = bulk_compression_options;
+    mqtt_compression_options_[mqtt_topics::to_rcs::snapshot] = bulk_compression_options;
+    mqtt_compression_options_[mqtt_topics::to_rcs::map_server_map] = map_compression_options;
+    mqtt_compression_options_[mqtt_topics::to_rcs::reduced_scan] = stream_compression_options;
+    mqtt_compression_options_[mqtt_topics::to_rcs::odom] = stream_compression_options;
+    mqtt_compression_options_[mqtt_topics::to_rcs::batch] = stream_compression_options;
+
+    bool is_compression_used = false;
+    for(const std::pair<const std::string, ros_mqtt_compression::CompressionOptions>& compression_options : mqtt_compression_options_) {
+        if(compression_options.second.codec != ros_mqtt_compression::Codec::NONE) {
+            is_compression_used = true;
+        }
+    }
+
+    if(is_compression_used) {
+        mqtt_compression_worker_ptr_ = new ros_mqtt_compression::CompressionWorker(
+            MQTT_COMPRESSION_QUEUE_SIZE,
+            [this](const char * mqtt_topic, std::string mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+                this->mqtt_publish(mqtt_topic, std::move(mqtt_payload), latency_trace);
+            },
+            [this](const char * mqtt_topic) {
+                this->record_dropped(mqtt_topic);
+            }
+        );
+    }
+}
+
+/**
+ * @brief Function for hand payload to compression worker when its topic is compressed, otherwise mqtt publish directly
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @details compressed payload can not be changed afterwards, so its trace block is embedded before submit & publish_ns is the time of submit.
+ * last-value cache takes payload before submit as well, since snapshot envelope splices JSON & can not hold compressed bytes
+ * @param mqtt_topic const char *
+ * @param mqtt_payload std::string
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return void
+ * @see ros_mqtt_compression::CompressionWorker
+*/
+void ros_mqtt_connections::manager::Bridge::mqtt_publish_compressed(const char * mqtt_topic, std::string mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    if(mqtt_compression_worker_ptr_ != nullptr) {
+        std::map<std::string, ros_mqtt_compression::CompressionOptions, std::less<>>::const_iterator compression_options = mqtt_compression_options_.find(mqtt_topic);
+        if(compression_options != mqtt_compression_options_.end()
+            && compression_options->second.codec != ros_mqtt_compression::Codec::NONE
+            && mqtt_payload.size() >= compression_options->second.threshold) {
+            this->cache_last_value(mqtt_topic, mqtt_payload);
+            ros_mqtt_metrics::LatencyTrace submitted_trace = latency_trace;
+            submitted_trace.is_cached = true;
+            submitted_trace.is_embedded = this->embed_trace(mqtt_topic, mqtt_payload, latency_trace) || latency_trace.is_embedded;
+            submitted_trace.is_shared = this->share_local(mqtt_topic, mqtt_payload, latency_trace) || latency_trace.is_shared;
+            mqtt_compression_worker_ptr_->submit(mqtt_topic, std::move(mqtt_payload), compression_options->second, submitted_trace);
+            return;
+        }
+    }
+
+    this->mqtt_publish(mqtt_topic, std::move(mqtt_payload), latency_trace);
+}
+
+/**
+ * @brief Function for initialize per-topic egress & ingress encodings with their encoders & decoders, and per-topic output options
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_message_encoder::create_encoder
+ * @see ros_message_encoder::create_decoder
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_mqtt_encodings() {
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::chatter] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::robot_pose] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::cmd_vel] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::scan] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::reduced_scan] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::tf] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::tf_static] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::odom] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::global_plan] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::local_plan] = MQTT_EGRESS_ENCODING;
+    mqtt_egress_encodings_[mqtt_topics::to_rcs::map_server_map] = MQTT_EGRESS_ENCODING;
+
+    mqtt_ingress_encodings_[mqtt_topics::from_rcs::chatter] = MQTT_INGRESS_ENCODING;
+    mqtt_ingress_encodings_[mqtt_topics::from_rcs::cmd_vel] = MQTT_INGRESS_ENCODING;
+    mqtt_ingress_encodings_[mqtt_topics::from_rcs::initial_pose] = MQTT_INGRESS_ENCODING;
+
+    const ros_mqtt_scan::ScanReduction no_scan_reduction{0, false, 0.0f, 0.0f, 0.0f};
+    const ros_mqtt_scan::ScanReduction reduced_scan_reduction{MQTT_REDUCED_SCAN_BEAMS, true, MQTT_REDUCED_SCAN_ANGLE_MIN, MQTT_REDUCED_SCAN_ANGLE_MAX, MQTT_REDUCED_SCAN_RANGE_CLAMP};
+    const ros_message_encoder::OutputOptions pose_output_options{MQTT_POSE_DECIMALS, MQTT_ZERO_COVARIANCE_OMITTED, false, false, false, ros_mqtt_path::PathSimplification::NONE, 0.0, 0, no_scan_reduction};
+    const ros_message_encoder::OutputOptions scan_output_options{MQTT_SCAN_DECIMALS, false, MQTT_SCAN_TIMING_OMITTED, MQTT_SCAN_TIMING_OMITTED, MQTT_SCAN_INTENSITIES_OMITTED, ros_mqtt_path::PathSimplification::NONE, 0.0, 0, no_scan_reduction};
+    const ros_message_encoder::OutputOptions reduced_scan_output_options{MQTT_SCAN_DECIMALS, false, true, true, true, ros_mqtt_path::PathSimplification::NONE, 0.0, 0, reduced_scan_reduction};
+    const ros_message_encoder::OutputOptions global_plan_output_options{MQTT_POSE_DECIMALS, false, false, false, false, MQTT_PATH_SIMPLIFICATION, MQTT_PATH_TOLERANCE, MQTT_GLOBAL_PLAN_MAX_POSES, no_scan_reduction};
+    const ros_message_encoder::OutputOptions local_plan_output_options{MQTT_POSE_DECIMALS, false, false, false, false, MQTT_PATH_SIMPLIFICATION, MQTT_PATH_TOLERANCE, MQTT_LOCAL_PLAN_MAX_POSES, no_scan_reduction};
+    mqtt_output_options_[mqtt_topics::to_rcs::robot_pose] = pose_output_options;
+    mqtt_output_options_[mqtt_topics::to_rcs::cmd_vel] = pose_output_options;
+    mqtt_output_options_[mqtt_topics::to_rcs::tf] = pose_output_options;
+    mqtt_output_options_[mqtt_topics::to_rcs::tf_static] = pose_output_options;
+    mqtt_output_options_[mqtt_topics::to_rcs::odom] = pose_output_options;
+    mqtt_output_options_[mqtt_topics::to_rcs::scan] = scan_output_options;
+    mqtt_output_options_[mqtt_topics::to_rcs::reduced_scan] = reduced_scan_output_options;
+    mqtt_output_options_[mqtt_topics::to_rcs::global_plan] = global_plan_output_options;
+    mqtt_output_options_[mqtt_topics::to_rcs::local_plan] = local_plan_output_options;
+
+    const ros_mqtt_scan::ScanReduction degraded_scan_reduction{MQTT_BACKPRESSURE_SCAN_BEAMS, false, 0.0f, 0.0f, 0.0f};
+    const ros_message_encoder::OutputOptions degraded_scan_output_options{MQTT_SCAN_DECIMALS, false, true, true, true, ros_mqtt_path::PathSimplification::NONE, 0.0, 0, degraded_scan_reduction};
+    const ros_message_encoder::OutputOptions degraded_plan_output_options{MQTT_POSE_DECIMALS, false, false, false, false, MQTT_PATH_SIMPLIFICATION, MQTT_PATH_TOLERANCE, MQTT_BACKPRESSURE_PLAN_MAX_POSES, no_scan_reduction};
+    mqtt_degraded_output_options_[mqtt_topics::to_rcs::scan] = degraded_scan_output_options;
+    mqtt_degraded_output_options_[mqtt_topics::to_rcs::global_plan] = degraded_plan_output_options;
+    mqtt_degraded_output_options_[mqtt_topics::to_rcs::local_plan] = degraded_plan_output_options;
+
+    const ros_message_encoder::Encoding encodings[] = {
+        ros_message_encoder::Encoding::JSON,
+        ros_message_encoder::Encoding::MSGPACK,
+        ros_message_encoder::Encoding::CBOR
+    };
+    for(const ros_message_encoder::Encoding encoding : encodings) {
+        mqtt_encoder_ptrs_[encoding] = ros_message_encoder::create_encoder(encoding);
+        mqtt_decoder_ptrs_[encoding] = ros_message_encoder::create_decoder(encoding);
+    }
+}
+
+/**
+ * @brief Function for get egress encoding of mqtt topic, JSON when topic is not configured
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @return ros_message_encoder::Encoding
+*/
+ros_message_encoder::Encoding ros_mqtt_connections::manager::Bridge::egress_encoding(const char * mqtt_topic) {
+    std::map<std::string, ros_message_encoder::Encoding, std::less<>>::const_iterator egress_encoding = mqtt_egress_encodings_.find(mqtt_topic);
+    if(egress_encoding == mqtt_egress_encodings_.end()) {
+        return ros_message_encoder::Encoding::JSON;
+    }
+    return egress_encoding->second;
+}
+
+/**
+ * @brief Function for get ingress encoding of mqtt topic, JSON when topic is not configured
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @return ros_message_encoder::Encoding
+*/
+ros_message_encoder::Encoding ros_mqtt_connections::manager::Bridge::ingress_encoding(const std::string& mqtt_topic) {
+    std::map<std::string, ros_message_encoder::Encoding>::const_iterator ingress_encoding = mqtt_ingress_encodings_.find(mqtt_topic);
+    if(ingress_encoding == mqtt_ingress_encodings_.end()) {
+        return ros_message_encoder::Encoding::JSON;
+    }
+    return ingress_encoding->second;
+}
+
+/**
+ * @brief Function for get cleared encoder of mqtt topic's egress encoding, set to mqtt topic's output options
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @return ros_message_encoder::MessageEncoder&
+ * @details encoders are shared between topics, which is safe since ros subscription callbacks run on the single threaded executor,
+ * topics without output options are written with default output options & topics with degraded output options use them while egress is degraded
+*/
+ros_message_encoder::MessageEncoder& ros_mqtt_connections::manager::Bridge::egress_encoder(const char * mqtt_topic) {
+    ros_message_encoder::MessageEncoder * mqtt_encoder = mqtt_encoder_ptrs_[egress_encoding(mqtt_topic)];
+    mqtt_encoder->clear();
+
+    std::map<std::string, ros_message_encoder::OutputOptions, std::less<>>::const_iterator output_options = mqtt_output_options_.find(mqtt_topic);
+    if(mqtt_egress_governor_ptr_ != nullptr && mqtt_egress_governor_ptr_->level() == ros_mqtt_backpressure::PressureLevel::DEGRADED) {
+        std::map<std::string, ros_message_encoder::OutputOptions, std::less<>>::const_iterator degraded_output_options = mqtt_degraded_output_options_.find(mqtt_topic);
+        if(degraded_output_options != mqtt_degraded_output_options_.end()) {
+            output_options = degraded_output_options;
+        }
+    }
+    if(output_options == mqtt_output_options_.end()) {
+        mqtt_encoder->set_output_options(ros_message_encoder::default_output_options());
+    } else {
+        mqtt_encoder->set_output_options(output_options->second);
+    }
+    return *mqtt_encoder;
+}
+
+/**
+ * @brief Function for decode binary encoded mqtt payload into Json::Value for ingress converters
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @param mqtt_payload const std::string&
+ * @return Json::Value null when payload could not be decoded, so converters fall back to their defaults
+*/
+Json::Value ros_mqtt_connections::manager::Bridge::decode_mqtt_payload(const std::string& mqtt_topic, const std::string& mqtt_payload) {
+    Json::Value decoded_json;
+    if(!mqtt_decoder_ptrs_[ingress_encoding(mqtt_topic)]->decode(mqtt_payload, decoded_json)) {
+        std::cerr << LOG_ROS_MQTT_CONNECTION_TO_ROS << " decode err on " << mqtt_topic << '\n';
+        this->record_conversion_error(mqtt_topic, true);
+        return Json::Value();
+    }
+    return decoded_json;
+}
+
+/**
+ * @brief Function for initialize per-topic metrics, queue depth gauges & their exporter
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_metrics::MetricsRegistry
+ * @see ros_mqtt_metrics::MetricsExporter
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_metrics() {
+    mqtt_metrics_registry_ptr_ = new ros_mqtt_metrics::MetricsRegistry();
+
+    const char * egress_topics[] = {
+        mqtt_topics::to_rcs::chatter,
+        mqtt_topics::to_rcs::robot_pose,
+        mqtt_topics::to_rcs::cmd_vel,
+        mqtt_topics::to_rcs::scan,
+        mqtt_topics::to_rcs::reduced_scan,
+        mqtt_topics::to_rcs::tf,
+        mqtt_topics::to_rcs::tf_static,
+        mqtt_topics::to_rcs::odom,
+        mqtt_topics::to_rcs::global_plan,
+        mqtt_topics::to_rcs::local_plan,
+        mqtt_topics::to_rcs::add_two_ints,
+        mqtt_topics::to_rcs::map_server_map,
+        mqtt_topics::to_rcs::batch,
+        mqtt_topics::to_rcs::snapshot
+    };
+    for(const char * egress_topic : egress_topics) {
+        mqtt_metrics_registry_ptr_->register_topic(egress_topic, "egress");
+    }
+
+    const char * ingress_topics[] = {
+        mqtt_topics::from_rcs::chatter,
+        mqtt_topics::from_rcs::cmd_vel,
+        mqtt_topics::from_rcs::initial_pose,
+        mqtt_topics::from_rcs::add_two_ints,
+        mqtt_topics::from_rcs::map_server_map,
+        mqtt_topics::from_rcs::snapshot
+    };
+    for(const char * ingress_topic : ingress_topics) {
+        mqtt_metrics_registry_ptr_->register_topic(ingress_topic, "ingress");
+    }
+
+    if(MQTT_ECHO_ENABLED) {
+        mqtt_metrics_registry_ptr_->register_topic(mqtt_topics::from_rcs::echo, "ingress");
+        mqtt_metrics_registry_ptr_->register_topic(mqtt_topics::to_rcs::echo, "egress");
+    }
+
+    if(mqtt_compression_worker_ptr_ != nullptr) {
+        mqtt_metrics_registry_ptr_->register_gauge("compression_queue_depth", [this]() {
+            return static_cast<double>(mqtt_compression_worker_ptr_->queue_size());
+        });
+    }
+    if(mqtt_batcher_ptr_ != nullptr) {
+        mqtt_metrics_registry_ptr_->register_gauge("batch_queue_depth", [this]() {
+            return static_cast<double>(mqtt_batcher_ptr_->size());
+        });
+    }
+    if(!shm_sink_ptrs_.empty()) {
+        mqtt_metrics_registry_ptr_->register_gauge("shm_oversized_drops", [this]() {
+            uint64_t oversized_drops = 0;
+            for(const std::pair<const std::string, ros_mqtt_shm::SharedMemoryRing *>& shm_sink : shm_sink_ptrs_) {
+                oversized_drops += shm_sink.second->oversized_drops();
+            }
+            return static_cast<double>(oversized_drops);
+        });
+    }
+    if(tf_aggregator_ptr_ != nullptr) {
+        mqtt_metrics_registry_ptr_->register_gauge("tf_rejected_transforms", [this]() {
+            return static_cast<double>(tf_aggregator_ptr_->rejected_count());
+        });
+    }
+    if(mqtt_cmd_vel_hold_ptr_ != nullptr) {
+        mqtt_metrics_registry_ptr_->register_gauge("cmd_vel_coalesced", [this]() {
+            return static_cast<double>(mqtt_cmd_vel_hold_ptr_->coalesced_count());
+        });
+        mqtt_metrics_registry_ptr_->register_gauge("cmd_vel_watchdog_timeouts", [this]() {
+            return static_cast<double>(mqtt_cmd_vel_hold_ptr_->timeout_count());
+        });
+    }
+    mqtt_metrics_registry_ptr_->register_gauge("mqtt_connected", [this]() {
+        return mqtt_connector_ptr_->state() == ros_mqtt_connector::ConnectionState::CONNECTED ? 1.0 : 0.0;
+    });
+    mqtt_metrics_registry_ptr_->register_gauge("offline_buffered", [this]() {
+        return static_cast<double>(mqtt_offline_buffer_ptr_->size());
+    });
+    mqtt_metrics_registry_ptr_->register_gauge("offline_dropped", [this]() {
+        return static_cast<double>(mqtt_offline_buffer_ptr_->dropped_count());
+    });
+    if(mqtt_egress_governor_ptr_ != nullptr) {
+        mqtt_metrics_registry_ptr_->register_gauge("egress_pressure_level", [this]() {
+            return static_cast<double>(mqtt_egress_governor_ptr_->level());
+        });
+        mqtt_metrics_registry_ptr_->register_gauge("egress_throttled", [this]() {
+            return static_cast<double>(mqtt_egress_governor_ptr_->throttled_count());
+        });
+        mqtt_metrics_registry_ptr_->register_gauge("egress_escalations", [this]() {
+            return static_cast<double>(mqtt_egress_governor_ptr_->escalation_count());
+        });
+    }
+    if(!mqtt_deadband_ptrs_.empty()) {
+        mqtt_metrics_registry_ptr_->register_gauge("deadband_suppressed", [this]() {
+            uint64_t suppressed_count = 0;
+            for(const std::pair<const std::string, ros_mqtt_deadband::DeadbandFilter *>& mqtt_deadband : mqtt_deadband_ptrs_) {
+                suppressed_count += mqtt_deadband.second->suppressed_count();
+            }
+            return static_cast<double>(suppressed_count);
+        });
+    }
+    mqtt_metrics_registry_ptr_->register_gauge("log_dropped_records", []() {
+        return static_cast<double>(ros_mqtt_logger::Logger::instance().dropped_records());
+    });
+
+    mqtt_metrics_exporter_ptr_ = new ros_mqtt_metrics::MetricsExporter(
+        ros_node_ptr_,
+        *mqtt_metrics_registry_ptr_,
+        METRICS_PREFIX,
+        METRICS_DIAGNOSTICS_TOPIC,
+        METRICS_PROMETHEUS_FILE,
+        std::chrono::milliseconds(METRICS_PUBLISH_PERIOD_MS)
+    );
+}
+
+/**
+ * @brief Function for find metrics of mqtt topic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param topic const std::string&
+ * @return ros_mqtt_metrics::TopicMetrics * nullptr when topic is not measured
+*/
+ros_mqtt_metrics::TopicMetrics * ros_mqtt_connections::manager::Bridge::topic_metrics(const std::string& topic) {
+    if(mqtt_metrics_registry_ptr_ == nullptr) {
+        return nullptr;
+    }
+    return mqtt_metrics_registry_ptr_->find(topic);
+}
+
+/**
+ * @brief Function for find metrics of egress mqtt topic without building std::string of it
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param topic const char *
+ * @return ros_mqtt_metrics::TopicMetrics * nullptr when topic is not measured
+ * @details egress lookups are keyed by const char * topics which may be longer than small string storage, so they must not allocate
+*/
+ros_mqtt_metrics::TopicMetrics * ros_mqtt_connections::manager::Bridge::topic_metrics(const char * topic) {
+    if(mqtt_metrics_registry_ptr_ == nullptr) {
+        return nullptr;
+    }
+    return mqtt_metrics_registry_ptr_->find(topic);
+}
+
+/**
+ * @brief Function for count egress message which was dropped before it reached the broker
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @return void
+ * @details a dropped plan leaves receivers without the base of next delta, so next plan of that topic is a keyframe
+*/
+void ros_mqtt_connections::manager::Bridge::record_dropped(const char * mqtt_topic) {
+    ros_mqtt_metrics::TopicMetrics * dropped_metrics = this->topic_metrics(mqtt_topic);
+    if(dropped_metrics != nullptr) {
+        dropped_metrics->drops.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::map<std::string, ros_mqtt_path::PathDelta *, std::less<>>::iterator mqtt_path_delta = mqtt_path_delta_ptrs_.find(mqtt_topic);
+    if(mqtt_path_delta != mqtt_path_delta_ptrs_.end()) {
+        mqtt_path_delta->second->request_keyframe();
+    }
+}
+
+/**
+ * @brief Function for mark ros message as converted & count it with its converted payload size
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param latency_trace ros_mqtt_metrics::LatencyTrace&
+ * @param mqtt_payload_size std::size_t
+ * @return void
+*/
+void ros_mqtt_connections::manager::Bridge::record_converted(const char * mqtt_topic, ros_mqtt_metrics::LatencyTrace& latency_trace, std::size_t mqtt_payload_size) {
+    latency_trace.converted = std::chrono::steady_clock::now();
+    ros_mqtt_metrics::TopicMetrics * converted_metrics = this->topic_metrics(mqtt_topic);
+    if(converted_metrics == nullptr) {
+        return;
+    }
+    converted_metrics->messages_in.fetch_add(1, std::memory_order_relaxed);
+    converted_metrics->bytes_in.fetch_add(mqtt_payload_size, std::memory_order_relaxed);
+    converted_metrics->latency(ros_mqtt_metrics::LatencyStage::RECEIVE_TO_CONVERTED).record(latency_trace.received, latency_trace.converted);
+}
+
+/**
+ * @brief Function for count conversion error of mqtt topic
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @param is_conversion_failed bool
+ * @return void
+*/
+void ros_mqtt_connections::manager::Bridge::record_conversion_error(const std::string& mqtt_topic, bool is_conversion_failed) {
+    if(!is_conversion_failed) {
+        return;
+    }
+    ros_mqtt_metrics::TopicMetrics * failed_metrics = this->topic_metrics(mqtt_topic);
+    if(failed_metrics != nullptr) {
+        failed_metrics->conversion_errors.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Function for count mqtt message which is published into ros
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const std::string&
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return void
+*/
+void ros_mqtt_connections::manager::Bridge::record_published(const std::string& mqtt_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    ros_mqtt_metrics::TopicMetrics * published_metrics = this->topic_metrics(mqtt_topic);
+    if(published_metrics == nullptr) {
+        return;
+    }
+    published_metrics->messages_out.fetch_add(1, std::memory_order_relaxed);
+    published_metrics->latency(ros_mqtt_metrics::LatencyStage::RECEIVE_TO_PUBLISHED).record(latency_trace.received, std::chrono::steady_clock::now());
+}
+
+/**
+ * @brief Function for initialize mqtt topics which carry trace block in their payloads
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details echo response is always traced when echo mode is enabled, since its trace block is the point of echo
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_tracing() {
+    if(MQTT_TRACE_ENABLED) {
+        const char * traced_topics[] = {
+            mqtt_topics::to_rcs::chatter,
+            mqtt_topics::to_rcs::robot_pose,
+            mqtt_topics::to_rcs::cmd_vel,
+            mqtt_topics::to_rcs::scan,
+            mqtt_topics::to_rcs::reduced_scan,
+            mqtt_topics::to_rcs::tf,
+            mqtt_topics::to_rcs::tf_static,
+            mqtt_topics::to_rcs::odom,
+            mqtt_topics::to_rcs::global_plan,
+            mqtt_topics::to_rcs::local_plan,
+            mqtt_topics::to_rcs::map_server_map
+        };
+        for(const char * traced_topic : traced_topics) {
+            mqtt_traced_topics_.insert(traced_topic);
+        }
+    }
+
+    if(MQTT_ECHO_ENABLED) {
+        mqtt_traced_topics_.insert(mqtt_topics::to_rcs::echo);
+    }
+}
+
+/**
+ * @brief Function for embed trace block with integer wall clock nanoseconds as last member of payload object
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param mqtt_payload std::string& encoded object of topic's egress encoding
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return bool true when trace block is embedded, false when topic is not traced, trace is unknown or already embedded, or payload is not an object
+ * @details runs on the executor thread like egress_encoder, so it borrows the encoder of payload's encoding.
+ * trace : { source_ns (only when message has header), receive_ns, converted_ns, publish_ns }
+*/
+bool ros_mqtt_connections::manager::Bridge::embed_trace(const char * mqtt_topic, std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    if(latency_trace.is_embedded
+        || latency_trace.received == std::chrono::steady_clock::time_point()
+        || mqtt_traced_topics_.find(mqtt_topic) == mqtt_traced_topics_.end()) {
+        return false;
+    }
+
+    const ros_message_encoder::Encoding trace_encoding = egress_encoding(mqtt_topic);
+    ros_message_encoder::MessageEncoder * trace_encoder = mqtt_encoder_ptrs_[trace_encoding];
+    const bool is_source_stamped = latency_trace.source_stamp_ns != 0;
+
+    trace_encoder->clear();
+    trace_encoder->begin_object(1);
+    trace_encoder->write_key("trace");
+    trace_encoder->begin_object(is_source_stamped ? 4 : 3);
+    if(is_source_stamped) {
+        trace_encoder->write_key("source_ns");
+        trace_encoder->write_int(latency_trace.source_stamp_ns);
+    }
+    trace_encoder->write_key("receive_ns");
+    trace_encoder->write_int(ros_mqtt_metrics::wall_nanoseconds(latency_trace.received));
+    trace_encoder->write_key("converted_ns");
+    trace_encoder->write_int(ros_mqtt_metrics::wall_nanoseconds(latency_trace.converted));
+    trace_encoder->write_key("publish_ns");
+    trace_encoder->write_int(ros_mqtt_metrics::wall_nanoseconds(std::chrono::steady_clock::now()));
+    trace_encoder->end_object();
+    trace_encoder->end_object();
+
+    const bool is_embedded = ros_message_encoder::merge_objects(trace_encoding, mqtt_payload, trace_encoder->buffer());
+    trace_encoder->clear();
+    return is_embedded;
+}
+
+/**
+ * @brief Function for create shared memory rings of egress topics when local sink is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_shm::SharedMemoryRing
+ * @details same-host readers map /dev/shm/ros_mqtt_bridge.<topic> instead of subscribing the broker.
+ * maps get few large slots, other topics SHM_SLOT_COUNT slots of SHM_SLOT_SIZE bytes
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_shm_sinks() {
+    if(!SHM_SINK_ENABLED) {
+        return;
+    }
+
+    const char * shared_topics[] = {
+        mqtt_topics::to_rcs::chatter,
+        mqtt_topics::to_rcs::robot_pose,
+        mqtt_topics::to_rcs::cmd_vel,
+        mqtt_topics::to_rcs::scan,
+        mqtt_topics::to_rcs::tf,
+        mqtt_topics::to_rcs::tf_static,
+        mqtt_topics::to_rcs::odom
+    };
+    for(const char * shared_topic : shared_topics) {
+        shm_sink_ptrs_[shared_topic] = new ros_mqtt_shm::SharedMemoryRing(ros_mqtt_shm::shm_name_of(SHM_SINK_PREFIX, shared_topic), SHM_SLOT_COUNT, SHM_SLOT_SIZE);
+    }
+    shm_sink_ptrs_[mqtt_topics::to_rcs::map_server_map] = new ros_mqtt_shm::SharedMemoryRing(ros_mqtt_shm::shm_name_of(SHM_SINK_PREFIX, mqtt_topics::to_rcs::map_server_map), SHM_MAP_SLOT_COUNT, SHM_MAP_SLOT_SIZE);
+
+    for(std::map<std::string, ros_mqtt_shm::SharedMemoryRing *, std::less<>>::iterator shm_sink = shm_sink_ptrs_.begin(); shm_sink != shm_sink_ptrs_.end();) {
+        if(!shm_sink->second->is_open()) {
+            std::cerr << LOG_ROS_MQTT_BRIDGE << " shared memory sink of " << shm_sink->first << " is not available" << '\n';
+            delete shm_sink->second;
+            shm_sink = shm_sink_ptrs_.erase(shm_sink);
+        } else {
+            ++shm_sink;
+        }
+    }
+}
+
+/**
+ * @brief Function for write final egress payload into shared memory ring of topic, once per message
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param mqtt_payload const std::string& uncompressed payload in the topic's encoding, with trace block when traced
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return bool written
+*/
+bool ros_mqtt_connections::manager::Bridge::share_local(const char * mqtt_topic, const std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    if(latency_trace.is_shared || shm_sink_ptrs_.empty()) {
+        return false;
+    }
+    std::map<std::string, ros_mqtt_shm::SharedMemoryRing *, std::less<>>::iterator shm_sink = shm_sink_ptrs_.find(mqtt_topic);
+    if(shm_sink == shm_sink_ptrs_.end()) {
+        return false;
+    }
+    return shm_sink->second->write(
+        mqtt_payload,
+        static_cast<uint8_t>(egress_encoding(mqtt_topic)),
+        ros_mqtt_metrics::wall_nanoseconds(std::chrono::steady_clock::now())
+    );
+}
+
+/**
+ * @brief Function for initialize latched topics which are published retained & last-value cache of dashboard topics
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_cache::LastValueCache
+ * @details retained topics are handed by the broker to clients which connect later, cached topics are sent at once on /snapshot/request
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_last_value_cache() {
+    if(MQTT_RETAINED_ENABLED) {
+        mqtt_retained_topics_.insert(mqtt_topics::to_rcs::tf_static);
+        mqtt_retained_topics_.insert(mqtt_topics::to_rcs::map_server_map);
+    }
+
+    if(!MQTT_LAST_VALUE_CACHE_ENABLED) {
+        return;
+    }
+
+    mqtt_cached_topics_.insert(mqtt_topics::to_rcs::robot_pose);
+    mqtt_cached_topics_.insert(mqtt_topics::to_rcs::scan);
+    mqtt_cached_topics_.insert(mqtt_topics::to_rcs::tf_static);
+    mqtt_cached_topics_.insert(mqtt_topics::to_rcs::odom);
+    mqtt_cached_topics_.insert(mqtt_topics::to_rcs::map_server_map);
+    mqtt_last_value_cache_ptr_ = new ros_mqtt_cache::LastValueCache();
+}
+
+/**
+ * @brief Function for store payload of cached mqtt topic into last-value cache
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param mqtt_payload const std::string&
+ * @return void
+ * @details snapshot envelope splices JSON payloads like batch envelope does, so topics with binary encoding are not cached
+*/
+void ros_mqtt_connections::manager::Bridge::cache_last_value(const char * mqtt_topic, const std::string& mqtt_payload) {
+    if(mqtt_last_value_cache_ptr_ == nullptr
+        || mqtt_cached_topics_.find(mqtt_topic) == mqtt_cached_topics_.end()
+        || egress_encoding(mqtt_topic) != ros_message_encoder::Encoding::JSON) {
+        return;
+    }
+    mqtt_last_value_cache_ptr_->store(mqtt_topic, mqtt_payload);
+}
+
+/**
+ * @brief Function for answer snapshot request with last payload of every cached topic in one envelope
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return void
+ * @details runs on the transport callback thread, the envelope goes through compression like the batch envelope
+*/
+void ros_mqtt_connections::manager::Bridge::bridge_snapshot(const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    std::string snapshot_envelope = mqtt_last_value_cache_ptr_->snapshot();
+    ROS_MQTT_LOG_INFO("%s snapshot of %zu cached topics requested (%zu bytes)", LOG_ROS_MQTT_CONNECTION_TO_MQTT, mqtt_last_value_cache_ptr_->size(), snapshot_envelope.size());
+    this->mqtt_publish_compressed(mqtt_topics::to_rcs::snapshot, std::move(snapshot_envelope));
+    this->record_published(mqtt_topics::from_rcs::snapshot, latency_trace);
+}
+
+/**
+ * @brief Function for initialize tf tree aggregation & its publish timer when aggregation is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_tf::FramePairAggregator
+ * @details /tf is then kept in tf buffer instead of being forwarded, only composed frame pairs are published on /tf every TF_AGGREGATION_PERIOD_MS.
+ * /tf_static is added into tf buffer & still forwarded, it is retained for clients which connect later
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_tf_aggregation() {
+    if(!TF_AGGREGATION_ENABLED) {
+        return;
+    }
+
+    const std::vector<ros_mqtt_tf::FramePair> tf_frame_pairs = {
+        {TF_MAP_FRAME, TF_BASE_FRAME},
+        {TF_ODOM_FRAME, TF_BASE_FRAME}
+    };
+    tf_aggregator_ptr_ = new ros_mqtt_tf::FramePairAggregator(tf_frame_pairs, std::chrono::seconds(TF_AGGREGATION_CACHE_SECONDS));
+    tf_composed_message_.transforms.reserve(tf_frame_pairs.size());
+
+    try {
+        tf_aggregation_timer_ptr_ = ros_node_ptr_->create_wall_timer(
+            std::chrono::milliseconds(TF_AGGREGATION_PERIOD_MS),
+            [this]() {
+                this->publish_composed_tf();
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[ROS to MQTT] tf aggregation timer err : " << rcl_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Function for mqtt publish composed transforms of frame pairs on /tf when any of them moved since last publish
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details runs on the executor thread like tf callbacks, so it shares their egress encoder.
+ * every composed pair is written each time, so a message always holds the full set
+*/
+void ros_mqtt_connections::manager::Bridge::publish_composed_tf() {
+    const std::size_t updated_count = tf_aggregator_ptr_->lookup_transforms(tf_composed_message_);
+    if(updated_count == 0) {
+        return;
+    }
+
+    ros_mqtt_metrics::LatencyTrace tf_trace = ros_mqtt_metrics::start_trace();
+    const builtin_interfaces::msg::Time& composed_stamp = tf_composed_message_.transforms.front().header.stamp;
+    tf_trace.source_stamp_ns = ros_mqtt_metrics::stamp_nanoseconds(composed_stamp.sec, composed_stamp.nanosec);
+    ros_message_encoder::MessageEncoder& tf_encoder = egress_encoder(mqtt_topics::to_rcs::tf);
+    tf2_msgs_converter_ptr_->convert_transforms(tf_composed_message_, tf_encoder);
+    this->record_converted(mqtt_topics::to_rcs::tf, tf_trace, tf_encoder.buffer().size());
+    mqtt_publish_batched(mqtt_topics::to_rcs::tf, ros_message_types::tf, tf_encoder.release(), tf_trace);
+}
+
+/**
+ * @brief Function for initialize per-topic delta state of plans when path delta mode is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_path::PathDelta
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_path_deltas() {
+    if(!MQTT_PATH_DELTA_ENABLED) {
+        return;
+    }
+
+    const char * delta_topics[] = {
+        mqtt_topics::to_rcs::global_plan,
+        mqtt_topics::to_rcs::local_plan
+    };
+    for(const char * delta_topic : delta_topics) {
+        mqtt_path_delta_ptrs_[delta_topic] = new ros_mqtt_path::PathDelta(MQTT_PATH_KEYFRAME_INTERVAL, PATH_POSE_STRIDE);
+    }
+}
+
+/**
+ * @brief Function for make next plan of every topic with delta state a keyframe
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details map is not changed after initialization, so any thread may call this
+*/
+void ros_mqtt_connections::manager::Bridge::request_path_keyframes() {
+    for(std::pair<const std::string, ros_mqtt_path::PathDelta *>& mqtt_path_delta : mqtt_path_delta_ptrs_) {
+        mqtt_path_delta.second->request_keyframe();
+    }
+}
+
+/**
+ * @brief Function for convert plan as keyframe or delta when its topic has delta state, otherwise as full path
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param path_msgs const nav_msgs::msg::Path&
+ * @param message_encoder ros_message_encoder::MessageEncoder& egress encoder of mqtt_topic
+ * @return void
+*/
+void ros_mqtt_connections::manager::Bridge::convert_plan(const char * mqtt_topic, const nav_msgs::msg::Path& path_msgs, ros_message_encoder::MessageEncoder& message_encoder) {
+    std::map<std::string, ros_mqtt_path::PathDelta *, std::less<>>::iterator mqtt_path_delta = mqtt_path_delta_ptrs_.find(mqtt_topic);
+    if(mqtt_path_delta == mqtt_path_delta_ptrs_.end()) {
+        nav_msgs_converter_ptr_->convert_path(path_msgs, message_encoder);
+    } else {
+        nav_msgs_converter_ptr_->convert_path_delta(path_msgs, *mqtt_path_delta->second, message_encoder);
+    }
+}
+
+/**
+ * @brief Function for initialize per-topic deadband filters of pose-like topics when deadband is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_deadband::DeadbandFilter
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_deadbands() {
+    if(!MQTT_DEADBAND_ENABLED) {
+        return;
+    }
+
+    const ros_mqtt_deadband::DeadbandThresholds deadband_thresholds{
+        MQTT_DEADBAND_TRANSLATION,
+        MQTT_DEADBAND_ROTATION,
+        MQTT_DEADBAND_VELOCITY,
+        std::chrono::milliseconds(MQTT_DEADBAND_HEARTBEAT_MS)
+    };
+    const char * deadband_topics[] = {
+        mqtt_topics::to_rcs::robot_pose,
+        mqtt_topics::to_rcs::odom,
+        mqtt_topics::to_rcs::cmd_vel
+    };
+    for(const char * deadband_topic : deadband_topics) {
+        mqtt_deadband_ptrs_[deadband_topic] = new ros_mqtt_deadband::DeadbandFilter(deadband_thresholds);
+    }
+}
+
+/**
+ * @brief Function for check whether message of topic passes its deadband filter
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param motion_sample const ros_mqtt_deadband::MotionSample&
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace& received time of message is the time deadband compares with heartbeat
+ * @return bool true when topic has no deadband filter
+ * @details called before conversion, so a suppressed message costs neither conversion nor publish
+*/
+bool ros_mqtt_connections::manager::Bridge::is_deadband_passed(const char * mqtt_topic, const ros_mqtt_deadband::MotionSample& motion_sample, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    std::map<std::string, ros_mqtt_deadband::DeadbandFilter *, std::less<>>::iterator mqtt_deadband = mqtt_deadband_ptrs_.find(mqtt_topic);
+    if(mqtt_deadband == mqtt_deadband_ptrs_.end()) {
+        return true;
+    }
+    return mqtt_deadband->second->is_passed(motion_sample, latency_trace.received);
+}
+
+/**
+ * @brief Function for initialize per-topic deadlines of topics whose old messages are worse than none
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_metrics::Deadline
+ * @details with RECEIVED, deadlines only drop messages which waited in batch, compression queue, offline buffer or cmd_vel hold,
+ * since a receive time taken in the same callback is never old. egress cmd_vel has no header, so its deadline applies after queueing only.
+ * with SOURCE_STAMP egress ages from header stamps & ingress cmd_vel from sent_ns of the sender, which needs synced clocks
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_deadlines() {
+    if(!MQTT_DEADLINE_ENABLED) {
+        return;
+    }
+
+    mqtt_deadlines_[mqtt_topics::to_rcs::scan] = ros_mqtt_metrics::Deadline{std::chrono::milliseconds(MQTT_SCAN_MAX_AGE_MS), MQTT_DEADLINE_SOURCE};
+    mqtt_deadlines_[mqtt_topics::to_rcs::reduced_scan] = ros_mqtt_metrics::Deadline{std::chrono::milliseconds(MQTT_SCAN_MAX_AGE_MS), MQTT_DEADLINE_SOURCE};
+    mqtt_deadlines_[mqtt_topics::to_rcs::odom] = ros_mqtt_metrics::Deadline{std::chrono::milliseconds(MQTT_ODOM_MAX_AGE_MS), MQTT_DEADLINE_SOURCE};
+    mqtt_deadlines_[mqtt_topics::to_rcs::cmd_vel] = ros_mqtt_metrics::Deadline{std::chrono::milliseconds(MQTT_CMD_VEL_MAX_AGE_MS), MQTT_DEADLINE_SOURCE};
+    mqtt_deadlines_[mqtt_topics::from_rcs::cmd_vel] = ros_mqtt_metrics::Deadline{std::chrono::milliseconds(MQTT_CMD_VEL_MAX_AGE_MS), MQTT_DEADLINE_SOURCE};
+}
+
+/**
+ * @brief Function for check whether message is past deadline of its topic & count it as stale drop
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return bool false when topic has no deadline
+ * @details checked before conversion in ros callbacks & again before publish, so time spent in batch & compression queues counts too
+*/
+bool ros_mqtt_connections::manager::Bridge::is_stale(const char * mqtt_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    std::map<std::string, ros_mqtt_metrics::Deadline, std::less<>>::const_iterator mqtt_deadline = mqtt_deadlines_.find(mqtt_topic);
+    if(mqtt_deadline == mqtt_deadlines_.end() || !ros_mqtt_metrics::is_expired(latency_trace, mqtt_deadline->second, std::chrono::steady_clock::now())) {
+        return false;
+    }
+
+    ros_mqtt_metrics::TopicMetrics * stale_metrics = this->topic_metrics(mqtt_topic);
+    if(stale_metrics != nullptr) {
+        stale_metrics->stale_drops.fetch_add(1, std::memory_order_relaxed);
+    }
+    ROS_MQTT_LOG_DEBUG("%s dropped stale message of '%s'", LOG_ROS_MQTT_BRIDGE, mqtt_topic);
+    return true;
+}
+
+/**
+ * @brief Function for initialize latest-wins hold of ingress cmd_vel & its fixed-rate publish timer when latest-wins mode is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_command::CommandHold
+ * @details watchdog is capped by the deadline of ingress cmd_vel, so a held command is never republished after it went stale
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_cmd_vel_hold() {
+    if(!MQTT_CMD_VEL_LATEST_WINS) {
+        return;
+    }
+
+    std::chrono::milliseconds cmd_vel_watchdog(MQTT_CMD_VEL_WATCHDOG_MS);
+    std::map<std::string, ros_mqtt_metrics::Deadline, std::less<>>::const_iterator cmd_vel_deadline = mqtt_deadlines_.find(mqtt_topics::from_rcs::cmd_vel);
+    if(cmd_vel_deadline != mqtt_deadlines_.end() && cmd_vel_deadline->second.max_age.count() > 0) {
+        cmd_vel_watchdog = std::min(cmd_vel_watchdog, cmd_vel_deadline->second.max_age);
+    }
+    mqtt_cmd_vel_hold_ptr_ = new ros_mqtt_command::CommandHold(cmd_vel_watchdog);
+
+    try {
+        cmd_vel_hold_timer_ptr_ = ros_node_ptr_->create_wall_timer(
+            std::chrono::milliseconds(MQTT_CMD_VEL_PERIOD_MS),
+            [this]() {
+                this->publish_held_cmd_vel();
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[MQTT to ROS] cmd_vel hold timer err : " << rcl_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Function for publish held cmd_vel into ros once per tick, or zero velocity once when watchdog expired
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details latency of a command is recorded on its first tick only, republishes of it are not messages of their own
+*/
+void ros_mqtt_connections::manager::Bridge::publish_held_cmd_vel() {
+    ros_mqtt_command::HeldCommand held_command;
+    if(ros_cmd_vel_publisher_ptr_ == nullptr || !mqtt_cmd_vel_hold_ptr_->tick(std::chrono::steady_clock::now(), held_command)) {
+        return;
+    }
+
+    try {
+        ros_cmd_vel_publisher_ptr_->publish(held_command.twist);
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[MQTT to ROS] publish held cmd_vel error : " << rcl_expn.what() << '\n';
+        return;
+    }
+    if(held_command.is_timed_out) {
+        ROS_MQTT_LOG_WARN("%s no /cmd_vel within watchdog, published zero velocity", LOG_ROS_MQTT_CONNECTION_TO_ROS);
+    } else if(held_command.is_fresh) {
+        this->record_published(mqtt_topics::from_rcs::cmd_vel, held_command.latency_trace);
+    }
+}
+
+/**
+ * @brief Function for initialize egress governor & its regulation timer when backpressure is enabled
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see ros_mqtt_backpressure::EgressGovernor
+*/
+void ros_mqtt_connections::manager::Bridge::initialize_backpressure() {
+    if(!MQTT_BACKPRESSURE_ENABLED) {
+        return;
+    }
+
+    const ros_mqtt_backpressure::BackpressureOptions backpressure_options{
+        MQTT_BACKPRESSURE_QUEUE_HIGH,
+        MQTT_BACKPRESSURE_QUEUE_LOW,
+        std::chrono::milliseconds(MQTT_BACKPRESSURE_LATENCY_TARGET_MS),
+        std::chrono::milliseconds(MQTT_BACKPRESSURE_SETTLE_MS),
+        std::chrono::milliseconds(MQTT_BACKPRESSURE_RECOVER_HOLD_MS),
+        std::chrono::milliseconds(MQTT_BACKPRESSURE_THROTTLED_INTERVAL_MS),
+        std::chrono::milliseconds(MQTT_BACKPRESSURE_DEGRADED_INTERVAL_MS)
+    };
+    mqtt_egress_governor_ptr_ = new ros_mqtt_backpressure::EgressGovernor(backpressure_options);
+
+    try {
+        backpressure_timer_ptr_ = ros_node_ptr_->create_wall_timer(
+            std::chrono::milliseconds(MQTT_BACKPRESSURE_PERIOD_MS),
+            [this]() {
+                this->regulate_egress();
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[ROS to MQTT] backpressure timer err : " << rcl_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Function for update pressure level of egress from pending delivery tokens, compression queue & worst latency since last period
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details batch queue is left out, it holds messages until its own flush on purpose.
+ * transport publish waits for its delivery token, so pending tokens never exceed the publishing threads & queue depth only builds up in the compression queue, without compression latency alone escalates
+*/
+void ros_mqtt_connections::manager::Bridge::regulate_egress() {
+    std::size_t queue_depth = mqtt_transport_ptr_->pending_count();
+    if(mqtt_compression_worker_ptr_ != nullptr) {
+        queue_depth += mqtt_compression_worker_ptr_->queue_size();
+    }
+
+    const ros_mqtt_backpressure::PressureLevel last_level = mqtt_egress_governor_ptr_->level();
+    const ros_mqtt_backpressure::PressureLevel pressure_level = mqtt_egress_governor_ptr_->update(queue_depth, std::chrono::steady_clock::now());
+    if(pressure_level != last_level) {
+        ROS_MQTT_LOG_WARN("%s egress %s -> %s with queue depth %zu", LOG_ROS_MQTT_CONNECTION_TO_MQTT, ros_mqtt_backpressure::level_name(last_level), ros_mqtt_backpressure::level_name(pressure_level), queue_depth);
+    }
+}
+
+/**
+ * @brief Function for check whether message of bulk topic is published at the rate of current pressure level
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_topic const char *
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return bool true when backpressure is disabled
+ * @details called before conversion, so a throttled message costs neither conversion nor publish & plan deltas stay relative to what was published
+*/
+bool ros_mqtt_connections::manager::Bridge::is_egress_admitted(const char * mqtt_topic, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    if(mqtt_egress_governor_ptr_ == nullptr) {
+        return true;
+    }
+    return mqtt_egress_governor_ptr_->is_admitted(mqtt_topic, latency_trace.received);
+}
+
+/**
+ * @brief Function for publish echo request into ros with ingress timestamps, the echo subscription sends it back to mqtt
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_payload std::string& JSON object of echo request, its members are kept as they are
+ * @param latency_trace const ros_mqtt_metrics::LatencyTrace&
+ * @return void
+ * @details runs on the paho callback thread, so it uses its own encoder.
+ * ingress : { receive_ns, publish_ns } is appended, the echo response then gets trace block of the way back
+*/
+void ros_mqtt_connections::manager::Bridge::bridge_echo(std::string& mqtt_payload, const ros_mqtt_metrics::LatencyTrace& latency_trace) {
+    const std::string mqtt_topic = mqtt_topics::from_rcs::echo;
+    mqtt_payload.erase(mqtt_payload.find_last_not_of(" \t\r\n") + 1);
+
+    ros_message_encoder::JsonEncoder ingress_encoder;
+    ingress_encoder.begin_object(1);
+    ingress_encoder.write_key("ingress");
+    ingress_encoder.begin_object(2);
+    ingress_encoder.write_key("receive_ns");
+    ingress_encoder.write_int(ros_mqtt_metrics::wall_nanoseconds(latency_trace.received));
+    ingress_encoder.write_key("publish_ns");
+    ingress_encoder.write_int(ros_mqtt_metrics::wall_nanoseconds(std::chrono::steady_clock::now()));
+    ingress_encoder.end_object();
+    ingress_encoder.end_object();
+
+    std_msgs::msg::String echo_message = std_msgs::msg::String();
+    echo_message.data.swap(mqtt_payload);
+    if(!ros_message_encoder::merge_objects(ros_message_encoder::Encoding::JSON, echo_message.data, ingress_encoder.buffer())) {
+        std::cerr << LOG_ROS_MQTT_CONNECTION_TO_ROS << " dropped echo request which is not a JSON object" << '\n';
+        this->record_conversion_error(mqtt_topic, true);
+        return;
+    }
+
+    try {
+        ros_echo_publisher_ptr_->publish(echo_message);
+        this->record_published(mqtt_topic, latency_trace);
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << "[MQTT to ROS] publish echo error : " << rcl_expn.what() << '\n';
+    }
+}
+
 /**
  * @brief Constructor for initialize this class instance & create rclcpp::Node named with ros_mqtt_bridge
  * @author reidlo(naru5135@wavem.net)
@@ -551,12 +2064,14 @@ void check_rclcpp_status() {
  * @see rclcpp
  * @see RosMqttBridge
  * @see check_rclcpp_status()
+ * @details node is released before rclcpp::shutdown, so bridge drains egress & disconnects mqtt while node still exists
 */
 int main(int argc, char** argv) {
     rclcpp::init(argc, argv);
     check_rclcpp_status();
     auto node = std::make_shared<RosMqttBridge>();
     rclcpp::spin(node);
+    node.reset();
     rclcpp::shutdown();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,571 @@
+// Copyright [2023] [wavem-reidlo]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+#include "ros_mqtt_load_generator/ros_mqtt_load_generator.hpp"
+
+/**
+ * @brief Constructor for initialize counters of one measured path
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_origin const std::string&
+ * @param path_destination const std::string&
+ * @param path_rate_hz double
+*/
+ros_mqtt_load::LoadPath::LoadPath(const std::string& path_origin, const std::string& path_destination, double path_rate_hz)
+: origin(path_origin),
+destination(path_destination),
+rate_hz(path_rate_hz),
+sent(0),
+received(0) {
+
+}
+
+/**
+ * @brief Function for get wall clock nanoseconds since epoch, the clock ros header stamps & bridge trace blocks use
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return int64_t
+*/
+int64_t ros_mqtt_load::wall_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Function for read exact header stamp from sec & nanosec of converted header
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param header_json const Json::Value&
+ * @return int64_t 0 when header has no stamp
+*/
+int64_t ros_mqtt_load::header_stamp_ns(const Json::Value& header_json) {
+    if(!header_json.isObject() || !header_json.isMember("sec")) {
+        return 0;
+    }
+    return ros_mqtt_metrics::stamp_nanoseconds(header_json["sec"].asInt(), header_json.get("nanosec", 0).asUInt());
+}
+
+/**
+ * @brief Constructor for initialize this class instance, read parameters & start publishing load
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @see rclcpp::Node
+ * @see mqtt::async_client
+*/
+ros_mqtt_load::LoadGenerator::LoadGenerator()
+: Node("ros_mqtt_load_generator"),
+mqtt_async_client_(this->declare_parameter<std::string>("mqtt_address", LOAD_MQTT_ADDRESS), LOAD_MQTT_CLIENT_ID),
+mqtt_decoder_ptr_(ros_message_encoder::create_decoder(static_cast<ros_message_encoder::Encoding>(this->declare_parameter<int64_t>("mqtt_encoding", 0)))),
+window_start_ns_(0),
+window_end_ns_(0),
+undecodable_payloads_(0),
+report_file_(this->declare_parameter<std::string>("report_file", LOAD_REPORT_FILE)),
+mqtt_qos_(static_cast<int>(this->declare_parameter<int64_t>("mqtt_qos", LOAD_MQTT_QOS))),
+is_finished_(false) {
+    const double scan_rate_hz = this->declare_parameter<double>("scan_rate_hz", LOAD_SCAN_RATE_HZ);
+    const double tf_rate_hz = this->declare_parameter<double>("tf_rate_hz", LOAD_TF_RATE_HZ);
+    const double odom_rate_hz = this->declare_parameter<double>("odom_rate_hz", LOAD_ODOM_RATE_HZ);
+    const double echo_rate_hz = this->declare_parameter<double>("echo_rate_hz", LOAD_ECHO_RATE_HZ);
+    const int64_t scan_beams = this->declare_parameter<int64_t>("scan_beams", LOAD_SCAN_BEAMS);
+    const int64_t tf_transforms = this->declare_parameter<int64_t>("tf_transforms", LOAD_TF_TRANSFORMS);
+
+    this->initialize_messages(scan_beams, tf_transforms);
+    this->initialize_paths(scan_rate_hz, tf_rate_hz, odom_rate_hz, echo_rate_hz);
+    this->mqtt_connect();
+    this->start_load(scan_rate_hz, tf_rate_hz, odom_rate_hz, echo_rate_hz);
+}
+
+/**
+ * @brief Virtual Destructor for this class & delete paths & decoder
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+*/
+ros_mqtt_load::LoadGenerator::~LoadGenerator() {
+    try {
+        if(mqtt_async_client_.is_connected()) {
+            mqtt_async_client_.disconnect()->wait();
+        }
+    } catch(const mqtt::exception& mqtt_expn) {
+        std::cerr << LOG_ROS_MQTT_LOAD_GENERATOR << " disconnect err : " << mqtt_expn.what() << '\n';
+    }
+    for(std::pair<const std::string, LoadPath *>& load_path : load_paths_) {
+        delete load_path.second;
+    }
+    delete mqtt_decoder_ptr_;
+}
+
+/**
+ * @brief Function for fill synthetic messages once, only their stamps change per publish
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param scan_beams int64_t
+ * @param tf_transforms int64_t
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::initialize_messages(int64_t scan_beams, int64_t tf_transforms) {
+    scan_message_.header.frame_id = "base_scan";
+    scan_message_.angle_min = -3.14159f;
+    scan_message_.angle_max = 3.14159f;
+    scan_message_.angle_increment = scan_beams > 0 ? 6.28318f / scan_beams : 0.0f;
+    scan_message_.scan_time = 0.1f;
+    scan_message_.range_min = 0.12f;
+    scan_message_.range_max = 30.0f;
+    scan_message_.ranges.resize(static_cast<std::size_t>(std::max<int64_t>(scan_beams, 0)));
+    scan_message_.intensities.resize(scan_message_.ranges.size());
+    for(std::size_t i = 0; i < scan_message_.ranges.size(); i++) {
+        scan_message_.ranges[i] = 0.5f + (i % 997) * 0.0293f;
+        scan_message_.intensities[i] = static_cast<float>(i % 255);
+    }
+
+    tf_message_.transforms.resize(static_cast<std::size_t>(std::max<int64_t>(tf_transforms, 1)));
+    for(std::size_t i = 0; i < tf_message_.transforms.size(); i++) {
+        geometry_msgs::msg::TransformStamped& transform_stamped = tf_message_.transforms[i];
+        transform_stamped.header.frame_id = "odom";
+        transform_stamped.child_frame_id = "link_" + std::to_string(i);
+        transform_stamped.transform.translation.x = 0.1 * i;
+        transform_stamped.transform.rotation.w = 1.0;
+    }
+
+    odom_message_.header.frame_id = "odom";
+    odom_message_.child_frame_id = "base_footprint";
+    odom_message_.pose.pose.position.x = 1.25;
+    odom_message_.pose.pose.orientation.w = 1.0;
+    odom_message_.twist.twist.linear.x = 0.35;
+}
+
+/**
+ * @brief Function for initialize measured paths & mqtt topics they arrive on, paths with rate 0 are not measured
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param scan_rate_hz double
+ * @param tf_rate_hz double
+ * @param odom_rate_hz double
+ * @param echo_rate_hz double
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::initialize_paths(double scan_rate_hz, double tf_rate_hz, double odom_rate_hz, double echo_rate_hz) {
+    if(scan_rate_hz > 0.0) {
+        load_paths_["scan"] = new LoadPath(std::string("ros ") + load_topics::ros::scan, std::string("mqtt ") + load_topics::broker::scan, scan_rate_hz);
+        mqtt_topic_paths_[load_topics::broker::scan] = "scan";
+    }
+    if(tf_rate_hz > 0.0) {
+        load_paths_["tf"] = new LoadPath(std::string("ros ") + load_topics::ros::tf, std::string("mqtt ") + load_topics::broker::tf, tf_rate_hz);
+        mqtt_topic_paths_[load_topics::broker::tf] = "tf";
+    }
+    if(odom_rate_hz > 0.0) {
+        load_paths_["odom"] = new LoadPath(std::string("ros ") + load_topics::ros::odom, std::string("mqtt ") + load_topics::broker::odom, odom_rate_hz);
+        mqtt_topic_paths_[load_topics::broker::odom] = "odom";
+    }
+    if(echo_rate_hz > 0.0) {
+        load_paths_["echo_ingress"] = new LoadPath(std::string("mqtt ") + load_topics::broker::echo_request, std::string("ros ") + load_topics::ros::echo, echo_rate_hz);
+        load_paths_["echo_round_trip"] = new LoadPath(std::string("mqtt ") + load_topics::broker::echo_request, std::string("mqtt ") + load_topics::broker::echo_response, echo_rate_hz);
+        mqtt_topic_paths_[load_topics::broker::echo_response] = "echo_round_trip";
+    }
+}
+
+/**
+ * @brief Function for connect to mqtt broker & subscribe destinations of paths, batch envelope is subscribed too
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @see mqtt::async_client
+*/
+void ros_mqtt_load::LoadGenerator::mqtt_connect() {
+    try {
+        mqtt::connect_options mqtt_connect_opts;
+        mqtt_connect_opts.set_clean_session(true);
+        mqtt_async_client_.set_callback(*this);
+        mqtt_async_client_.connect(mqtt_connect_opts)->wait_for(std::chrono::seconds(10));
+        for(const std::pair<const std::string, std::string>& mqtt_topic_path : mqtt_topic_paths_) {
+            mqtt_async_client_.subscribe(mqtt_topic_path.first, mqtt_qos_);
+        }
+        mqtt_async_client_.subscribe(load_topics::broker::batch, mqtt_qos_);
+    } catch(const mqtt::exception& mqtt_expn) {
+        std::cerr << LOG_ROS_MQTT_LOAD_GENERATOR << " connection error : " << mqtt_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Function for create publishers, echo subscription & load timers, then schedule finish after warmup, duration & drain
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param scan_rate_hz double
+ * @param tf_rate_hz double
+ * @param odom_rate_hz double
+ * @param echo_rate_hz double
+ * @return void
+ * @details load runs during warmup too so discovery settles, only messages sent inside of the window are counted
+*/
+void ros_mqtt_load::LoadGenerator::start_load(double scan_rate_hz, double tf_rate_hz, double odom_rate_hz, double echo_rate_hz) {
+    const int64_t warmup_sec = this->declare_parameter<int64_t>("warmup_sec", LOAD_WARMUP_SEC);
+    const int64_t duration_sec = this->declare_parameter<int64_t>("duration_sec", LOAD_DURATION_SEC);
+    const int64_t drain_ms = this->declare_parameter<int64_t>("drain_ms", LOAD_DRAIN_MS);
+
+    try {
+        ros_scan_publisher_ptr_ = this->create_publisher<sensor_msgs::msg::LaserScan>(load_topics::ros::scan, rclcpp::QoS(rclcpp::KeepLast(10)));
+        ros_tf_publisher_ptr_ = this->create_publisher<tf2_msgs::msg::TFMessage>(load_topics::ros::tf, rclcpp::QoS(rclcpp::KeepLast(10)));
+        ros_odom_publisher_ptr_ = this->create_publisher<nav_msgs::msg::Odometry>(load_topics::ros::odom, rclcpp::QoS(rclcpp::KeepLast(10)));
+        ros_echo_subscription_ptr_ = this->create_subscription<std_msgs::msg::String>(
+            load_topics::ros::echo,
+            rclcpp::QoS(rclcpp::KeepLast(10)),
+            [this](const std_msgs::msg::String::SharedPtr callback_echo_data) {
+                const int64_t received_ns = wall_now_ns();
+                Json::Value echo_json;
+                ros_message_encoder::JsonDecoder echo_decoder;
+                if(callback_echo_data == nullptr || !echo_decoder.decode(callback_echo_data->data, echo_json)) {
+                    undecodable_payloads_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                this->count_received("echo_ingress", echo_json.get("sent_ns", 0).asInt64(), received_ns);
+            }
+        );
+    } catch(const rclcpp::exceptions::RCLError& rcl_expn) {
+        std::cerr << LOG_ROS_MQTT_LOAD_GENERATOR << " ros bridge err : " << rcl_expn.what() << '\n';
+    }
+
+    window_start_ns_.store(wall_now_ns() + warmup_sec * 1000000000LL);
+    window_end_ns_.store(window_start_ns_.load() + duration_sec * 1000000000LL);
+
+    this->add_load_timer(scan_rate_hz, [this]() { this->publish_scan(); });
+    this->add_load_timer(tf_rate_hz, [this]() { this->publish_tf(); });
+    this->add_load_timer(odom_rate_hz, [this]() { this->publish_odom(); });
+    this->add_load_timer(echo_rate_hz, [this]() { this->publish_echo_request(); });
+
+    finish_timer_ptr_ = this->create_wall_timer(
+        std::chrono::seconds(warmup_sec + duration_sec) + std::chrono::milliseconds(drain_ms),
+        [this]() { this->finish(); }
+    );
+
+    std::cout << LOG_ROS_MQTT_LOAD_GENERATOR << " load started, measuring " << duration_sec << "s after " << warmup_sec << "s warmup" << '\n';
+}
+
+/**
+ * @brief Function for create wall timer which publishes one message of path per period
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param rate_hz double no timer when rate is not positive
+ * @param load_function std::function<void()>
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::add_load_timer(double rate_hz, std::function<void()> load_function) {
+    if(rate_hz <= 0.0) {
+        return;
+    }
+    const std::chrono::nanoseconds load_period(static_cast<int64_t>(1e9 / rate_hz));
+    load_timer_ptrs_.push_back(this->create_wall_timer(load_period, load_function));
+}
+
+/**
+ * @brief Function for check whether message sent at sent_ns belongs to measurement window
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param sent_ns int64_t
+ * @return bool
+*/
+bool ros_mqtt_load::LoadGenerator::is_in_window(int64_t sent_ns) const {
+    return sent_ns >= window_start_ns_.load(std::memory_order_relaxed) && sent_ns < window_end_ns_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for count message sent on path when it is inside of measurement window
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_name const std::string&
+ * @param sent_ns int64_t
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::count_sent(const std::string& path_name, int64_t sent_ns) {
+    std::map<std::string, LoadPath *>::iterator load_path = load_paths_.find(path_name);
+    if(load_path == load_paths_.end() || !this->is_in_window(sent_ns)) {
+        return;
+    }
+    load_path->second->sent.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Function for count message received on path & record its latency when it was sent inside of measurement window
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_name const std::string&
+ * @param sent_ns int64_t
+ * @param received_ns int64_t
+ * @return void
+ * @details called from the paho callback thread & the executor thread, counters & histogram are atomics
+*/
+void ros_mqtt_load::LoadGenerator::count_received(const std::string& path_name, int64_t sent_ns, int64_t received_ns) {
+    std::map<std::string, LoadPath *>::iterator load_path = load_paths_.find(path_name);
+    if(load_path == load_paths_.end() || !this->is_in_window(sent_ns)) {
+        return;
+    }
+    load_path->second->received.fetch_add(1, std::memory_order_relaxed);
+    if(received_ns >= sent_ns) {
+        load_path->second->latency.record(static_cast<uint64_t>(received_ns - sent_ns));
+    }
+}
+
+/**
+ * @brief Function for publish synthetic scan stamped with now
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::publish_scan() {
+    const int64_t sent_ns = wall_now_ns();
+    scan_message_.header.stamp.sec = static_cast<int32_t>(sent_ns / 1000000000LL);
+    scan_message_.header.stamp.nanosec = static_cast<uint32_t>(sent_ns % 1000000000LL);
+    this->count_sent("scan", sent_ns);
+    ros_scan_publisher_ptr_->publish(scan_message_);
+}
+
+/**
+ * @brief Function for publish synthetic tf with every transform stamped with now
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::publish_tf() {
+    const int64_t sent_ns = wall_now_ns();
+    for(geometry_msgs::msg::TransformStamped& transform_stamped : tf_message_.transforms) {
+        transform_stamped.header.stamp.sec = static_cast<int32_t>(sent_ns / 1000000000LL);
+        transform_stamped.header.stamp.nanosec = static_cast<uint32_t>(sent_ns % 1000000000LL);
+    }
+    this->count_sent("tf", sent_ns);
+    ros_tf_publisher_ptr_->publish(tf_message_);
+}
+
+/**
+ * @brief Function for publish synthetic odometry stamped with now
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::publish_odom() {
+    const int64_t sent_ns = wall_now_ns();
+    odom_message_.header.stamp.sec = static_cast<int32_t>(sent_ns / 1000000000LL);
+    odom_message_.header.stamp.nanosec = static_cast<uint32_t>(sent_ns % 1000000000LL);
+    this->count_sent("odom", sent_ns);
+    ros_odom_publisher_ptr_->publish(odom_message_);
+}
+
+/**
+ * @brief Function for publish echo request carrying its send time into mqtt
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::publish_echo_request() {
+    const int64_t sent_ns = wall_now_ns();
+    ros_message_encoder::JsonEncoder echo_encoder;
+    echo_encoder.begin_object(1);
+    echo_encoder.write_key("sent_ns");
+    echo_encoder.write_int(sent_ns);
+    echo_encoder.end_object();
+
+    this->count_sent("echo_ingress", sent_ns);
+    this->count_sent("echo_round_trip", sent_ns);
+    try {
+        mqtt::message_ptr mqtt_echo_message = mqtt::make_message(load_topics::broker::echo_request, echo_encoder.release());
+        mqtt_echo_message->set_qos(mqtt_qos_);
+        mqtt_async_client_.publish(mqtt_echo_message);
+    } catch(const mqtt::exception& mqtt_expn) {
+        std::cerr << LOG_ROS_MQTT_LOAD_GENERATOR << " echo request publish err : " << mqtt_expn.what() << '\n';
+    }
+}
+
+/**
+ * @brief Function for count decoded payload of path, send time is the header stamp or sent_ns of echo
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param path_name const std::string&
+ * @param payload_json const Json::Value&
+ * @param received_ns int64_t
+ * @return void
+*/
+void ros_mqtt_load::LoadGenerator::receive_payload(const std::string& path_name, const Json::Value& payload_json, int64_t received_ns) {
+    const int64_t sent_ns = path_name == "echo_round_trip"
+        ? payload_json.get("sent_ns", 0).asInt64()
+        : header_stamp_ns(payload_json["header"]);
+    this->count_received(path_name, sent_ns, received_ns);
+}
+
+/**
+ * @brief Overrided function for handle cause when mqtt connection lost
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_connection_lost_cause const std::string&
+ * @return void
+ * @see mqtt::callback
+*/
+void ros_mqtt_load::LoadGenerator::connection_lost(const std::string& mqtt_connection_lost_cause) {
+    std::cerr << LOG_ROS_MQTT_LOAD_GENERATOR << " connection lost : " << mqtt_connection_lost_cause << '\n';
+}
+
+/**
+ * @brief Overrided function for decompress, decode & count mqtt message arriving on destination of path or in batch envelope
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param mqtt_message mqtt::const_message_ptr
+ * @return void
+ * @see mqtt::callback
+*/
+void ros_mqtt_load::LoadGenerator::message_arrived(mqtt::const_message_ptr mqtt_message) {
+    const int64_t received_ns = wall_now_ns();
+    const std::string mqtt_topic = mqtt_message->get_topic();
+    std::string mqtt_payload = mqtt_message->to_string();
+
+    if(ros_mqtt_compression::is_compressed(mqtt_payload)) {
+        std::string decompressed_payload;
+        if(!ros_mqtt_compression::decompress(mqtt_payload, decompressed_payload)) {
+            undecodable_payloads_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        mqtt_payload.swap(decompressed_payload);
+    }
+
+    Json::Value payload_json;
+    ros_message_encoder::JsonDecoder json_decoder;
+    const bool is_json_topic = mqtt_topic == load_topics::broker::batch || mqtt_topic == load_topics::broker::echo_response;
+    const bool is_decoded = is_json_topic
+        ? json_decoder.decode(mqtt_payload, payload_json)
+        : mqtt_decoder_ptr_->decode(mqtt_payload, payload_json);
+    if(!is_decoded) {
+        undecodable_payloads_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if(mqtt_topic == load_topics::broker::batch) {
+        for(const Json::Value& batch_entry : payload_json["entries"]) {
+            std::map<std::string, std::string>::const_iterator entry_path = mqtt_topic_paths_.find(batch_entry["topic"].asString());
+            if(entry_path != mqtt_topic_paths_.end()) {
+                this->receive_payload(entry_path->second, batch_entry["payload"], received_ns);
+            }
+        }
+        return;
+    }
+
+    std::map<std::string, std::string>::const_iterator topic_path = mqtt_topic_paths_.find(mqtt_topic);
+    if(topic_path != mqtt_topic_paths_.end()) {
+        this->receive_payload(topic_path->second, payload_json, received_ns);
+    }
+}
+
+/**
+ * @brief Function for stop load, write report & shutdown rclcpp so the launch file ends
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @return void
+ * @details report is written into a temporary file & renamed, so a collector never reads a partial report
+*/
+void ros_mqtt_load::LoadGenerator::finish() {
+    if(is_finished_) {
+        return;
+    }
+    is_finished_ = true;
+    finish_timer_ptr_->cancel();
+    for(rclcpp::TimerBase::SharedPtr& load_timer_ptr : load_timer_ptrs_) {
+        load_timer_ptr->cancel();
+    }
+
+    const std::string load_report = this->build_report(window_end_ns_.load() - window_start_ns_.load());
+    const std::string temporary_report_file = report_file_ + ".tmp";
+    std::ofstream report_stream(temporary_report_file, std::ios::out | std::ios::trunc);
+    report_stream << load_report << '\n';
+    report_stream.close();
+    if(!report_stream || std::rename(temporary_report_file.c_str(), report_file_.c_str()) != 0) {
+        std::cerr << LOG_ROS_MQTT_LOAD_GENERATOR << " failed to write report into " << report_file_ << '\n';
+    }
+
+    std::cout << LOG_ROS_MQTT_LOAD_GENERATOR << " report : " << load_report << '\n';
+    rclcpp::shutdown();
+}
+
+/**
+ * @brief Function for build JSON report with throughput, drop rate & latency percentiles per path
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param window_ns int64_t
+ * @return std::string
+*/
+std::string ros_mqtt_load::LoadGenerator::build_report(int64_t window_ns) {
+    const double window_sec = window_ns / 1e9;
+    ros_message_encoder::JsonEncoder report_encoder;
+
+    report_encoder.begin_object(3);
+    report_encoder.write_key("window_sec");
+    report_encoder.write_double(window_sec);
+    report_encoder.write_key("undecodable_payloads");
+    report_encoder.write_uint(undecodable_payloads_.load());
+    report_encoder.write_key("paths");
+    report_encoder.begin_object(load_paths_.size());
+    for(const std::pair<const std::string, LoadPath *>& load_path : load_paths_) {
+        const LoadPath& path = *load_path.second;
+        const uint64_t sent = path.sent.load();
+        const uint64_t received = path.received.load();
+        const uint64_t latency_count = path.latency.count();
+
+        report_encoder.write_key(load_path.first.c_str());
+        report_encoder.begin_object(8);
+        report_encoder.write_key("origin");
+        report_encoder.write_string(path.origin);
+        report_encoder.write_key("destination");
+        report_encoder.write_string(path.destination);
+        report_encoder.write_key("rate_hz");
+        report_encoder.write_double(path.rate_hz);
+        report_encoder.write_key("sent");
+        report_encoder.write_uint(sent);
+        report_encoder.write_key("received");
+        report_encoder.write_uint(received);
+        report_encoder.write_key("throughput_msgs_per_sec");
+        report_encoder.write_double(window_sec > 0.0 ? received / window_sec : 0.0);
+        report_encoder.write_key("drop_rate");
+        report_encoder.write_double(sent > received ? static_cast<double>(sent - received) / sent : 0.0);
+        report_encoder.write_key("latency_ns");
+        report_encoder.begin_object(5);
+        report_encoder.write_key("mean");
+        report_encoder.write_uint(latency_count > 0 ? path.latency.sum() / latency_count : 0);
+        report_encoder.write_key("p50");
+        report_encoder.write_uint(path.latency.percentile(0.5));
+        report_encoder.write_key("p99");
+        report_encoder.write_uint(path.latency.percentile(0.99));
+        report_encoder.write_key("p999");
+        report_encoder.write_uint(path.latency.percentile(0.999));
+        report_encoder.write_key("max");
+        report_encoder.write_uint(path.latency.max());
+        report_encoder.end_object();
+        report_encoder.end_object();
+    }
+    report_encoder.end_object();
+    report_encoder.end_object();
+
+    return report_encoder.release();
+}
+
+/**
+ * @brief Function for initialize rclcpp & spin load generator until it finishes
+ * @author reidlo(naru5135@wavem.net)
+ * @date 26.10.19
+ * @param argc int
+ * @param argv char**
+ * @return int
+*/
+int main(int argc, char** argv) {
+    rclcpp::init(argc, argv);
+    std::shared_ptr<ros_mqtt_load::LoadGenerator> load_generator_ptr = std::make_shared<ros_mqtt_load::LoadGenerator>();
+    rclcpp::spin(load_generator_ptr);
+    rclcpp::shutdown();
+    return 0;
+}